@@ -0,0 +1,230 @@
+/*
+ * CALIB.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "CALIB.h"
+#include "driverlib/eeprom.h"
+#include "driverlib/sysctl.h"
+
+// EEPROM is usable
+static bool g_bEEPROM;
+
+/*
+ * Recompute the segment slopes after the points changed
+ */
+static void CALIB_Slopes(tCalibTable *psTable)
+{
+    uint32_t i;
+
+    for (i = 0; i + 1 < psTable->ui32Count; i++)
+    {
+        const tCalibPoint *psA = &psTable->psPoint[i];
+        const tCalibPoint *psB = &psTable->psPoint[i + 1];
+
+        psTable->pi32SlopeQ16[i] = (int32_t)((((int32_t)psB->ui16Us - psA->ui16Us) * 65536LL) /
+                                             (psB->i16Cdeg - psA->i16Cdeg));
+    }
+}
+
+static uint32_t CALIB_Pack(const tCalibPoint *psPoint)
+{
+    return (uint16_t)psPoint->i16Cdeg | ((uint32_t)psPoint->ui16Us << 16);
+}
+
+/*
+ * Power up the EEPROM
+ * @param none
+ * @return <bool> false if the EEPROM cannot be used, CALIB_Load()/CALIB_Save() fail then
+ */
+bool CALIB_Init(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0))
+    {
+    }
+
+    g_bEEPROM = EEPROMInit() == EEPROM_INIT_OK;
+    return g_bEEPROM;
+}
+
+/*
+ * Replace all points of a table
+ * @param <tCalibTable *> $psTable table
+ * @param <const tCalibPoint *> $psPoints points, ascending angle without duplicates
+ * @param <uint32_t> $ui32Count number of points, 2 to CALIB_MAX_POINTS
+ * @return <bool> false if the points are not usable, the table is unchanged then
+ */
+bool CALIB_Set(tCalibTable *psTable, const tCalibPoint *psPoints, uint32_t ui32Count)
+{
+    uint32_t i;
+
+    if (ui32Count < 2 || ui32Count > CALIB_MAX_POINTS)
+        return false;
+    for (i = 0; i + 1 < ui32Count; i++)
+        if (psPoints[i].i16Cdeg >= psPoints[i + 1].i16Cdeg)
+            return false;
+
+    for (i = 0; i < ui32Count; i++)
+        psTable->psPoint[i] = psPoints[i];
+    psTable->ui32Count = ui32Count;
+    CALIB_Slopes(psTable);
+    return true;
+}
+
+/*
+ * Add a breakpoint, or move the pulse of an existing one at the same angle
+ * @param <tCalibTable *> $psTable table
+ * @param <int32_t> $i32Cdeg angle (0.01 deg)
+ * @param <uint32_t> $ui32Us pulse width (us)
+ * @return <bool> false if the table is full or the values are out of range
+ */
+bool CALIB_PointSet(tCalibTable *psTable, int32_t i32Cdeg, uint32_t ui32Us)
+{
+    uint32_t i, j;
+
+    if (i32Cdeg < INT16_MIN || i32Cdeg > INT16_MAX || ui32Us > UINT16_MAX)
+        return false;
+
+    for (i = 0; i < psTable->ui32Count && psTable->psPoint[i].i16Cdeg < i32Cdeg; i++)
+    {
+    }
+    if (i == psTable->ui32Count || psTable->psPoint[i].i16Cdeg != i32Cdeg)
+    {
+        if (psTable->ui32Count == CALIB_MAX_POINTS)
+            return false;
+        for (j = psTable->ui32Count; j > i; j--)
+            psTable->psPoint[j] = psTable->psPoint[j - 1];
+        psTable->ui32Count++;
+    }
+
+    psTable->psPoint[i].i16Cdeg = (int16_t)i32Cdeg;
+    psTable->psPoint[i].ui16Us = (uint16_t)ui32Us;
+    CALIB_Slopes(psTable);
+    return true;
+}
+
+/*
+ * Drop the breakpoint at an angle, a table keeps at least 2
+ * @param <tCalibTable *> $psTable table
+ * @param <int32_t> $i32Cdeg angle of the point (0.01 deg)
+ * @return <bool> false if there is no such point or only 2 are left
+ */
+bool CALIB_PointRemove(tCalibTable *psTable, int32_t i32Cdeg)
+{
+    uint32_t i;
+
+    if (psTable->ui32Count <= 2)
+        return false;
+    for (i = 0; i < psTable->ui32Count && psTable->psPoint[i].i16Cdeg != i32Cdeg; i++)
+    {
+    }
+    if (i == psTable->ui32Count)
+        return false;
+
+    for (psTable->ui32Count--; i < psTable->ui32Count; i++)
+        psTable->psPoint[i] = psTable->psPoint[i + 1];
+    CALIB_Slopes(psTable);
+    return true;
+}
+
+/*
+ * Pulse for an angle, used in the PWM update path: no division
+ * @param <const tCalibTable *> $psTable table
+ * @param <int32_t> $i32Cdeg angle (0.01 deg), held at the first/last point outside the table
+ * @return <uint32_t> pulse width (us)
+ */
+uint32_t CALIB_PulseUs(const tCalibTable *psTable, int32_t i32Cdeg)
+{
+    const tCalibPoint *psPoint = psTable->psPoint;
+    uint32_t i;
+
+    if (i32Cdeg <= psPoint[0].i16Cdeg)
+        return psPoint[0].ui16Us;
+
+    for (i = 1; i < psTable->ui32Count - 1 && i32Cdeg > psPoint[i].i16Cdeg; i++)
+    {
+    }
+    i--;
+    if (i32Cdeg >= psPoint[i + 1].i16Cdeg)
+        return psPoint[i + 1].ui16Us;
+
+    return (uint32_t)((int32_t)psPoint[i].ui16Us +
+                      (int32_t)(((int64_t)(i32Cdeg - psPoint[i].i16Cdeg) * psTable->pi32SlopeQ16[i]) >> 16));
+}
+
+/*
+ * @return <int32_t> lower travel limit (0.01 deg)
+ */
+int32_t CALIB_MinCdeg(const tCalibTable *psTable)
+{
+    return psTable->psPoint[0].i16Cdeg;
+}
+
+/*
+ * @return <int32_t> upper travel limit (0.01 deg)
+ */
+int32_t CALIB_MaxCdeg(const tCalibTable *psTable)
+{
+    return psTable->psPoint[psTable->ui32Count - 1].i16Cdeg;
+}
+
+/*
+ * Read a table from the EEPROM
+ * @param <uint32_t> $ui32Channel servo channel
+ * @param <tCalibTable *> $psTable filled in, unchanged if nothing valid is stored
+ * @return <bool> true if a stored table was loaded
+ */
+bool CALIB_Load(uint32_t ui32Channel, tCalibTable *psTable)
+{
+    uint32_t pui32Block[CALIB_BLOCK_WORDS];
+    tCalibPoint psPoints[CALIB_MAX_POINTS];
+    uint32_t ui32Count, ui32Sum = 0;
+    uint32_t i;
+
+    if (!g_bEEPROM || ui32Channel >= CALIB_MAX_CHANNELS)
+        return false;
+
+    EEPROMRead(pui32Block, ui32Channel * CALIB_BLOCK_WORDS * 4, sizeof(pui32Block));
+    ui32Count = (pui32Block[0] >> 8) & 0xFF;
+    if ((pui32Block[0] & 0xFF) != CALIB_MAGIC || ui32Count > CALIB_MAX_POINTS)
+        return false;
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        ui32Sum += pui32Block[1 + i];
+        psPoints[i].i16Cdeg = (int16_t)(pui32Block[1 + i] & 0xFFFF);
+        psPoints[i].ui16Us = (uint16_t)(pui32Block[1 + i] >> 16);
+    }
+    if ((pui32Block[0] >> 16) != (ui32Sum & 0xFFFF))
+        return false;
+
+    return CALIB_Set(psTable, psPoints, ui32Count);
+}
+
+/*
+ * Store a table in the EEPROM
+ * @param <uint32_t> $ui32Channel servo channel
+ * @param <const tCalibTable *> $psTable table
+ * @return <bool> true if it was written
+ */
+bool CALIB_Save(uint32_t ui32Channel, const tCalibTable *psTable)
+{
+    uint32_t pui32Block[CALIB_BLOCK_WORDS];
+    uint32_t ui32Sum = 0;
+    uint32_t i;
+
+    if (!g_bEEPROM || ui32Channel >= CALIB_MAX_CHANNELS)
+        return false;
+
+    for (i = 0; i < CALIB_MAX_POINTS; i++)
+    {
+        pui32Block[1 + i] = i < psTable->ui32Count ? CALIB_Pack(&psTable->psPoint[i]) : 0xFFFFFFFF;
+        if (i < psTable->ui32Count)
+            ui32Sum += pui32Block[1 + i];
+    }
+    pui32Block[0] = CALIB_MAGIC | (psTable->ui32Count << 8) | ((ui32Sum & 0xFFFF) << 16);
+
+    return EEPROMProgram(pui32Block, ui32Channel * CALIB_BLOCK_WORDS * 4, sizeof(pui32Block)) == 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * CALIB.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Per servo calibration: a table of (angle, pulse) breakpoints, linear in
+ *  between. The slope of every segment is computed in Q16 whenever the
+ *  table changes, so looking up a pulse takes a compare per breakpoint, a
+ *  multiply and a shift. The first and last breakpoint are the travel limits.
+ *
+ *  Tables are kept in the on-chip EEPROM, one block of CALIB_BLOCK_WORDS
+ *  words per channel:
+ *      word 0          CALIB_MAGIC, point count, checksum (sum of the points)
+ *      word 1..8       angle (0.01 deg, int16) | pulse (us, uint16) << 16
+ */
+
+#ifndef CALIB_CALIB_H_
+#define CALIB_CALIB_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CALIB_MAX_POINTS    8
+#define CALIB_MAX_CHANNELS  16
+#define CALIB_BLOCK_WORDS   (1 + CALIB_MAX_POINTS)
+#define CALIB_MAGIC         0xCA
+
+typedef struct
+{
+    int16_t i16Cdeg;                // angle, 0.01 deg
+    uint16_t ui16Us;                // pulse width, us
+} tCalibPoint;
+
+typedef struct
+{
+    uint32_t ui32Count;             // breakpoints in use, at least 2
+    tCalibPoint psPoint[CALIB_MAX_POINTS];      // ascending angle
+    int32_t pi32SlopeQ16[CALIB_MAX_POINTS];     // us per 0.01 deg from point i to i + 1
+} tCalibTable;
+
+/*
+ * Function declaration(s)
+ */
+extern bool CALIB_Init(void);
+extern bool CALIB_Set(tCalibTable *psTable, const tCalibPoint *psPoints, uint32_t ui32Count);
+extern bool CALIB_PointSet(tCalibTable *psTable, int32_t i32Cdeg, uint32_t ui32Us);
+extern bool CALIB_PointRemove(tCalibTable *psTable, int32_t i32Cdeg);
+extern uint32_t CALIB_PulseUs(const tCalibTable *psTable, int32_t i32Cdeg);
+extern int32_t CALIB_MinCdeg(const tCalibTable *psTable);
+extern int32_t CALIB_MaxCdeg(const tCalibTable *psTable);
+extern bool CALIB_Load(uint32_t ui32Channel, tCalibTable *psTable);
+extern bool CALIB_Save(uint32_t ui32Channel, const tCalibTable *psTable);
+
+#endif /* CALIB_CALIB_H_ */
@@ -0,0 +1,30 @@
+/*
+ * FORMAT.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Divide-free integer to ASCII conversion shared by every UART producer.
+ *  All functions write into a caller supplied buffer, terminate it with '\0'
+ *  and return the number of characters written (without the terminator), so
+ *  the result can be pushed straight into a TX buffer.
+ */
+
+#ifndef FORMAT_FORMAT_H_
+#define FORMAT_FORMAT_H_
+
+#include <stdint.h>
+
+/*
+ * Size of a buffer that can hold any 32-bit value: "-2147483648" + '\0'
+ */
+#define FORMAT_INT_MAX_LEN 12
+
+/*
+ * Function declaration(s)
+ */
+extern uint32_t FORMAT_Uint(char *buf, uint32_t value);
+extern uint32_t FORMAT_Int(char *buf, int32_t value);
+extern uint32_t FORMAT_UintFixed(char *buf, uint32_t value, uint32_t width, char pad);
+extern uint32_t FORMAT_IntFixed(char *buf, int32_t value, uint32_t width, char pad);
+
+#endif /* FORMAT_FORMAT_H_ */
@@ -0,0 +1,182 @@
+/*
+ * SERVO.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "SERVO.h"
+
+typedef struct
+{
+    uint32_t ui32GPIOPeriph;
+    uint32_t ui32Port;
+    uint8_t ui8Pin;
+    uint32_t ui32PinConfig;
+} tServoPin;
+
+static const tServoPin g_psPins[SERVO_CHANNELS] =
+{
+    { SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_6, GPIO_PB6_M0PWM0 },
+    { SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_7, GPIO_PB7_M0PWM1 },
+    { SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_4, GPIO_PB4_M0PWM2 },
+    { SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_5, GPIO_PB5_M0PWM3 },
+    { SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_4, GPIO_PE4_M0PWM4 },
+    { SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_5, GPIO_PE5_M0PWM5 },
+    { SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE, GPIO_PIN_4, GPIO_PC4_M0PWM6 },
+    { SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE, GPIO_PIN_5, GPIO_PC5_M0PWM7 },
+    { SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_0, GPIO_PD0_M1PWM0 },
+    { SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_1, GPIO_PD1_M1PWM1 },
+    { SYSCTL_PERIPH_GPIOA, GPIO_PORTA_BASE, GPIO_PIN_6, GPIO_PA6_M1PWM2 },
+    { SYSCTL_PERIPH_GPIOA, GPIO_PORTA_BASE, GPIO_PIN_7, GPIO_PA7_M1PWM3 },
+    { SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_0, GPIO_PF0_M1PWM4 },
+    { SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_1, GPIO_PF1_M1PWM5 },
+    { SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PF2_M1PWM6 },
+    { SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_3, GPIO_PF3_M1PWM7 },
+};
+
+static const uint32_t g_pui32Base[2] = { PWM0_BASE, PWM1_BASE };
+static const uint32_t g_pui32Periph[2] = { SYSCTL_PERIPH_PWM0, SYSCTL_PERIPH_PWM1 };
+static const uint32_t g_pui32Gen[4] = { PWM_GEN_0, PWM_GEN_1, PWM_GEN_2, PWM_GEN_3 };
+static const uint32_t g_pui32GenBit[4] = { PWM_GEN_0_BIT, PWM_GEN_1_BIT, PWM_GEN_2_BIT, PWM_GEN_3_BIT };
+static const uint32_t g_pui32Out[8] = { PWM_OUT_0, PWM_OUT_1, PWM_OUT_2, PWM_OUT_3,
+                                        PWM_OUT_4, PWM_OUT_5, PWM_OUT_6, PWM_OUT_7 };
+
+// PWM clock dividers, smallest first
+static const uint32_t g_pui32Div[] = { 1, 2, 4, 8, 16, 32, 64 };
+static const uint32_t g_pui32DivConfig[] = { SYSCTL_PWMDIV_1, SYSCTL_PWMDIV_2, SYSCTL_PWMDIV_4, SYSCTL_PWMDIV_8,
+                                             SYSCTL_PWMDIV_16, SYSCTL_PWMDIV_32, SYSCTL_PWMDIV_64 };
+
+// PWM counts per frame and per us (Q16)
+static uint32_t g_ui32Load;
+static uint32_t g_ui32CountsPerUsQ16;
+
+// per module: generators running, generators with staged pulses
+static uint32_t g_pui32GenUsed[2];
+static uint32_t g_pui32GenDirty[2];
+
+/*
+ * Select the PWM clock for a frame rate, no channel is enabled yet
+ * @param <uint32_t> $ui32FrameHz frame rate, SERVO_MIN_FRAME_HZ to SERVO_MAX_FRAME_HZ
+ * @return <uint32_t> PWM counts per frame
+ */
+uint32_t SERVO_Init(uint32_t ui32FrameHz)
+{
+    uint32_t ui32Clock = SysCtlClockGet();
+    uint32_t ui32PWMClock;
+    uint32_t i;
+
+    if (ui32FrameHz < SERVO_MIN_FRAME_HZ)
+        ui32FrameHz = SERVO_MIN_FRAME_HZ;
+    if (ui32FrameHz > SERVO_MAX_FRAME_HZ)
+        ui32FrameHz = SERVO_MAX_FRAME_HZ;
+
+    // finest divider whose frame still fits the 16 bit counter
+    for (i = 0; i < sizeof(g_pui32Div) / sizeof(g_pui32Div[0]) - 1; i++)
+        if (ui32Clock / g_pui32Div[i] / ui32FrameHz <= 65536)
+            break;
+    SysCtlPWMClockSet(g_pui32DivConfig[i]);
+    ui32PWMClock = ui32Clock / g_pui32Div[i];
+    g_ui32Load = ui32PWMClock / ui32FrameHz - 1;
+    g_ui32CountsPerUsQ16 = (uint32_t)(((uint64_t)ui32PWMClock << 16) / 1000000);
+
+    g_pui32GenUsed[0] = g_pui32GenUsed[1] = 0;
+    g_pui32GenDirty[0] = g_pui32GenDirty[1] = 0;
+
+    return g_ui32Load + 1;
+}
+
+/*
+ * Enable a channel and describe the servo on it, the output stays low until
+ * the first SERVO_Commit()
+ * @param <tServo *> $psServo servo
+ * @param <uint32_t> $ui32Channel 0 - SERVO_CHANNELS - 1
+ * @param <const tCalibTable *> $psCalib calibration, may be changed later in place
+ * @return void
+ */
+void SERVO_Config(tServo *psServo, uint32_t ui32Channel, const tCalibTable *psCalib)
+{
+    const tServoPin *psPin = &g_psPins[ui32Channel];
+    uint32_t ui32Module = ui32Channel / 8;
+    uint32_t ui32Base = g_pui32Base[ui32Module];
+    uint32_t ui32Gen = (ui32Channel % 8) / 2;
+
+    psServo->ui32Channel = ui32Channel;
+    psServo->psCalib = psCalib;
+    psServo->ui32Pulse = 0xFFFFFFFF;   // nothing staged yet
+
+    SysCtlPeripheralEnable(psPin->ui32GPIOPeriph);
+    GPIOPinConfigure(psPin->ui32PinConfig);
+    GPIOPinTypePWM(psPin->ui32Port, psPin->ui8Pin);
+
+    if (!(g_pui32GenUsed[ui32Module] & g_pui32GenBit[ui32Gen]))
+    {
+        SysCtlPeripheralEnable(g_pui32Periph[ui32Module]);
+
+        // pulses are only loaded at the frame start after PWMSyncUpdate()
+        PWMGenConfigure(ui32Base, g_pui32Gen[ui32Gen],
+                        PWM_GEN_MODE_DOWN | PWM_GEN_MODE_SYNC | PWM_GEN_MODE_GEN_SYNC_GLOBAL);
+        PWMGenPeriodSet(ui32Base, g_pui32Gen[ui32Gen], g_ui32Load);
+        PWMGenEnable(ui32Base, g_pui32Gen[ui32Gen]);
+        g_pui32GenUsed[ui32Module] |= g_pui32GenBit[ui32Gen];
+
+        // restart all frames of the module together
+        PWMSyncTimeBase(ui32Base, g_pui32GenUsed[ui32Module]);
+    }
+
+    PWMOutputState(ui32Base, 1 << (ui32Channel % 8), true);
+}
+
+/*
+ * Stage a pulse width for the next SERVO_Commit()
+ * @param <tServo *> $psServo servo
+ * @param <uint32_t> $ui32Us pulse width (us), limited to the frame
+ * @return void
+ */
+void SERVO_SetUs(tServo *psServo, uint32_t ui32Us)
+{
+    uint32_t ui32Pulse = (uint32_t)(((uint64_t)ui32Us * g_ui32CountsPerUsQ16) >> 16);
+    uint32_t ui32Channel = psServo->ui32Channel;
+
+    if (ui32Pulse >= g_ui32Load)
+        ui32Pulse = g_ui32Load - 1;
+    if (ui32Pulse == psServo->ui32Pulse)
+        return;
+
+    psServo->ui32Pulse = ui32Pulse;
+    PWMPulseWidthSet(g_pui32Base[ui32Channel / 8], g_pui32Out[ui32Channel % 8], ui32Pulse);
+    g_pui32GenDirty[ui32Channel / 8] |= g_pui32GenBit[(ui32Channel % 8) / 2];
+}
+
+/*
+ * Stage an angle for the next SERVO_Commit()
+ * @param <tServo *> $psServo servo
+ * @param <int32_t> $i32Cdeg angle (0.01 deg)
+ * @return <bool> false if the angle is outside the travel limits, nothing is staged then
+ */
+bool SERVO_SetCdeg(tServo *psServo, int32_t i32Cdeg)
+{
+    if (i32Cdeg < CALIB_MinCdeg(psServo->psCalib) || i32Cdeg > CALIB_MaxCdeg(psServo->psCalib))
+        return false;
+
+    SERVO_SetUs(psServo, CALIB_PulseUs(psServo->psCalib, i32Cdeg));
+    return true;
+}
+
+/*
+ * Apply every staged pulse at the start of the next frame
+ * @param none
+ * @return void
+ */
+void SERVO_Commit(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        if (g_pui32GenDirty[i])
+        {
+            PWMSyncUpdate(g_pui32Base[i], g_pui32GenDirty[i]);
+            g_pui32GenDirty[i] = 0;
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
 #include "inc/hw_gpio.h"
@@ -13,71 +14,222 @@
 #include "driverlib/rom.h"
 #include "driverlib/interrupt.h"
 #include "driverlib/uart.h"
+#include "TIME/TIME.h"
+#include "FORMAT/FORMAT.h"
+#include "CALIB/CALIB.h"
+#include "SERVO/SERVO.h"
 
-#define PWM_FREQUENCY 55
-
-#define SERVO_MIN_YAW 20
-#define SERVO_MAX_YAW 140
+// Frame rate of the servo PWM, digital servos take up to 333 Hz (use 50 for analog ones)
+#define SERVO_FRAME_HZ 333
 #define SERVO_CENTER_YAW 90
-#define SERVO_MIN_PITCH 50
-#define SERVO_MAX_PITCH 120
 #define SERVO_CENTER_PITCH 60
 
-// Store the pwm clock
-volatile uint32_t ui32Load;
-volatile uint32_t ui32PWMClock;
+// Bank channels of the servos, M1PWM0 on PD0 and M1PWM1 on PD1
+#define SERVO_CHANNEL_YAW SERVO_CHANNEL(1, 0)
+#define SERVO_CHANNEL_PITCH SERVO_CHANNEL(1, 1)
+
+// EEPROM slots of the calibration tables, one per bank channel
+#define CALIB_CHANNEL_YAW SERVO_CHANNEL_YAW
+#define CALIB_CHANNEL_PITCH SERVO_CHANNEL_PITCH
+
+// Calibration used until one is stored: the travel limits (0.01 deg) with the
+// pulse (us) of the old 55 Hz mapping, where a degree was 0.1% of the period
+static const tCalibPoint CALIB_DEFAULT_YAW[] = { { 2000, 364 }, { 14000, 2545 } };
+static const tCalibPoint CALIB_DEFAULT_PITCH[] = { { 4500, 818 }, { 11000, 2000 } };
+
+// The two servos on PWM1 and their calibration
+tServo servoYaw;
+tServo servoPitch;
+tCalibTable calibYaw;
+tCalibTable calibPitch;
 
 // Store the value of the servo
-volatile uint32_t ui32ServoYawValue;
-volatile uint32_t ui32ServoPitchValue;
+volatile int32_t i32ServoYawValue;
+volatile int32_t i32ServoPitchValue;
 
 // Store the UART input
 char uartReceive[100];
 int uartReceiveCount = 0;
 
+// Machine mode, for a program on the PC: no echo and no activity LED,
+// every line is answered with "k\n" or "e\n" once it has been applied
+volatile bool machineMode = false;
+
+// Turns the activity LED off again
+tTimeTimer ledTimer;
+
 // Set the left/right rotation of the servo
 void SetServoYaw(int value)
 {
-    if(value > SERVO_MAX_YAW || value < SERVO_MIN_YAW)
-    {
-        return;
-    }
-    PWMPulseWidthSet(PWM1_BASE, PWM_OUT_0, value * ui32Load/1000);
+    SERVO_SetCdeg(&servoYaw, value * 100);
+    SERVO_Commit();
 }
 
 // Set the up/down rotation of the servo
 void SetServoPitch(int value)
 {
-    if(value > SERVO_MAX_PITCH || value < SERVO_MIN_PITCH)
+    SERVO_SetCdeg(&servoPitch, value * 100);
+    SERVO_Commit();
+}
+
+void InitializePWM()
+{
+    // Stored calibration, or the defaults
+    CALIB_Init();
+    if (!CALIB_Load(CALIB_CHANNEL_YAW, &calibYaw))
+        CALIB_Set(&calibYaw, CALIB_DEFAULT_YAW, sizeof(CALIB_DEFAULT_YAW) / sizeof(CALIB_DEFAULT_YAW[0]));
+    if (!CALIB_Load(CALIB_CHANNEL_PITCH, &calibPitch))
+        CALIB_Set(&calibPitch, CALIB_DEFAULT_PITCH, sizeof(CALIB_DEFAULT_PITCH) / sizeof(CALIB_DEFAULT_PITCH[0]));
+
+    SERVO_Init(SERVO_FRAME_HZ);
+    SERVO_Config(&servoYaw, SERVO_CHANNEL_YAW, &calibYaw);
+    SERVO_Config(&servoPitch, SERVO_CHANNEL_PITCH, &calibPitch);
+}
+
+void UARTStringPut(uint32_t ui32Base, char *str)
+{
+    int i;
+    for (i = 0; str[i] != '\0'; i++)
+    {
+        UARTCharPut(ui32Base, str[i]);
+    }
+}
+
+void UARTIntPut(uint32_t ui32Base, int value)
+{
+    char result[FORMAT_INT_MAX_LEN];
+
+    FORMAT_Int(result, value);
+    UARTStringPut(ui32Base, result);
+}
+
+void ShowCalib(char *name, tCalibTable *psTable)
+{
+    uint32_t i;
+
+    UARTStringPut(UART0_BASE, name);
+    UARTStringPut(UART0_BASE, " (0.01 deg:us):");
+    for (i = 0; i < psTable->ui32Count; i++)
+    {
+        UARTStringPut(UART0_BASE, " ");
+        UARTIntPut(UART0_BASE, psTable->psPoint[i].i16Cdeg);
+        UARTStringPut(UART0_BASE, ":");
+        UARTIntPut(UART0_BASE, psTable->psPoint[i].ui16Us);
+    }
+    UARTStringPut(UART0_BASE, "\n\r");
+}
+
+/*
+ * Calibration commands, after the leading 'c':
+ *      y / p                   show the yaw / pitch table
+ *      y<0.01 deg> <us>        add a breakpoint, or move the one at that angle
+ *      yd<0.01 deg>            remove a breakpoint
+ *      yr                      back to the defaults
+ *      w                       store both tables in the EEPROM
+ */
+void ProcessCalibCommand(char *args)
+{
+    tCalibTable *psTable;
+    const tCalibPoint *psDefault;
+    uint32_t ui32DefaultCount;
+    char *end;
+    long cdeg, us;
+    bool ok = true;
+
+    if (args[0] == 'w' || args[0] == 'W')
+    {
+        ok = CALIB_Save(CALIB_CHANNEL_YAW, &calibYaw) && CALIB_Save(CALIB_CHANNEL_PITCH, &calibPitch);
+        UARTStringPut(UART0_BASE, ok ? "saved\n\r" : "EEPROM error\n\r");
+        return;
+    }
+    if (args[0] == 'y' || args[0] == 'Y')
+    {
+        psTable = &calibYaw;
+        psDefault = CALIB_DEFAULT_YAW;
+        ui32DefaultCount = sizeof(CALIB_DEFAULT_YAW) / sizeof(CALIB_DEFAULT_YAW[0]);
+    }
+    else if (args[0] == 'p' || args[0] == 'P')
     {
+        psTable = &calibPitch;
+        psDefault = CALIB_DEFAULT_PITCH;
+        ui32DefaultCount = sizeof(CALIB_DEFAULT_PITCH) / sizeof(CALIB_DEFAULT_PITCH[0]);
+    }
+    else
         return;
+
+    if (args[1] == 'r' || args[1] == 'R')
+        CALIB_Set(psTable, psDefault, ui32DefaultCount);
+    else if (args[1] == 'd' || args[1] == 'D')
+        ok = CALIB_PointRemove(psTable, strtol(args + 2, 0, 10));
+    else if (args[1] != '\0')
+    {
+        cdeg = strtol(args + 1, &end, 10);
+        us = strtol(end, 0, 10);
+        ok = CALIB_PointSet(psTable, cdeg, us);
     }
-    PWMPulseWidthSet(PWM1_BASE, PWM_OUT_1, value * ui32Load/1000);
+
+    if (!ok)
+        UARTStringPut(UART0_BASE, "rejected\n\r");
+    ShowCalib(psTable == &calibYaw ? "yaw" : "pitch", psTable);
 }
 
-void InitializePWM()
+// Handle one command, servo targets are staged until the next SERVO_Commit(), false if it was rejected
+bool ProcessCommand(char *cmd)
 {
-    SysCtlPWMClockSet(SYSCTL_PWMDIV_64);
-
-    // Enable GPIOD to output signals to servo
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD);
-    // Enable PWM0 and PWM1 to generate PWM signals
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0 | SYSCTL_PERIPH_PWM1);
-
-    // Set PD0 and PD1 as PWM pin
-    GPIOPinTypePWM(GPIO_PORTD_BASE, GPIO_PIN_0 | GPIO_PIN_1);
-    GPIOPinConfigure(GPIO_PD0_M1PWM0);
-    GPIOPinConfigure(GPIO_PD1_M1PWM1);
-
-    // Get the frequency of the pwm control clock
-    ui32PWMClock = SysCtlClockGet()/64;
-    ui32Load = (ui32PWMClock / PWM_FREQUENCY) - 1;
-    PWMGenConfigure(PWM1_BASE, PWM_GEN_0, PWM_GEN_MODE_DOWN);
-    PWMGenPeriodSet(PWM1_BASE, PWM_GEN_0, ui32Load);
-
-    // Enable PWM
-    PWMOutputState(PWM1_BASE, PWM_OUT_0_BIT | PWM_OUT_1_BIT, true);
-    PWMGenEnable(PWM1_BASE, PWM_GEN_0);
+    // whole degrees, checked against the travel limits before scaling so a long number cannot overflow
+    int32_t value = atoi(cmd + 1);
+
+    if (cmd[0] == 'p' || cmd[0] == 'P')
+    {
+        // Set pitch value
+        if (value < CALIB_MinCdeg(&calibPitch) / 100 || value > CALIB_MaxCdeg(&calibPitch) / 100 ||
+            !SERVO_SetCdeg(&servoPitch, value * 100))
+            return false;
+        i32ServoPitchValue = value;
+    }
+    else if (cmd[0] == 'y' || cmd[0] == 'Y')
+    {
+        // Set yaw value
+        if (value < CALIB_MinCdeg(&calibYaw) / 100 || value > CALIB_MaxCdeg(&calibYaw) / 100 ||
+            !SERVO_SetCdeg(&servoYaw, value * 100))
+            return false;
+        i32ServoYawValue = value;
+    }
+    else if (cmd[0] == 'c' || cmd[0] == 'C')
+    {
+        // Calibration
+        ProcessCalibCommand(cmd + 1);
+    }
+    else if (cmd[0] == 'm' || cmd[0] == 'M')
+    {
+        // m1 enters machine mode, m0 goes back to the terminal
+        machineMode = cmd[1] == '1';
+    }
+    else
+        return false;
+    return true;
+}
+
+/*
+ * Handle a line, several commands can be batched with ';' (e.g. "y90;p45"),
+ * their servo targets take effect in the same PWM frame
+ */
+bool ProcessLine(char *line)
+{
+    char *cmd = line;
+    char *next;
+    bool ok = true;
+
+    while (cmd)
+    {
+        next = strchr(cmd, ';');
+        if (next)
+            *next++ = '\0';
+        ok &= ProcessCommand(cmd);
+        cmd = next;
+    }
+    SERVO_Commit();
+    return ok;
 }
 
 void InitializeUART()
@@ -98,23 +250,30 @@ void InitializeUART()
     UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
 }
 
+void LEDOff(void *pvData)
+{
+    GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, 0);
+}
+
 void InitializeLED()
 {
     // Enable PF2 for led response
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
     GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
+    TIME_TimerInit(&ledTimer, LEDOff, 0);
 }
 
 void Initialize()
 {
     SysCtlClockSet(SYSCTL_SYSDIV_5|SYSCTL_USE_PLL|SYSCTL_OSC_MAIN|SYSCTL_XTAL_16MHZ);
+    TIME_Init();
     InitializePWM();
     InitializeUART();
     InitializeLED();
 
     // set the servo's initial position
-    SetServoPitch(SERVO_CENTER_YAW);
-    SetServoYaw(SERVO_CENTER_PITCH);
+    SetServoPitch(SERVO_CENTER_PITCH);
+    SetServoYaw(SERVO_CENTER_YAW);
 }
 
 int main()
@@ -129,6 +288,7 @@ int main()
 void UARTInt0Handler(void)
 {
     uint32_t ui32Status;
+    bool wasMachine, ok;
 
     ui32Status = UARTIntStatus(UART0_BASE, true); // get interrupt status
 
@@ -141,32 +301,33 @@ void UARTInt0Handler(void)
         // If it is an enter key, process the data entered
         if (c == 10 || c == 13)
         {
-            UARTCharPut(UART0_BASE, '\n');
-            UARTCharPut(UART0_BASE, '\r');
+            wasMachine = machineMode;
+            if (!wasMachine)
+            {
+                UARTCharPut(UART0_BASE, '\n');
+                UARTCharPut(UART0_BASE, '\r');
+            }
+            else if (uartReceiveCount == 0)
+                continue; // second half of a CR LF, nothing to answer
+
             uartReceive[uartReceiveCount] = '\0';
             uartReceiveCount = 0;
 
-            // Process the received value and send it to the servo
-            if(uartReceive[0] == 'p' || uartReceive[0] == 'P')
-            {
-                ui32ServoPitchValue = atoi(uartReceive + 1);
-                // Set pitch value
-                SetServoPitch(ui32ServoPitchValue);
-            }
-            else if(uartReceive[0] == 'y' || uartReceive[0] == 'Y')
-            {
-                ui32ServoYawValue = atoi(uartReceive + 1);
-                // Set yaw value
-                SetServoYaw(ui32ServoYawValue);
-            }
+            // Process the received values and send them to the servos
+            ok = ProcessLine(uartReceive);
+            if (wasMachine || machineMode)
+                UARTStringPut(UART0_BASE, ok ? "k\n" : "e\n");
         }
         else
         {
-            UARTCharPut(UART0_BASE, c);                            // echo character
-            GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PIN_2); // blink LED
-            SysCtlDelay(SysCtlClockGet() / (1000 * 3));            // delay ~1 msec
-            GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, 0);          // turn off LED
-            uartReceive[uartReceiveCount++] = c;
+            if (!machineMode)
+            {
+                UARTCharPut(UART0_BASE, c);                            // echo character
+                GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PIN_2); // blink LED
+                TIME_TimerStart(&ledTimer, 1, 0);                      // turn off LED ~1 msec later
+            }
+            if (uartReceiveCount < sizeof(uartReceive) - 1)
+                uartReceive[uartReceiveCount++] = c;
         }
     }
 }
@@ -0,0 +1,415 @@
+/*
+ * bridge_sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host simulation of the ReceiveFromHost-BT bridge, built from the
+ *  firmware's BRIDGE module. UART0 and UART5 are modelled byte by byte in
+ *  simulated time, the way BRIDGE uses them: 16 byte FIFOs, the RX interrupt
+ *  when a byte brings the FIFO to its level, the receive timeout after 32
+ *  idle bit times, the TX interrupt when the FIFO drains through its level,
+ *  and a byte arriving at a full RX FIFO is lost and flags the next one read
+ *  with UART_DR_OE. The two handlers have the same priority, so one runs at
+ *  a time; each costs SIM_ISR_ENTRY_NS plus SIM_ISR_BYTE_NS per byte moved,
+ *  during which the lines keep running.
+ *
+ *  The PC and the HC-05 stream numbered bytes at their line rate for
+ *  SIM_SECONDS, then the bridge drains. The far ends check every byte that
+ *  comes out against the stream, and a source stops on XOFF and goes on on
+ *  XON after its reaction time. A UART5 slower than UART0 stands in for a
+ *  sink that cannot keep up with its source.
+ *
+ *  Each scenario states whether it must be lossless: then every byte has to
+ *  arrive in order, with no overrun. Otherwise the loss has to show up in
+ *  the overrun counter. Exits with 1 on the first failed scenario.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -Wall -I. -I../../ReceiveFromHost-BT -o bridge_sim bridge_sim.c ../../ReceiveFromHost-BT/BRIDGE/BRIDGE.c
+ *      ./bridge_sim
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../ReceiveFromHost-BT/BRIDGE/BRIDGE.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/uart.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_uart.h"
+
+#define SIM_SECONDS         2
+#define SIM_DRAIN_SECONDS   1
+#define SIM_STEP_NS         100
+#define SIM_FIFO            16
+#define SIM_ISR_ENTRY_NS    1000        // entry, status, exit at 50 MHz
+#define SIM_ISR_BYTE_NS     150         // one byte through the FIFO and the ring
+
+typedef struct
+{
+    const char *pcName;
+    uint32_t ui32PcBaud;                // UART0 and the PC
+    uint32_t ui32BtBaud;                // UART5 and the HC-05
+    bool bPcSends, bBtSends;
+    bool bXonXoff;
+    uint32_t ui32ReactBytes;            // bytes a source still sends after XOFF
+    bool bLossless;
+} tScenario;
+
+static const tScenario SCENARIOS[] = {
+    { "both ways at 460800", 460800, 460800, true, true, false, 0, true },
+    { "both ways at 115200", 115200, 115200, true, true, false, 0, true },
+    { "pc to slow bt, xon/xoff, react 64", 460800, 115200, true, false, true, 64, true },
+    { "pc to slow bt, xon/xoff, react 900", 460800, 115200, true, true, true, 900, true },
+    { "pc to slow bt, xon/xoff, react 1500", 460800, 115200, true, false, true, 1500, false },
+    { "pc to slow bt, no flow control", 460800, 115200, true, false, false, 0, false },
+};
+
+/*
+ * One TM4C UART with the device on its far side
+ */
+typedef struct
+{
+    uint32_t ui32Base;
+    uint32_t ui32Int;
+    uint64_t ui64ByteNs;                // 10 bit times
+    void (*pfnHandler)(void);
+
+    // receive side
+    int32_t pi32Rx[SIM_FIFO];
+    uint32_t ui32RxHead, ui32RxCount;
+    uint32_t ui32RxLevel;
+    bool bOverrun;                      // a byte was lost, flag the next one
+    bool bTimeoutArmed;
+    uint64_t ui64LastRx;
+
+    // transmit side, the byte in the shift register is done at ui64TxDone
+    uint8_t pui8Tx[SIM_FIFO];
+    uint32_t ui32TxHead, ui32TxCount;
+    uint32_t ui32TxLevel;
+    bool bShifting;
+    uint8_t ui8Shift;
+    uint64_t ui64TxDone;
+
+    uint32_t ui32Mask, ui32Raw;
+    bool bEnabled, bPending;
+
+    // the far end: sends numbered bytes, checks what it gets against the other far end
+    bool bSends, bStopped;
+    uint32_t ui32Sent, ui32Received;
+    uint32_t ui32Next;                  // number of the byte expected next from the other far end
+    uint32_t ui32Corrupt;               // bytes that are not in the stream at or after ui32Next
+    uint64_t ui64NextSend;
+    int64_t i64ReactUntil;              // an XOFF / XON takes effect after this, -1 none pending
+    bool bReactStop;
+} tSimUart;
+
+static tSimUart g_psUarts[2];
+static const tScenario *g_psScript;
+static uint64_t g_ui64Ns;
+static uint64_t g_ui64CpuFree;          // a handler runs until then
+static uint32_t g_ui32BytesMoved;
+static bool g_bMaster = true;
+
+static tSimUart *Uart(uint32_t ui32Base)
+{
+    return ui32Base == UART0_BASE ? &g_psUarts[0] : &g_psUarts[1];
+}
+
+static tSimUart *UartInt(uint32_t ui32Interrupt)
+{
+    return ui32Interrupt == INT_UART0 ? &g_psUarts[0] : &g_psUarts[1];
+}
+
+// The n-th byte of a stream, printable so it never looks like XON / XOFF
+static uint8_t StreamByte(uint32_t ui32Index, uint32_t ui32Stream)
+{
+    return (uint8_t)(0x20 + (ui32Index * 7 + ui32Index / 95 + ui32Stream * 31) % 95);
+}
+
+/*
+ * Driver stand-ins
+ */
+bool IntMasterEnable(void)
+{
+    bool bWas = !g_bMaster;
+
+    g_bMaster = true;
+    return bWas;
+}
+
+bool IntMasterDisable(void)
+{
+    bool bWas = !g_bMaster;
+
+    g_bMaster = false;
+    return bWas;
+}
+
+void IntEnable(uint32_t ui32Interrupt)
+{
+    UartInt(ui32Interrupt)->bEnabled = true;
+}
+
+void IntDisable(uint32_t ui32Interrupt)
+{
+    UartInt(ui32Interrupt)->bEnabled = false;
+}
+
+void IntPendSet(uint32_t ui32Interrupt)
+{
+    UartInt(ui32Interrupt)->bPending = true;
+}
+
+void UARTFIFOEnable(uint32_t ui32Base)
+{
+    (void)ui32Base;
+}
+
+void UARTFIFOLevelSet(uint32_t ui32Base, uint32_t ui32TxLevel, uint32_t ui32RxLevel)
+{
+    static const uint8_t pui8Levels[] = { 2, 4, 8, 12, 14 };
+
+    Uart(ui32Base)->ui32TxLevel = pui8Levels[ui32TxLevel];
+    Uart(ui32Base)->ui32RxLevel = pui8Levels[ui32RxLevel >> 3];
+}
+
+void UARTTxIntModeSet(uint32_t ui32Base, uint32_t ui32Mode)
+{
+    (void)ui32Base;
+    (void)ui32Mode;
+}
+
+void UARTIntRegister(uint32_t ui32Base, void (*pfnHandler)(void))
+{
+    Uart(ui32Base)->pfnHandler = pfnHandler;
+    Uart(ui32Base)->bEnabled = true;
+}
+
+void UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    Uart(ui32Base)->ui32Mask |= ui32IntFlags;
+}
+
+void UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    Uart(ui32Base)->ui32Mask &= ~ui32IntFlags;
+}
+
+uint32_t UARTIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    tSimUart *psUart = Uart(ui32Base);
+
+    return bMasked ? psUart->ui32Raw & psUart->ui32Mask : psUart->ui32Raw;
+}
+
+void UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    Uart(ui32Base)->ui32Raw &= ~ui32IntFlags;
+}
+
+bool UARTCharsAvail(uint32_t ui32Base)
+{
+    return Uart(ui32Base)->ui32RxCount != 0;
+}
+
+int32_t UARTCharGetNonBlocking(uint32_t ui32Base)
+{
+    tSimUart *psUart = Uart(ui32Base);
+    int32_t i32Data;
+
+    if (!psUart->ui32RxCount)
+        return -1;
+    i32Data = psUart->pi32Rx[psUart->ui32RxHead];
+    psUart->ui32RxHead = (psUart->ui32RxHead + 1) % SIM_FIFO;
+    psUart->ui32RxCount--;
+    g_ui32BytesMoved++;
+    return i32Data;
+}
+
+bool UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData)
+{
+    tSimUart *psUart = Uart(ui32Base);
+
+    if (psUart->ui32TxCount == SIM_FIFO)
+        return false;
+    psUart->pui8Tx[(psUart->ui32TxHead + psUart->ui32TxCount++) % SIM_FIFO] = ucData;
+    g_ui32BytesMoved++;
+    return true;
+}
+
+/*
+ * The lines
+ */
+static void RxArrive(tSimUart *psUart, uint8_t ui8Data)
+{
+    psUart->ui64LastRx = g_ui64Ns;
+    psUart->bTimeoutArmed = true;
+    if (psUart->ui32RxCount == SIM_FIFO)
+    {
+        psUart->bOverrun = true;
+        return;
+    }
+    psUart->pi32Rx[(psUart->ui32RxHead + psUart->ui32RxCount++) % SIM_FIFO] =
+        ui8Data | (psUart->bOverrun ? UART_DR_OE : 0);
+    psUart->bOverrun = false;
+    if (psUart->ui32RxCount >= psUart->ui32RxLevel)
+        psUart->ui32Raw |= UART_INT_RX;
+}
+
+// A byte the far end of psUart got from the bridge, sent by the far end of psFrom
+static void FarEndReceive(tSimUart *psUart, const tSimUart *psFrom, uint8_t ui8Data)
+{
+    if (g_psScript->bXonXoff && (ui8Data == BRIDGE_XON || ui8Data == BRIDGE_XOFF))
+    {
+        // the source finishes what it is sending for a while before it reacts
+        psUart->bReactStop = ui8Data == BRIDGE_XOFF;
+        psUart->i64ReactUntil = (int64_t)(g_ui64Ns + g_psScript->ui32ReactBytes * psUart->ui64ByteNs);
+        return;
+    }
+    // bytes lost on the way show up as a skip in the numbering, never as a step back
+    uint32_t ui32Next = psUart->ui32Next;
+
+    while (ui32Next < psFrom->ui32Sent && StreamByte(ui32Next, psFrom->ui32Base) != ui8Data)
+        ui32Next++;
+    if (ui32Next == psFrom->ui32Sent)
+    {
+        psUart->ui32Corrupt++;
+        return;
+    }
+    psUart->ui32Next = ui32Next + 1;
+    psUart->ui32Received++;
+}
+
+static void Step(uint64_t ui64SendUntil)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        tSimUart *psUart = &g_psUarts[i];
+
+        // the far end flow control
+        if (psUart->i64ReactUntil >= 0 && (int64_t)g_ui64Ns >= psUart->i64ReactUntil)
+        {
+            psUart->bStopped = psUart->bReactStop;
+            psUart->i64ReactUntil = -1;
+        }
+
+        // far end -> RX FIFO
+        if (psUart->bSends && !psUart->bStopped && g_ui64Ns < ui64SendUntil && g_ui64Ns >= psUart->ui64NextSend)
+        {
+            RxArrive(psUart, StreamByte(psUart->ui32Sent++, psUart->ui32Base));
+            psUart->ui64NextSend = g_ui64Ns + psUart->ui64ByteNs;
+        }
+        if (psUart->bTimeoutArmed && psUart->ui32RxCount && g_ui64Ns - psUart->ui64LastRx >= psUart->ui64ByteNs * 32 / 10)
+        {
+            psUart->bTimeoutArmed = false;
+            psUart->ui32Raw |= UART_INT_RT;
+        }
+
+        // TX FIFO -> far end
+        if (psUart->bShifting && g_ui64Ns >= psUart->ui64TxDone)
+        {
+            psUart->bShifting = false;
+            FarEndReceive(psUart, &g_psUarts[i ^ 1], psUart->ui8Shift);
+        }
+        if (!psUart->bShifting && psUart->ui32TxCount)
+        {
+            psUart->ui8Shift = psUart->pui8Tx[psUart->ui32TxHead];
+            psUart->ui32TxHead = (psUart->ui32TxHead + 1) % SIM_FIFO;
+            if (psUart->ui32TxCount-- == psUart->ui32TxLevel + 1)
+                psUart->ui32Raw |= UART_INT_TX;
+            psUart->bShifting = true;
+            psUart->ui64TxDone = g_ui64Ns + psUart->ui64ByteNs;
+        }
+
+        if (psUart->ui32Raw & psUart->ui32Mask)
+            psUart->bPending = true;
+    }
+
+    // one handler at a time, UART0 first on a tie as its vector is lower
+    if (g_ui64Ns < g_ui64CpuFree || !g_bMaster)
+        return;
+    for (i = 0; i < 2; i++)
+    {
+        tSimUart *psUart = &g_psUarts[i];
+
+        if (!psUart->bPending || !psUart->bEnabled)
+            continue;
+        psUart->bPending = false;
+        g_ui32BytesMoved = 0;
+        psUart->pfnHandler();
+        g_ui64CpuFree = g_ui64Ns + SIM_ISR_ENTRY_NS + g_ui32BytesMoved * SIM_ISR_BYTE_NS;
+        break;
+    }
+}
+
+static bool RunScenario(const tScenario *psScenario)
+{
+    uint64_t ui64SendUntil = (uint64_t)SIM_SECONDS * 1000000000;
+    uint64_t ui64End = ui64SendUntil + (uint64_t)SIM_DRAIN_SECONDS * 1000000000;
+    tBridgeStats psStats[BRIDGE_PORTS];
+    uint32_t ui32Lost, ui32Overruns, ui32Busy = 0, i;
+    bool bOk;
+
+    g_psScript = psScenario;
+    g_ui64Ns = g_ui64CpuFree = 0;
+    for (i = 0; i < 2; i++)
+    {
+        tSimUart *psUart = &g_psUarts[i];
+        uint32_t ui32Baud = i ? psScenario->ui32BtBaud : psScenario->ui32PcBaud;
+
+        *psUart = (tSimUart){ 0 };
+        psUart->ui32Base = i ? UART5_BASE : UART0_BASE;
+        psUart->ui32Int = i ? INT_UART5 : INT_UART0;
+        psUart->ui64ByteNs = 10000000000ull / ui32Baud;
+        psUart->bSends = i ? psScenario->bBtSends : psScenario->bPcSends;
+        psUart->i64ReactUntil = -1;
+    }
+
+    BRIDGE_Init(psScenario->bXonXoff);
+    for (; g_ui64Ns < ui64End; g_ui64Ns += SIM_STEP_NS)
+    {
+        Step(ui64SendUntil);
+        if (g_ui64Ns < g_ui64CpuFree)
+            ui32Busy++;
+    }
+
+    BRIDGE_StatsGet(BRIDGE_PC, &psStats[BRIDGE_PC]);
+    BRIDGE_StatsGet(BRIDGE_BT, &psStats[BRIDGE_BT]);
+    ui32Lost = g_psUarts[0].ui32Sent - g_psUarts[1].ui32Received + g_psUarts[1].ui32Sent - g_psUarts[0].ui32Received;
+    ui32Overruns = psStats[BRIDGE_PC].ui32Overruns + psStats[BRIDGE_BT].ui32Overruns;
+
+    // drained, in order, and whatever is missing was lost at a FIFO that counted it
+    bOk = !g_psUarts[0].ui32Corrupt && !g_psUarts[1].ui32Corrupt;
+    for (i = 0; i < BRIDGE_PORTS; i++)
+        bOk = bOk && psStats[i].ui32RxBytes == psStats[i ^ 1].ui32TxBytes && !g_psUarts[i].ui32RxCount &&
+              !g_psUarts[i].ui32TxCount && !g_psUarts[i].bShifting;
+    if (psScenario->bLossless)
+        bOk = bOk && !ui32Lost && !ui32Overruns;
+    else
+        bOk = bOk && ui32Lost && ui32Overruns;
+
+    printf("%-38s %6u %6u  %6u %6u  %5u %5u  %4u %4u  %5.1f  %s\n", psScenario->pcName,
+           g_psUarts[0].ui32Sent / SIM_SECONDS, g_psUarts[1].ui32Received / SIM_SECONDS,
+           g_psUarts[1].ui32Sent / SIM_SECONDS, g_psUarts[0].ui32Received / SIM_SECONDS, ui32Lost, ui32Overruns,
+           psStats[BRIDGE_PC].ui32Xoffs, psStats[BRIDGE_PC].ui32Holds,
+           100.0 * ui32Busy * SIM_STEP_NS / ui64End, bOk ? "ok" : "FAILED");
+    return bOk;
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    printf("%-38s %13s  %13s  %11s  %9s  %5s\n", "", "pc->bt (B/s)", "bt->pc (B/s)", "lost", "pc port", "cpu");
+    printf("%-38s %6s %6s  %6s %6s  %5s %5s  %4s %4s  %5s\n", "scenario", "sent", "out", "sent", "out", "bytes",
+           "ovr", "xoff", "hold", "(%)");
+    for (i = 0; i < sizeof(SCENARIOS) / sizeof(SCENARIOS[0]); i++)
+    {
+        if (!RunScenario(&SCENARIOS[i]))
+            return 1;
+    }
+    printf("all scenarios pass\n");
+    return 0;
+}
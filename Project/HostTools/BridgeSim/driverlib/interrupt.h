@@ -0,0 +1,22 @@
+/*
+ * interrupt.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare NVIC driver when firmware modules are built on
+ *  the host, bridge_sim.c provides the functions.
+ */
+
+#ifndef DRIVERLIB_INTERRUPT_H_
+#define DRIVERLIB_INTERRUPT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+extern bool IntMasterEnable(void);
+extern bool IntMasterDisable(void);
+extern void IntEnable(uint32_t ui32Interrupt);
+extern void IntDisable(uint32_t ui32Interrupt);
+extern void IntPendSet(uint32_t ui32Interrupt);
+
+#endif /* DRIVERLIB_INTERRUPT_H_ */
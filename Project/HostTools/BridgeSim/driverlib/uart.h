@@ -0,0 +1,46 @@
+/*
+ * uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare UART driver when firmware modules are built on
+ *  the host, bridge_sim.c provides the functions.
+ */
+
+#ifndef DRIVERLIB_UART_H_
+#define DRIVERLIB_UART_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UART_INT_RT             0x040
+#define UART_INT_TX             0x020
+#define UART_INT_RX             0x010
+
+#define UART_FIFO_TX1_8         0x00000000
+#define UART_FIFO_TX2_8         0x00000001
+#define UART_FIFO_TX4_8         0x00000002
+#define UART_FIFO_TX6_8         0x00000003
+#define UART_FIFO_TX7_8         0x00000004
+#define UART_FIFO_RX1_8         0x00000000
+#define UART_FIFO_RX2_8         0x00000008
+#define UART_FIFO_RX4_8         0x00000010
+#define UART_FIFO_RX6_8         0x00000018
+#define UART_FIFO_RX7_8         0x00000020
+
+#define UART_TXINT_MODE_FIFO    0x00000000
+#define UART_TXINT_MODE_EOT     0x00000010
+
+extern void UARTFIFOEnable(uint32_t ui32Base);
+extern void UARTFIFOLevelSet(uint32_t ui32Base, uint32_t ui32TxLevel, uint32_t ui32RxLevel);
+extern void UARTTxIntModeSet(uint32_t ui32Base, uint32_t ui32Mode);
+extern void UARTIntRegister(uint32_t ui32Base, void (*pfnHandler)(void));
+extern void UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern void UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern uint32_t UARTIntStatus(uint32_t ui32Base, bool bMasked);
+extern void UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern bool UARTCharsAvail(uint32_t ui32Base);
+extern int32_t UARTCharGetNonBlocking(uint32_t ui32Base);
+extern bool UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData);
+
+#endif /* DRIVERLIB_UART_H_ */
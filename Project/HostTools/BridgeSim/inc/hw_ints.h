@@ -0,0 +1,16 @@
+/*
+ * hw_ints.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare interrupt numbers when firmware modules are
+ *  built on the host.
+ */
+
+#ifndef INC_HW_INTS_H_
+#define INC_HW_INTS_H_
+
+#define INT_UART0           21
+#define INT_UART5           77
+
+#endif /* INC_HW_INTS_H_ */
@@ -0,0 +1,18 @@
+/*
+ * hw_types.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare register access macros when firmware modules are
+ *  built on the host. Code that touches registers (DSP_Benchmark) must not
+ *  run there.
+ */
+
+#ifndef INC_HW_TYPES_H_
+#define INC_HW_TYPES_H_
+
+#include <stdint.h>
+
+#define HWREG(x)            (*((volatile uint32_t *)(uintptr_t)(x)))
+
+#endif /* INC_HW_TYPES_H_ */
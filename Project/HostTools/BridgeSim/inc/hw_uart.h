@@ -0,0 +1,15 @@
+/*
+ * hw_uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare UART register definitions when firmware modules
+ *  are built on the host.
+ */
+
+#ifndef INC_HW_UART_H_
+#define INC_HW_UART_H_
+
+#define UART_DR_OE          0x00000800  // overrun error, with the byte read
+
+#endif /* INC_HW_UART_H_ */
@@ -0,0 +1,248 @@
+/*
+ * dsp_check.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host check of the lab_7 DSP kernels. Each kernel runs over a random stream
+ *  cut into random block sizes, and its output is compared against a direct
+ *  reference computed over the whole stream: exact for CIC, FIR, MA and the
+ *  window (same rounding, integer arithmetic), within one LSB of a floating
+ *  point EMA. Exits with 1 on the first mismatch.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -Wall -I. -o dsp_check dsp_check.c ../../../lab_7-sze_to_kwok_leung-1155149068/DSP/DSP.c -lm
+ *      ./dsp_check [seed]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../../lab_7-sze_to_kwok_leung-1155149068/DSP/DSP.h"
+
+#define CHECK_SAMPLES       20000
+#define CHECK_MAX_BLOCK     300
+
+static uint16_t g_pui16Raw[CHECK_SAMPLES];
+static int32_t g_pi32In[CHECK_SAMPLES];
+static int32_t g_pi32Out[CHECK_SAMPLES + 1];
+static int32_t g_pi32Ref[CHECK_SAMPLES + 1];
+static uint32_t g_ui32Checked;
+
+static uint32_t Block(uint32_t ui32Left)
+{
+    uint32_t ui32Len = rand() % (CHECK_MAX_BLOCK + 1);
+
+    return ui32Len < ui32Left ? ui32Len : ui32Left;
+}
+
+static int64_t RoundShift(int64_t i64Value, uint32_t ui32Shift)
+{
+    return ui32Shift ? (i64Value + ((int64_t)1 << (ui32Shift - 1))) >> ui32Shift : i64Value;
+}
+
+static void Fail(const char *pcKernel, uint32_t ui32Config, uint32_t ui32Index, int32_t i32Got, int64_t i64Want)
+{
+    printf("%s (%u): value %u is %d, expected %lld\n", pcKernel, ui32Config, ui32Index, i32Got, (long long)i64Want);
+    exit(1);
+}
+
+static void CheckCic(uint32_t ui32Rate)
+{
+    tDspCic sCic;
+    int64_t pi64Stage[CHECK_SAMPLES];
+    uint32_t ui32Count = 0, ui32Pos, ui32Len, ui32Shift, i, k, s;
+    int64_t i64Sum;
+
+    DSP_CicInit(&sCic, ui32Rate);
+    for (ui32Pos = 0; ui32Pos < CHECK_SAMPLES; ui32Pos += ui32Len)
+    {
+        ui32Len = Block(CHECK_SAMPLES - ui32Pos);
+        ui32Count += DSP_Cic(&sCic, &g_pui16Raw[ui32Pos], ui32Len, &g_pi32Out[ui32Count]);
+    }
+
+    // reference: DSP_CIC_ORDER boxcars of length rate, every rate-th value
+    for (i = 0; i < CHECK_SAMPLES; i++)
+        g_pi32Ref[i] = g_pui16Raw[i];
+    for (i = 0; i < CHECK_SAMPLES; i++)
+        pi64Stage[i] = g_pi32Ref[i];
+    for (s = 0; s < DSP_CIC_ORDER; s++)
+    {
+        int64_t *pi64Next = malloc(sizeof(int64_t) * CHECK_SAMPLES);
+
+        for (i = 0; i < CHECK_SAMPLES; i++)
+        {
+            for (i64Sum = 0, k = 0; k < ui32Rate && k <= i; k++)
+                i64Sum += pi64Stage[i - k];
+            pi64Next[i] = i64Sum;
+        }
+        for (i = 0; i < CHECK_SAMPLES; i++)
+            pi64Stage[i] = pi64Next[i];
+        free(pi64Next);
+    }
+
+    for (ui32Shift = 0, k = ui32Rate; k > 1; k >>= 1)
+        ui32Shift += DSP_CIC_ORDER;
+    if (ui32Count != CHECK_SAMPLES / ui32Rate)
+        Fail("cic count", ui32Rate, 0, ui32Count, CHECK_SAMPLES / ui32Rate);
+    for (i = 0; i < ui32Count; i++)
+    {
+        int64_t i64Want = pi64Stage[(i + 1) * ui32Rate - 1] << DSP_FRAC;
+
+        i64Want = RoundShift(i64Want, ui32Shift);
+        if (g_pi32Out[i] != i64Want)
+            Fail("cic", ui32Rate, i, g_pi32Out[i], i64Want);
+    }
+    g_ui32Checked += ui32Count;
+}
+
+static void CheckFir(uint32_t ui32Taps, uint32_t ui32Decimation)
+{
+    int16_t pi16Coef[DSP_FIR_MAX_TAPS];
+    tDspFir sFir;
+    uint32_t ui32Count = 0, ui32Pos, ui32Len, i, k;
+    int64_t i64Acc;
+    double dAcc;
+
+    for (k = 0; k < ui32Taps; k++)
+        pi16Coef[k] = (int16_t)(rand() % 65536 - 32768);
+    DSP_FirInit(&sFir, pi16Coef, ui32Taps, ui32Decimation);
+    for (ui32Pos = 0; ui32Pos < CHECK_SAMPLES; ui32Pos += ui32Len)
+    {
+        ui32Len = Block(CHECK_SAMPLES - ui32Pos);
+        ui32Count += DSP_Fir(&sFir, &g_pi32In[ui32Pos], ui32Len, &g_pi32Out[ui32Count]);
+    }
+
+    if (ui32Count != CHECK_SAMPLES / ui32Decimation)
+        Fail("fir count", ui32Taps, 0, ui32Count, CHECK_SAMPLES / ui32Decimation);
+    for (i = 0; i < ui32Count; i++)
+    {
+        uint32_t ui32Now = (i + 1) * ui32Decimation - 1;
+
+        for (i64Acc = 0, dAcc = 0, k = 0; k < ui32Taps && k <= ui32Now; k++)
+        {
+            i64Acc += (int64_t)pi16Coef[k] * g_pi32In[ui32Now - k];
+            dAcc += pi16Coef[k] / 32768.0 * g_pi32In[ui32Now - k];
+        }
+        if (g_pi32Out[i] != RoundShift(i64Acc, 15) || fabs(g_pi32Out[i] - dAcc) > 0.5 + 1e-9)
+            Fail("fir", ui32Taps, i, g_pi32Out[i], RoundShift(i64Acc, 15));
+    }
+    g_ui32Checked += ui32Count;
+}
+
+static void CheckMa(uint32_t ui32Window)
+{
+    tDspMa sMa;
+    uint32_t ui32Pos, ui32Len, ui32Shift, i, k;
+    int64_t i64Sum;
+
+    DSP_MaInit(&sMa, ui32Window);
+    for (ui32Pos = 0; ui32Pos < CHECK_SAMPLES; ui32Pos += ui32Len)
+    {
+        ui32Len = Block(CHECK_SAMPLES - ui32Pos);
+        DSP_Ma(&sMa, &g_pi32In[ui32Pos], ui32Len, &g_pi32Out[ui32Pos]);
+    }
+
+    for (ui32Shift = 0, k = ui32Window; k > 1; k >>= 1)
+        ui32Shift++;
+    for (i = 0; i < CHECK_SAMPLES; i++)
+    {
+        // the window starts filled with the first value
+        for (i64Sum = 0, k = 0; k < ui32Window; k++)
+            i64Sum += k <= i ? g_pi32In[i - k] : g_pi32In[0];
+        if (g_pi32Out[i] != RoundShift(i64Sum, ui32Shift))
+            Fail("ma", ui32Window, i, g_pi32Out[i], RoundShift(i64Sum, ui32Shift));
+    }
+    g_ui32Checked += CHECK_SAMPLES;
+}
+
+static void CheckEma(uint32_t ui32Shift)
+{
+    tDspEma sEma;
+    uint32_t ui32Pos, ui32Len, i;
+    double dY = g_pi32In[0], dAlpha = 1.0 / (1 << ui32Shift);
+
+    DSP_EmaInit(&sEma, ui32Shift);
+    for (ui32Pos = 0; ui32Pos < CHECK_SAMPLES; ui32Pos += ui32Len)
+    {
+        ui32Len = Block(CHECK_SAMPLES - ui32Pos);
+        DSP_Ema(&sEma, &g_pi32In[ui32Pos], ui32Len, &g_pi32Out[ui32Pos]);
+    }
+
+    for (i = 0; i < CHECK_SAMPLES; i++)
+    {
+        dY += (g_pi32In[i] - dY) * dAlpha;
+        if (fabs(g_pi32Out[i] - dY) > 1.0)
+            Fail("ema", ui32Shift, i, g_pi32Out[i], (int64_t)lround(dY));
+    }
+    g_ui32Checked += CHECK_SAMPLES;
+}
+
+static void CheckWindow(uint32_t ui32Window)
+{
+    tDspWindow sWindow;
+    tDspSummary sSummary;
+    uint32_t ui32Summaries = 0, i, k;
+    int32_t i32Min, i32Max;
+    int64_t i64Sum;
+    double dMean;
+
+    DSP_WindowInit(&sWindow, ui32Window);
+    for (i = 0; i < CHECK_SAMPLES; i++)
+    {
+        if (!DSP_WindowAdd(&sWindow, g_pi32In[i] - 32768, &sSummary))
+            continue;
+
+        i32Min = i32Max = g_pi32In[i] - 32768;
+        for (i64Sum = 0, k = i + 1 - ui32Window; k <= i; k++)
+        {
+            int32_t i32Value = g_pi32In[k] - 32768;
+
+            i64Sum += i32Value;
+            i32Min = i32Value < i32Min ? i32Value : i32Min;
+            i32Max = i32Value > i32Max ? i32Value : i32Max;
+        }
+        dMean = (double)i64Sum / ui32Window;
+        if (sSummary.i32Min != i32Min || sSummary.i32Max != i32Max || sSummary.ui32Count != ui32Window ||
+            sSummary.i32Mean != (int32_t)(dMean < 0 ? -floor(-dMean + 0.5) : floor(dMean + 0.5)))
+            Fail("window", ui32Window, ui32Summaries, sSummary.i32Mean, (int64_t)lround(dMean));
+        ui32Summaries++;
+    }
+    if (ui32Summaries != CHECK_SAMPLES / ui32Window)
+        Fail("window count", ui32Window, 0, ui32Summaries, CHECK_SAMPLES / ui32Window);
+    g_ui32Checked += ui32Summaries;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t pui32Cic[] = { 2, 4, 16, 64 };
+    static const uint32_t pui32Fir[][2] = { { 1, 1 }, { 7, 1 }, { 16, 4 }, { 31, 10 }, { DSP_FIR_MAX_TAPS, 3 } };
+    static const uint32_t pui32Ma[] = { 1, 2, 16, DSP_MA_MAX };
+    static const uint32_t pui32Ema[] = { 0, 1, 4, 8, 14 };
+    static const uint32_t pui32Window[] = { 1, 10, 100, 999 };
+    uint32_t i;
+
+    srand(argc > 1 ? (unsigned)atoi(argv[1]) : 1);
+
+    // 12 bit codes with a slow drift, and the same stream with DSP_FRAC bits as the filters see it
+    for (i = 0; i < CHECK_SAMPLES; i++)
+    {
+        int32_t i32Code = 2048 + (int32_t)(1500 * sin(i * 0.001)) + rand() % 201 - 100;
+
+        g_pui16Raw[i] = (uint16_t)(i32Code < 0 ? 0 : i32Code > 4095 ? 4095 : i32Code);
+        g_pi32In[i] = (g_pui16Raw[i] << DSP_FRAC) + rand() % DSP_ONE;
+    }
+
+    for (i = 0; i < sizeof(pui32Cic) / sizeof(pui32Cic[0]); i++)
+        CheckCic(pui32Cic[i]);
+    for (i = 0; i < sizeof(pui32Fir) / sizeof(pui32Fir[0]); i++)
+        CheckFir(pui32Fir[i][0], pui32Fir[i][1]);
+    for (i = 0; i < sizeof(pui32Ma) / sizeof(pui32Ma[0]); i++)
+        CheckMa(pui32Ma[i]);
+    for (i = 0; i < sizeof(pui32Ema) / sizeof(pui32Ema[0]); i++)
+        CheckEma(pui32Ema[i]);
+    for (i = 0; i < sizeof(pui32Window) / sizeof(pui32Window[0]); i++)
+        CheckWindow(pui32Window[i]);
+
+    printf("all kernels match, %u values checked\n", g_ui32Checked);
+    return 0;
+}
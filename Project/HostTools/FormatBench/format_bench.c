@@ -0,0 +1,214 @@
+/*
+ * format_bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host benchmark of the FORMAT module against the UARTIntPut the turret
+ *  boards used before it (repeated % 10 and / 10, copied below): the
+ *  conversion alone, and the whole UARTIntPut behind the same UARTStringPut
+ *  into a stub UARTCharPut. Values are small as the consoles print them, or
+ *  up to 8 digits. Every FORMAT result is first checked against snprintf,
+ *  exits with 1 on a mismatch.
+ *
+ *  Cycles are TSC ticks on x86 and nanoseconds elsewhere; only the ratio
+ *  carries over to the Cortex-M4, where the old path's UDIV per digit costs
+ *  more relative to the UMULL FORMAT uses instead.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -Wall -o format_bench format_bench.c ../../TurretSlave/FORMAT/FORMAT.c
+ *      ./format_bench [million conversions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../../TurretSlave/FORMAT/FORMAT.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define BENCH_VALUES        4096        // power of 2, indexed with a mask
+#define BENCH_SMALL_MAX     1000        // angles, counters
+#define BENCH_LARGE_MAX     99999999    // the old result[10] holds 8 digits and a sign
+
+static int g_pi32Small[BENCH_VALUES];
+static int g_pi32Large[BENCH_VALUES];
+static volatile uint32_t g_ui32Sink;
+
+static uint64_t Ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return (uint64_t)sNow.tv_sec * 1000000000u + sNow.tv_nsec;
+#endif
+}
+
+// The UART, only counts what it is given
+static void UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    g_ui32Sink += ucData + ui32Base;
+}
+
+static void UARTStringPut(uint32_t ui32Base, char *str)
+{
+    int i;
+    for (i = 0; str[i] != '\0'; i++)
+    {
+        UARTCharPut(ui32Base, str[i]);
+    }
+}
+
+// The conversion of the old UARTIntPut, result[10]
+static void OldFormat(char *result, int value)
+{
+    char temp[10];
+    int tempCount = 0;
+    int resultCount = 0;
+
+    if (value == 0)
+    {
+        result[0] = '0';
+        result[1] = '\0';
+    }
+
+    if (value < 0)
+    {
+        result[resultCount++] = '-';
+        value *= -1;
+    }
+
+    // Covert to char from LSB
+    while (value > 0)
+    {
+        temp[tempCount++] = (value % 10) + '0';
+        value /= 10;
+    }
+
+    // Put back the result from MSB
+    while (--tempCount >= 0)
+    {
+        result[resultCount++] = temp[tempCount];
+    }
+    result[resultCount] = '\0';
+}
+
+// UARTIntPut as it was, zero is sent ahead of the conversion
+static void OldIntPut(uint32_t ui32Base, int value)
+{
+    char result[10];
+
+    if (value == 0)
+        UARTCharPut(ui32Base, '0');
+    OldFormat(result, value);
+    UARTStringPut(ui32Base, result);
+}
+
+// UARTIntPut as it is now
+static void NewIntPut(uint32_t ui32Base, int value)
+{
+    char result[FORMAT_INT_MAX_LEN];
+
+    FORMAT_Int(result, value);
+    UARTStringPut(ui32Base, result);
+}
+
+// The conversions alone, into a buffer
+static void OldConvert(uint32_t ui32Base, int value)
+{
+    char result[10];
+
+    OldFormat(result, value);
+    g_ui32Sink += result[0] + ui32Base;
+}
+
+static void NewConvert(uint32_t ui32Base, int value)
+{
+    char result[FORMAT_INT_MAX_LEN];
+
+    g_ui32Sink += FORMAT_Int(result, value) + ui32Base;
+}
+
+static void Fail(const char *pcFunction, int32_t i32Value, const char *pcGot, const char *pcWant)
+{
+    printf("%s(%d): \"%s\", expected \"%s\"\n", pcFunction, i32Value, pcGot, pcWant);
+    exit(1);
+}
+
+static void Check(int32_t i32Value)
+{
+    char pcGot[32], pcWant[32];
+    uint32_t ui32Width = (uint32_t)i32Value & 15, ui32Len;
+
+    ui32Len = FORMAT_Int(pcGot, i32Value);
+    snprintf(pcWant, sizeof(pcWant), "%d", i32Value);
+    if (strcmp(pcGot, pcWant) || ui32Len != strlen(pcWant))
+        Fail("FORMAT_Int", i32Value, pcGot, pcWant);
+
+    ui32Len = FORMAT_Uint(pcGot, (uint32_t)i32Value);
+    snprintf(pcWant, sizeof(pcWant), "%u", (uint32_t)i32Value);
+    if (strcmp(pcGot, pcWant) || ui32Len != strlen(pcWant))
+        Fail("FORMAT_Uint", i32Value, pcGot, pcWant);
+
+    ui32Len = FORMAT_IntFixed(pcGot, i32Value, ui32Width, '0');
+    snprintf(pcWant, sizeof(pcWant), "%0*d", (int)ui32Width, i32Value);
+    if (strcmp(pcGot, pcWant) || ui32Len != strlen(pcWant))
+        Fail("FORMAT_IntFixed '0'", i32Value, pcGot, pcWant);
+
+    ui32Len = FORMAT_IntFixed(pcGot, i32Value, ui32Width, ' ');
+    snprintf(pcWant, sizeof(pcWant), "%*d", (int)ui32Width, i32Value);
+    if (strcmp(pcGot, pcWant) || ui32Len != strlen(pcWant))
+        Fail("FORMAT_IntFixed ' '", i32Value, pcGot, pcWant);
+}
+
+static double Bench(void (*pfnPut)(uint32_t, int), const int *pi32Values, uint32_t ui32Count)
+{
+    uint64_t ui64Start = Ticks();
+    uint32_t i;
+
+    for (i = 0; i < ui32Count; i++)
+        pfnPut(0, pi32Values[i & (BENCH_VALUES - 1)]);
+
+    return (double)(Ticks() - ui64Start) / ui32Count;
+}
+
+int main(int argc, char **argv)
+{
+    static const int32_t pi32Edges[] = { 0, 1, -1, 9, 10, 99, 100, -100, 9999, 10000, 99999999, 100000000,
+                                         2147483647, -2147483647 - 1 };
+    uint32_t ui32Count = (argc > 1 ? (uint32_t)atoi(argv[1]) : 20) * 1000000u;
+    double dOldConvert, dNewConvert, dOld, dNew;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(pi32Edges) / sizeof(pi32Edges[0]); i++)
+        Check(pi32Edges[i]);
+    srand(1);
+    for (i = 0; i < 1000000; i++)
+        Check((int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()) >> (rand() % 32));
+
+    for (i = 0; i < BENCH_VALUES; i++)
+    {
+        g_pi32Small[i] = rand() % BENCH_SMALL_MAX;
+        g_pi32Large[i] = rand() % (2 * BENCH_LARGE_MAX + 1) - BENCH_LARGE_MAX;
+    }
+
+    printf("FORMAT matches snprintf\n");
+    printf("cycles per conversion        convert only    UARTIntPut\n");
+    printf("                              old    new      old    new\n");
+    for (i = 0; i < 2; i++)
+    {
+        const int *pi32Values = i ? g_pi32Large : g_pi32Small;
+
+        dOldConvert = Bench(OldConvert, pi32Values, ui32Count);
+        dNewConvert = Bench(NewConvert, pi32Values, ui32Count);
+        dOld = Bench(OldIntPut, pi32Values, ui32Count);
+        dNew = Bench(NewIntPut, pi32Values, ui32Count);
+        printf("%-26s %6.1f %6.1f   %6.1f %6.1f\n", i ? "-99999999 - 99999999" : "0 - 999",
+               dOldConvert, dNewConvert, dOld, dNew);
+    }
+    return 0;
+}
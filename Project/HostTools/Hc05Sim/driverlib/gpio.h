@@ -0,0 +1,27 @@
+/*
+ * gpio.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare GPIO driver when firmware modules are built on
+ *  the host, hc05_sim.c provides the functions.
+ */
+
+#ifndef DRIVERLIB_GPIO_H_
+#define DRIVERLIB_GPIO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GPIO_PIN_1          0x00000002
+#define GPIO_PIN_2          0x00000004
+#define GPIO_PIN_3          0x00000008
+#define GPIO_PIN_4          0x00000010
+#define GPIO_PIN_5          0x00000020
+
+extern void GPIOPinConfigure(uint32_t ui32PinConfig);
+extern void GPIOPinTypeUART(uint32_t ui32Port, uint8_t ui8Pins);
+extern void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins);
+extern void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val);
+
+#endif /* DRIVERLIB_GPIO_H_ */
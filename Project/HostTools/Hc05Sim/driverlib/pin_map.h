@@ -0,0 +1,19 @@
+/*
+ * pin_map.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare pin map driver when firmware modules are built
+ *  on the host, hc05_sim.c provides the functions.
+ */
+
+#ifndef DRIVERLIB_PIN_MAP_H_
+#define DRIVERLIB_PIN_MAP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GPIO_PE4_U5RX       0x00041001
+#define GPIO_PE5_U5TX       0x00041401
+
+#endif /* DRIVERLIB_PIN_MAP_H_ */
@@ -0,0 +1,23 @@
+/*
+ * sysctl.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare system control driver when firmware modules are
+ *  built on the host, hc05_sim.c provides the functions.
+ */
+
+#ifndef DRIVERLIB_SYSCTL_H_
+#define DRIVERLIB_SYSCTL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SYSCTL_PERIPH_GPIOE 0xf0000804
+#define SYSCTL_PERIPH_UART5 0xf0001805
+
+extern void SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+extern uint32_t SysCtlClockGet(void);
+extern void SysCtlDelay(uint32_t ui32Count);
+
+#endif /* DRIVERLIB_SYSCTL_H_ */
@@ -0,0 +1,25 @@
+/*
+ * uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare UART driver when firmware modules are built on
+ *  the host, hc05_sim.c provides the functions.
+ */
+
+#ifndef DRIVERLIB_UART_H_
+#define DRIVERLIB_UART_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UART_CONFIG_WLEN_8      0x00000060
+#define UART_CONFIG_STOP_ONE    0x00000000
+#define UART_CONFIG_PAR_NONE    0x00000000
+
+extern void UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud, uint32_t ui32Config);
+extern void UARTCharPut(uint32_t ui32Base, unsigned char ucData);
+extern bool UARTCharsAvail(uint32_t ui32Base);
+extern int32_t UARTCharGetNonBlocking(uint32_t ui32Base);
+
+#endif /* DRIVERLIB_UART_H_ */
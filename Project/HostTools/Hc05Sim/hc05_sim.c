@@ -0,0 +1,294 @@
+/*
+ * hc05_sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host test of the HC05 rate negotiation against a scripted fake module.
+ *  The fake follows the HC-05 behaviour the firmware relies on: it boots
+ *  into full AT mode at 38400 baud when KEY is high at power up and into
+ *  data mode at its stored rate otherwise, KEY high in data mode gives the
+ *  mini AT mode at the data rate, and AT+UART only takes effect at the next
+ *  power up. Bytes sent at a rate the module is not running at are lost, as
+ *  are bytes at rates above what the wiring carries.
+ *
+ *  Each scenario runs the real HC05_Init() / HC05_Configure() on a simulated
+ *  clock driven by SysCtlDelay() and checks the rate both sides end up at,
+ *  the rate stored in the module and that it is back in data mode.
+ *  Exits with 1 on the first failed scenario.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -Wall -I. -o hc05_sim hc05_sim.c ../../TurretSlave/HC05/HC05.c ../../TurretSlave/FORMAT/FORMAT.c
+ *      ./hc05_sim
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../TurretSlave/HC05/HC05.h"
+
+#define SIM_CLOCK_HZ        80000000
+#define SIM_BOOT_MS         500         // the module answers this long after EN goes high
+#define SIM_REPLY_US        2000        // command to first reply byte
+#define SIM_FIFO            64
+
+typedef enum
+{
+    MODULE_OFF,
+    MODULE_DATA,
+    MODULE_AT_FULL,                     // KEY high at power up, 38400 baud
+    MODULE_AT_MINI                      // KEY raised in data mode, data rate
+} tModuleMode;
+
+typedef struct
+{
+    const char *pcName;
+    bool bPresent;                      // answers at all
+    uint32_t ui32StoredBaud;            // rate in the module's flash at the start
+    uint32_t ui32MaxAccepted;           // AT+UART above this is answered with ERROR
+    uint32_t ui32MaxWorking;            // the wiring loses bytes above this rate
+    uint32_t ui32LostProbes;            // mini AT mode "AT"s that go unanswered
+    uint32_t ui32ExpectBaud;
+} tScenario;
+
+static const tScenario SCENARIOS[] = {
+    { "all rates work", true, 38400, 460800, 460800, 0, 460800 },
+    { "460800 rejected", true, 38400, 230400, 460800, 0, 230400 },
+    { "460800 accepted, link fails", true, 38400, 460800, 230400, 0, 230400 },
+    { "only the default works", true, 38400, 460800, 38400, 0, 38400 },
+    { "no module", false, 38400, 460800, 460800, 0, 38400 },
+    { "first probe lost", true, 38400, 460800, 460800, 1, 460800 },
+    { "stored 115200 from last boot", true, 115200, 460800, 460800, 0, 460800 },
+};
+
+static const uint32_t RATES[] = { 460800, 230400, 115200 };
+
+// Simulated time and the two ends of UART5
+static uint64_t g_ui64Ns;
+static uint32_t g_ui32McuBaud;
+
+static const tScenario *g_psScript;
+static tModuleMode g_eMode;
+static uint8_t g_ui8Pins;               // EN and KEY as driven by the MCU
+static uint64_t g_ui64BootNs;           // EN went high, answers from SIM_BOOT_MS on
+static uint32_t g_ui32Stored;
+static uint32_t g_ui32LostProbes;
+static uint32_t g_ui32Commands;
+static char g_pcLine[64];
+static uint32_t g_ui32LineLen;
+
+// Reply bytes on their way to the MCU, with the time each one arrives
+static uint8_t g_pui8Fifo[SIM_FIFO];
+static uint64_t g_pui64Arrival[SIM_FIFO];
+static uint32_t g_ui32FifoHead, g_ui32FifoCount;
+
+static uint32_t ModuleBaud(void)
+{
+    return g_eMode == MODULE_AT_FULL ? HC05_DEFAULT_BAUD : g_ui32Stored;
+}
+
+static bool ModuleReady(void)
+{
+    return g_eMode != MODULE_OFF && g_ui64Ns - g_ui64BootNs >= (uint64_t)SIM_BOOT_MS * 1000000;
+}
+
+static bool LineWorks(void)
+{
+    return g_psScript->bPresent && g_ui32McuBaud == ModuleBaud() && ModuleBaud() <= g_psScript->ui32MaxWorking;
+}
+
+static void Reply(const char *pcReply)
+{
+    uint64_t ui64At = g_ui64Ns + SIM_REPLY_US * 1000;
+
+    if (!LineWorks())
+        return;
+    for (; *pcReply && g_ui32FifoCount < SIM_FIFO; pcReply++)
+    {
+        uint32_t ui32Slot = (g_ui32FifoHead + g_ui32FifoCount++) % SIM_FIFO;
+
+        ui64At += 10000000000ull / g_ui32McuBaud;
+        g_pui8Fifo[ui32Slot] = (uint8_t)*pcReply;
+        g_pui64Arrival[ui32Slot] = ui64At;
+    }
+}
+
+static void ModuleCommand(const char *pcLine)
+{
+    unsigned long ulBaud;
+
+    g_ui32Commands++;
+    if (!strcmp(pcLine, "AT"))
+    {
+        if (g_eMode == MODULE_AT_MINI && g_ui32LostProbes)
+        {
+            g_ui32LostProbes--;
+            return;
+        }
+        Reply("OK\r\n");
+    }
+    else if (sscanf(pcLine, "AT+UART=%lu,0,0", &ulBaud) == 1)
+    {
+        if (ulBaud > g_psScript->ui32MaxAccepted)
+        {
+            Reply("ERROR:(1D)\r\n");
+            return;
+        }
+        g_ui32Stored = (uint32_t)ulBaud;
+        Reply("OK\r\n");
+    }
+    else
+        Reply("ERROR:(0)\r\n");
+}
+
+/*
+ * Driver stand-ins
+ */
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+    (void)ui32Peripheral;
+}
+
+uint32_t SysCtlClockGet(void)
+{
+    return SIM_CLOCK_HZ;
+}
+
+// Three cycles per count, as on the part
+void SysCtlDelay(uint32_t ui32Count)
+{
+    g_ui64Ns += (uint64_t)ui32Count * 3 * 1000000000 / SIM_CLOCK_HZ;
+}
+
+void GPIOPinConfigure(uint32_t ui32PinConfig)
+{
+    (void)ui32PinConfig;
+}
+
+void GPIOPinTypeUART(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    (void)ui32Port;
+    (void)ui8Pins;
+}
+
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    (void)ui32Port;
+    (void)ui8Pins;
+}
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    uint8_t ui8Old = g_ui8Pins;
+
+    if (ui32Port != HC05_GPIO_BASE)
+        return;
+    g_ui8Pins = (g_ui8Pins & ~ui8Pins) | (ui8Val & ui8Pins);
+
+    if (!(g_ui8Pins & HC05_PIN_EN))
+    {
+        g_eMode = MODULE_OFF;
+    }
+    else if (!(ui8Old & HC05_PIN_EN))
+    {
+        // power up, KEY selects the mode
+        g_eMode = g_ui8Pins & HC05_PIN_KEY ? MODULE_AT_FULL : MODULE_DATA;
+        g_ui64BootNs = g_ui64Ns;
+        g_ui32LineLen = 0;
+    }
+    else if (g_eMode == MODULE_DATA && (g_ui8Pins & HC05_PIN_KEY))
+    {
+        g_eMode = MODULE_AT_MINI;
+    }
+    else if (g_eMode == MODULE_AT_MINI && !(g_ui8Pins & HC05_PIN_KEY))
+    {
+        g_eMode = MODULE_DATA;
+    }
+}
+
+void UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud, uint32_t ui32Config)
+{
+    (void)ui32Base;
+    (void)ui32UARTClk;
+    (void)ui32Config;
+    g_ui32McuBaud = ui32Baud;
+}
+
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    (void)ui32Base;
+    g_ui64Ns += 10000000000ull / g_ui32McuBaud;
+
+    // data mode bytes would go over the air, the rest is lost on a rate mismatch
+    if (!ModuleReady() || g_eMode == MODULE_DATA || !LineWorks())
+        return;
+    if (ucData == '\n')
+    {
+        g_pcLine[g_ui32LineLen] = '\0';
+        g_ui32LineLen = 0;
+        ModuleCommand(g_pcLine);
+    }
+    else if (ucData != '\r' && g_ui32LineLen < sizeof(g_pcLine) - 1)
+        g_pcLine[g_ui32LineLen++] = (char)ucData;
+}
+
+bool UARTCharsAvail(uint32_t ui32Base)
+{
+    (void)ui32Base;
+    return g_ui32FifoCount && g_pui64Arrival[g_ui32FifoHead] <= g_ui64Ns;
+}
+
+int32_t UARTCharGetNonBlocking(uint32_t ui32Base)
+{
+    uint8_t ui8Data;
+
+    if (!UARTCharsAvail(ui32Base))
+        return -1;
+    ui8Data = g_pui8Fifo[g_ui32FifoHead];
+    g_ui32FifoHead = (g_ui32FifoHead + 1) % SIM_FIFO;
+    g_ui32FifoCount--;
+    return ui8Data;
+}
+
+static bool RunScenario(const tScenario *psScenario)
+{
+    uint32_t ui32Baud;
+    bool bOk;
+
+    g_psScript = psScenario;
+    g_ui64Ns = 0;
+    g_ui32McuBaud = HC05_DEFAULT_BAUD;
+    g_eMode = MODULE_OFF;
+    g_ui8Pins = 0;
+    g_ui32Stored = psScenario->ui32StoredBaud;
+    g_ui32LostProbes = psScenario->ui32LostProbes;
+    g_ui32Commands = 0;
+    g_ui32FifoCount = 0;
+
+    // the module is powered and in data mode before the firmware starts
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_EN, HC05_PIN_EN);
+    g_ui64Ns = (uint64_t)SIM_BOOT_MS * 1000000;
+
+    HC05_Init();
+    ui32Baud = HC05_Configure(RATES, sizeof(RATES) / sizeof(RATES[0]));
+
+    // a module that never answered keeps whatever it had stored
+    bOk = ui32Baud == psScenario->ui32ExpectBaud && HC05_BaudGet() == ui32Baud && g_ui32McuBaud == ui32Baud &&
+          g_eMode == MODULE_DATA && (!psScenario->bPresent || g_ui32Stored == ui32Baud);
+
+    printf("%-32s %6u baud, module stores %6u, %2u commands, %5u ms  %s\n", psScenario->pcName, ui32Baud,
+           g_ui32Stored, g_ui32Commands, (uint32_t)(g_ui64Ns / 1000000), bOk ? "ok" : "FAILED");
+    return bOk;
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(SCENARIOS) / sizeof(SCENARIOS[0]); i++)
+    {
+        if (!RunScenario(&SCENARIOS[i]))
+            return 1;
+    }
+    printf("all scenarios pass\n");
+    return 0;
+}
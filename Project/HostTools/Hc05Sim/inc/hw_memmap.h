@@ -0,0 +1,18 @@
+/*
+ * hw_memmap.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare memory map definitions when firmware modules are
+ *  built on the host.
+ */
+
+#ifndef INC_HW_MEMMAP_H_
+#define INC_HW_MEMMAP_H_
+
+#include <stdint.h>
+
+#define GPIO_PORTE_BASE     0x40024000
+#define UART5_BASE          0x40011000
+
+#endif /* INC_HW_MEMMAP_H_ */
@@ -0,0 +1,416 @@
+/*
+ * imu_recv.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  PC side of the ShowMPUData binary stream (see ShowMPUData/STREAM/STREAM.h).
+ *  Reads a serial port or a raw capture file, resyncs on SYNC0 SYNC1 and the
+ *  CRC16, and writes the raw and the fused records to one output each:
+ *      <prefix>_raw.col / <prefix>_fused.col    columnar (default)
+ *      <prefix>_raw.csv / <prefix>_fused.csv    with --csv, in g, deg/s, deg, C
+ *  Gaps in SEQ are reported on stderr as they are found, with a summary at the
+ *  end. A SEQ that goes back to 0 is a restarted stream, not a gap.
+ *
+ *  Columnar file: a text header, then each column as one little endian block
+ *      IMUCOL 1
+ *      rows <n>
+ *      col <name> <numpy dtype> <scale to physical unit>
+ *      ...
+ *      end
+ *  e.g. in numpy: read the header lines, then np.fromfile(f, dtype, n) per column.
+ *  The raw temp column also needs the sensor offset: temp * scale + 36.53 C.
+ *
+ *  Build and run from this directory:
+ *      g++ -std=c++17 -O2 -Wall -o imu_recv imu_recv.cpp
+ *      ./imu_recv /dev/ttyACM0 [-m r|f|b] [-o prefix] [-t seconds] [--csv]
+ *      ./imu_recv capture.bin [-o prefix] [--csv]
+ *  For a serial port the mode byte is sent at the start and STREAM_CMD_STOP at
+ *  the end; Ctrl-C ends the capture and writes the files.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include "../../ShowMPUData/STREAM/STREAM.h"
+}
+
+#define RECV_BAUD           B921600
+#define RECV_CHUNK          4096
+
+static volatile sig_atomic_t g_bStop = 0;
+
+static void OnSignal(int)
+{
+    g_bStop = 1;
+}
+
+static uint16_t Crc16(uint16_t ui16Crc, const uint8_t *pui8Data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        ui16Crc ^= (uint16_t)(pui8Data[i] << 8);
+        for (int j = 0; j < 8; j++)
+            ui16Crc = (ui16Crc & 0x8000) ? (uint16_t)((ui16Crc << 1) ^ 0x1021) : (uint16_t)(ui16Crc << 1);
+    }
+    return ui16Crc;
+}
+
+static uint16_t Get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t Get32(const uint8_t *p)
+{
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static const double GYRO_LSB[4] = { 131.0, 65.5, 32.8, 16.4 };
+static const double ACCEL_LSB[4] = { 16384.0, 8192.0, 4096.0, 2048.0 };
+
+/*
+ * One record type: its columns, the SEQ tracking and the gap statistics
+ */
+struct Track
+{
+    char type;
+    const char *name;
+    std::vector<std::string> cols;
+    std::vector<std::string> dtypes;
+    std::vector<double> scales;
+    std::vector<std::vector<uint8_t>> data;
+    FILE *csv = nullptr;
+
+    bool started = false;
+    uint32_t lastSeq = 0;
+    uint32_t lastTime = 0;
+    uint64_t timeHigh = 0;
+    uint64_t records = 0;
+    uint64_t gaps = 0;
+    uint64_t missing = 0;
+    uint64_t restarts = 0;
+    uint64_t overruns = 0;
+
+    template <typename T> void Put(size_t col, T value)
+    {
+        const uint8_t *p = (const uint8_t *)&value;
+        data[col].insert(data[col].end(), p, p + sizeof(T));
+    }
+};
+
+static void TrackSetup(Track &t, char type, const char *name, const std::vector<const char *> &cols,
+                       const std::vector<const char *> &dtypes, const std::vector<double> &scales)
+{
+    t.type = type;
+    t.name = name;
+    for (size_t i = 0; i < cols.size(); i++)
+    {
+        t.cols.push_back(cols[i]);
+        t.dtypes.push_back(dtypes[i]);
+        t.scales.push_back(scales[i]);
+    }
+    t.data.resize(cols.size());
+}
+
+static int OpenInput(const char *path, bool *pbSerial)
+{
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+        fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    *pbSerial = isatty(fd);
+    if (*pbSerial)
+    {
+        struct termios tio;
+        if (tcgetattr(fd, &tio) != 0)
+            return -1;
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, RECV_BAUD);
+        cfsetospeed(&tio, RECV_BAUD);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cflag &= ~CRTSCTS;
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 2;        // 0.2 s, so Ctrl-C and -t are seen on a silent port
+        if (tcsetattr(fd, TCSANOW, &tio) != 0)
+            return -1;
+        tcflush(fd, TCIOFLUSH);
+    }
+    return fd;
+}
+
+/*
+ * A record passed the CRC: track its SEQ and time, store its columns
+ */
+static void HandleRecord(Track &t, const uint8_t *rec)
+{
+    uint8_t flags = rec[3];
+    uint32_t seq = Get32(rec + 4);
+    uint32_t time = Get32(rec + 8);
+    const uint8_t *d = rec + 12;
+
+    if (t.started)
+    {
+        if (seq == 0 && t.lastSeq != 0xFFFFFFFF)
+        {
+            t.restarts++;
+            fprintf(stderr, "%s: stream restarted after seq %u\n", t.name, t.lastSeq);
+        }
+        else if (seq != t.lastSeq + 1)
+        {
+            uint32_t lost = seq - t.lastSeq - 1;
+            t.gaps++;
+            t.missing += lost;
+            fprintf(stderr, "%s: gap after seq %u, %u samples missing (%.3f ms)\n", t.name, t.lastSeq, lost,
+                    (uint32_t)(time - t.lastTime) / 1000.0);
+        }
+        if (time < t.lastTime)
+            t.timeHigh += 1ull << 32;
+    }
+    t.started = true;
+    t.lastSeq = seq;
+    t.lastTime = time;
+    t.records++;
+    if (flags & STREAM_FLAG_OVERRUN)
+        t.overruns++;
+
+    uint64_t timeUs = t.timeHigh | time;
+    double accelLsb = ACCEL_LSB[STREAM_FLAG_ACCEL_FS(flags)];
+    double gyroLsb = GYRO_LSB[STREAM_FLAG_GYRO_FS(flags)];
+
+    if (t.type == STREAM_TYPE_RAW)
+    {
+        int16_t v[7];
+        for (int i = 0; i < 7; i++)
+            v[i] = (int16_t)Get16(d + 2 * i);
+
+        if (t.csv)
+        {
+            fprintf(t.csv, "%u,%llu,%u,%.5f,%.5f,%.5f,%.3f,%.4f,%.4f,%.4f\n", seq, (unsigned long long)timeUs,
+                    flags, v[0] / accelLsb, v[1] / accelLsb, v[2] / accelLsb, v[3] / 340.0 + 36.53,
+                    v[4] / gyroLsb, v[5] / gyroLsb, v[6] / gyroLsb);
+            return;
+        }
+        t.Put(0, seq);
+        t.Put(1, timeUs);
+        t.Put(2, flags);
+        for (int i = 0; i < 7; i++)
+            t.Put(3 + i, v[i]);
+        // the full scale of the first record holds for the file
+        if (t.records == 1)
+        {
+            for (int i = 3; i < 6; i++)
+                t.scales[i] = 1.0 / accelLsb;
+            for (int i = 7; i < 10; i++)
+                t.scales[i] = 1.0 / gyroLsb;
+        }
+    }
+    else
+    {
+        int32_t angle[3];
+        for (int i = 0; i < 3; i++)
+            angle[i] = (int32_t)Get32(d + 4 * i);
+        int16_t temp = (int16_t)Get16(d + 12);
+
+        if (t.csv)
+        {
+            fprintf(t.csv, "%u,%llu,%u,%.3f,%.3f,%.3f,%.2f\n", seq, (unsigned long long)timeUs, flags,
+                    angle[0] / 1000.0, angle[1] / 1000.0, angle[2] / 1000.0, temp / 100.0);
+            return;
+        }
+        t.Put(0, seq);
+        t.Put(1, timeUs);
+        t.Put(2, flags);
+        for (int i = 0; i < 3; i++)
+            t.Put(3 + i, angle[i]);
+        t.Put(6, temp);
+    }
+}
+
+static bool WriteColumnar(const Track &t, const std::string &path)
+{
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+
+    fprintf(f, "IMUCOL 1\nrows %llu\n", (unsigned long long)t.records);
+    for (size_t i = 0; i < t.cols.size(); i++)
+        fprintf(f, "col %s %s %.10g\n", t.cols[i].c_str(), t.dtypes[i].c_str(), t.scales[i]);
+    fprintf(f, "end\n");
+    for (const auto &col : t.data)
+        fwrite(col.data(), 1, col.size(), f);
+
+    return fclose(f) == 0;
+}
+
+static void Usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s <serial port | capture file> [-m r|f|b] [-o prefix] [-t seconds] [--csv]\n"
+            "  -m  stream mode to request on a serial port (default b)\n"
+            "  -o  output prefix (default imu)\n"
+            "  -t  stop after this many seconds (serial port, default until Ctrl-C)\n"
+            "  --csv  write CSV in physical units instead of columnar files\n",
+            argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *input = nullptr;
+    const char *prefix = "imu";
+    char mode = STREAM_CMD_BOTH;
+    double seconds = 0;
+    bool csv = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-m") && i + 1 < argc)
+            mode = argv[++i][0];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+            prefix = argv[++i];
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--csv"))
+            csv = true;
+        else if (argv[i][0] != '-' && !input)
+            input = argv[i];
+        else
+        {
+            Usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!input || (mode != STREAM_CMD_RAW && mode != STREAM_CMD_FUSED && mode != STREAM_CMD_BOTH))
+    {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    bool serial = false;
+    int fd = OpenInput(input, &serial);
+    if (fd < 0)
+    {
+        fprintf(stderr, "%s: %s\n", input, strerror(errno));
+        return 1;
+    }
+
+    Track raw, fused;
+    TrackSetup(raw, STREAM_TYPE_RAW, "raw",
+               { "seq", "time_us", "flags", "accel_x", "accel_y", "accel_z", "temp", "gyro_x", "gyro_y", "gyro_z" },
+               { "<u4", "<u8", "u1", "<i2", "<i2", "<i2", "<i2", "<i2", "<i2", "<i2" },
+               { 1, 1e-6, 1, 1, 1, 1, 1.0 / 340, 1, 1, 1 });
+    TrackSetup(fused, STREAM_TYPE_FUSED, "fused",
+               { "seq", "time_us", "flags", "pitch", "roll", "yaw", "temp" },
+               { "<u4", "<u8", "u1", "<i4", "<i4", "<i4", "<i2" },
+               { 1, 1e-6, 1, 0.001, 0.001, 0.001, 0.01 });
+
+    std::string rawPath = std::string(prefix) + (csv ? "_raw.csv" : "_raw.col");
+    std::string fusedPath = std::string(prefix) + (csv ? "_fused.csv" : "_fused.col");
+    if (csv)
+    {
+        raw.csv = fopen(rawPath.c_str(), "w");
+        fused.csv = fopen(fusedPath.c_str(), "w");
+        if (!raw.csv || !fused.csv)
+        {
+            fprintf(stderr, "%s: %s\n", prefix, strerror(errno));
+            return 1;
+        }
+        fprintf(raw.csv, "seq,time_us,flags,accel_x_g,accel_y_g,accel_z_g,temp_c,gyro_x_dps,gyro_y_dps,gyro_z_dps\n");
+        fprintf(fused.csv, "seq,time_us,flags,pitch_deg,roll_deg,yaw_deg,temp_c\n");
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    if (serial)
+    {
+        uint8_t cmd = (uint8_t)mode;
+        if (write(fd, &cmd, 1) != 1)
+            fprintf(stderr, "%s: could not send the mode: %s\n", input, strerror(errno));
+    }
+
+    // bytes not decoded yet, at most one partial record is carried over
+    std::vector<uint8_t> buf;
+    uint64_t bytesIn = 0, skipped = 0, crcErrors = 0;
+    time_t start = time(nullptr);
+
+    while (!g_bStop)
+    {
+        uint8_t chunk[RECV_CHUNK];
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 || (n == 0 && !serial))
+            break;
+        if (serial && seconds > 0 && difftime(time(nullptr), start) >= seconds)
+            break;
+        bytesIn += n;
+        buf.insert(buf.end(), chunk, chunk + n);
+
+        size_t pos = 0;
+        while (buf.size() - pos >= STREAM_RECORD_SIZE)
+        {
+            const uint8_t *rec = buf.data() + pos;
+            if (rec[0] != STREAM_SYNC0 || rec[1] != STREAM_SYNC1)
+            {
+                pos++;
+                skipped++;
+                continue;
+            }
+            // a sync pair inside the data can look like a start, the CRC decides
+            if (Crc16(0xFFFF, rec + 2, STREAM_RECORD_SIZE - 4) != Get16(rec + STREAM_RECORD_SIZE - 2))
+            {
+                crcErrors++;
+                pos++;
+                skipped++;
+                continue;
+            }
+            if (rec[2] == STREAM_TYPE_RAW)
+                HandleRecord(raw, rec);
+            else if (rec[2] == STREAM_TYPE_FUSED)
+                HandleRecord(fused, rec);
+            pos += STREAM_RECORD_SIZE;
+        }
+        buf.erase(buf.begin(), buf.begin() + pos);
+    }
+
+    if (serial)
+    {
+        uint8_t cmd = STREAM_CMD_STOP;
+        if (write(fd, &cmd, 1) != 1)
+            fprintf(stderr, "%s: could not stop the stream\n", input);
+    }
+    close(fd);
+
+    bool ok = true;
+    for (Track *t : { &raw, &fused })
+    {
+        if (t->csv)
+            ok &= fclose(t->csv) == 0;
+        else if (t->records)
+            ok &= WriteColumnar(*t, t == &raw ? rawPath : fusedPath);
+    }
+
+    fprintf(stderr, "bytes %llu, skipped %llu, crc errors %llu\n", (unsigned long long)bytesIn,
+            (unsigned long long)skipped, (unsigned long long)crcErrors);
+    for (const Track *t : { &raw, &fused })
+    {
+        if (!t->records)
+            continue;
+        fprintf(stderr, "%-5s records %llu, gaps %llu, missing %llu, restarts %llu, overruns %llu\n", t->name,
+                (unsigned long long)t->records, (unsigned long long)t->gaps, (unsigned long long)t->missing,
+                (unsigned long long)t->restarts, (unsigned long long)t->overruns);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+/*
+ * node_sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host simulation of one master driving 1 - NODE_MAX turrets over a shared
+ *  link, built from the firmware's NODE and LINK modules. Every sample tick
+ *  the master posts a two axis SERVO frame to each node and the broadcast
+ *  telemetry takes its share of the budget; each slave runs the real parser
+ *  with its address filter, and answers with an ACK if asked.
+ *  Prints the update rate per node and in total against the node count.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -I. -o node_sim node_sim.c ../../TurretMaster/NODE/NODE.c ../../TurretMaster/LINK/LINK.c
+ *      ./node_sim [baud] [ack 0/1] [ack loss %]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../TurretMaster/NODE/NODE.h"
+#include "../../TurretMaster/LOAD/LOAD.h"
+
+#define SIM_SAMPLE_HZ           150
+#define SIM_SECONDS             10
+#define SIM_BUDGET_PERCENT      80
+#define SIM_TELEMETRY_BYTES     12      // mean DELTA frame per sample
+#define SIM_WIRE_MAX            4096
+#define SIM_YAW_CHANNEL         8
+#define SIM_PITCH_CHANNEL       9
+
+// bytes the master put on the link during the current tick
+static uint8_t g_pui8Wire[SIM_WIRE_MAX];
+static uint32_t g_ui32WireLen;
+
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    (void)ui32Base;
+    if (g_ui32WireLen < SIM_WIRE_MAX)
+        g_pui8Wire[g_ui32WireLen++] = ucData;
+}
+
+// NODE only needs the decoder of LOAD, no STATUS frames are simulated
+bool LOAD_StatusDecode(const tLinkFrame *psFrame, uint32_t *pui32Load, uint32_t *pui32Peak)
+{
+    (void)psFrame;
+    *pui32Load = *pui32Peak = 0;
+    return false;
+}
+
+static void RunSim(uint32_t ui32Baud, uint32_t ui32Nodes, bool bAck, uint32_t ui32LossPercent)
+{
+    tLinkParser psSlaves[NODE_MAX];
+    uint32_t pui32Updates[NODE_MAX] = { 0 };
+    tLinkFrame psAcks[NODE_MAX];
+    bool pbAckPending[NODE_MAX] = { false };
+    uint32_t ui32Budget = ui32Baud / 10 / SIM_SAMPLE_HZ * SIM_BUDGET_PERCENT / 100;
+    uint32_t ui32Ticks = SIM_SAMPLE_HZ * SIM_SECONDS;
+    uint64_t ui64Bytes = 0;
+    uint32_t ui32Min = 0xFFFFFFFF, ui32Max = 0, ui32Total = 0;
+    uint32_t t, i, j;
+
+    NODE_Init(0);
+    for (i = 0; i < ui32Nodes; i++)
+    {
+        NODE_Add((uint8_t)(i + 1));
+        LINK_ParserInit(&psSlaves[i]);
+        LINK_ParserFilterSet(&psSlaves[i], (uint8_t)(i + 1), 0x01);
+    }
+
+    for (t = 0; t < ui32Ticks; t++)
+    {
+        uint32_t ui32Now = t * 1000 / SIM_SAMPLE_HZ;
+
+        // ACKs sent back during the last tick, the return direction has its own wire
+        for (i = 0; i < ui32Nodes; i++)
+        {
+            if (pbAckPending[i] && (uint32_t)(rand() % 100) >= ui32LossPercent)
+                NODE_HandleFrame(&psAcks[i], ui32Now);
+            pbAckPending[i] = false;
+        }
+
+        // a new target for every node, sweeping slowly
+        for (i = 0; i < ui32Nodes; i++)
+        {
+            uint8_t pui8Payload[2 + 2 * 5];
+            uint32_t ui32Len = 2;
+
+            pui8Payload[0] = (uint8_t)((1 << SIM_YAW_CHANNEL) | (1 << SIM_PITCH_CHANNEL));
+            pui8Payload[1] = (uint8_t)(((1 << SIM_YAW_CHANNEL) | (1 << SIM_PITCH_CHANNEL)) >> 8);
+            ui32Len += LINK_PutVarint(pui8Payload + ui32Len, 9000 + (int32_t)(t % 3000));
+            ui32Len += LINK_PutVarint(pui8Payload + ui32Len, 8000 - (int32_t)(t % 2000));
+            NODE_Post(i, LINK_TYPE_SERVO, pui8Payload, (uint8_t)ui32Len, bAck ? LINK_FLAG_ACK : 0);
+        }
+
+        g_ui32WireLen = 0;
+        NODE_Service(ui32Budget - SIM_TELEMETRY_BYTES, ui32Now);
+        ui64Bytes += g_ui32WireLen + SIM_TELEMETRY_BYTES;
+
+        // every slave sees every byte and keeps what is addressed to it
+        for (i = 0; i < ui32Nodes; i++)
+        {
+            for (j = 0; j < g_ui32WireLen; j++)
+            {
+                if (LINK_Parse(&psSlaves[i], g_pui8Wire[j]) != LINK_FRAME_READY)
+                    continue;
+                if (psSlaves[i].sFrame.ui8Type != LINK_TYPE_SERVO)
+                    continue;
+                pui32Updates[i]++;
+                if (psSlaves[i].sFrame.ui8Flags & LINK_FLAG_ACK)
+                {
+                    psAcks[i].ui8Type = LINK_TYPE_ACK;
+                    psAcks[i].ui8Len = 1;
+                    psAcks[i].pui8Payload[0] = psSlaves[i].sFrame.ui8Seq;
+                    psAcks[i].ui8Dst = LINK_ADDR_MASTER;
+                    psAcks[i].ui8Src = (uint8_t)(i + 1);
+                    psAcks[i].ui8Flags = LINK_FLAG_ADDRESSED;
+                    psAcks[i].ui8Seq = psSlaves[i].sFrame.ui8Seq;
+                    pbAckPending[i] = true;
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < ui32Nodes; i++)
+    {
+        uint32_t ui32Rate = pui32Updates[i] / SIM_SECONDS;
+
+        if (ui32Rate < ui32Min)
+            ui32Min = ui32Rate;
+        if (ui32Rate > ui32Max)
+            ui32Max = ui32Rate;
+        ui32Total += ui32Rate;
+    }
+    printf("%5u %10u %10u %12u %9.1f\n", ui32Nodes, ui32Min, ui32Max, ui32Total,
+           100.0 * ui64Bytes * 10 / ((double)ui32Baud * SIM_SECONDS));
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ui32Baud = argc > 1 ? (uint32_t)atoi(argv[1]) : 115200;
+    bool bAck = argc > 2 ? atoi(argv[2]) != 0 : false;
+    uint32_t ui32Loss = argc > 3 ? (uint32_t)atoi(argv[3]) : 0;
+    uint32_t i;
+
+    printf("baud %u, %u Hz samples, budget %u%%, ack %s, ack loss %u%%\n", ui32Baud, SIM_SAMPLE_HZ,
+           SIM_BUDGET_PERCENT, bAck ? "on" : "off", ui32Loss);
+    printf("nodes  min (Hz)  max (Hz)  total (Hz)  link (%%)\n");
+    for (i = 1; i <= NODE_MAX; i++)
+        RunSim(ui32Baud, i, bAck, ui32Loss);
+
+    return 0;
+}
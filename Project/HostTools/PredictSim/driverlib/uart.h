@@ -0,0 +1,17 @@
+/*
+ * uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Stand-in for the TivaWare UART driver when firmware modules are built on
+ *  the host, predict_sim.c provides the function.
+ */
+
+#ifndef DRIVERLIB_UART_H_
+#define DRIVERLIB_UART_H_
+
+#include <stdint.h>
+
+extern void UARTCharPut(uint32_t ui32Base, unsigned char ucData);
+
+#endif /* DRIVERLIB_UART_H_ */
@@ -0,0 +1,292 @@
+/*
+ * predict_sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host simulation of the turret axis from the master's gyro to the slave's
+ *  servo target, built from the firmware's TELEMETRY, LINK and PREDICT
+ *  modules with the turrets' settings. The master samples a moving axis at
+ *  150 Hz, the frames reach the slave in order after 20 - 50 ms, and the
+ *  slave commands its servo every 3 ms, either with the last value received
+ *  (the old step) or with PREDICT_Output().
+ *
+ *  Each scenario compares both against the true position: mean and max
+ *  error, the effective latency (the delay of the true motion that fits the
+ *  output best) and the largest jump between two servo updates. Tests, exits
+ *  with 1 on the first failure:
+ *      - the predictor at least halves the mean error and the latency of
+ *        the step on moving scenarios, and never leaves the servo limits;
+ *      - it does not jump further than the step does when a frame arrives;
+ *      - once the link is lost, the output stops within the horizon and
+ *        holds.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -Wall -I. -o predict_sim predict_sim.c ../../TurretMaster/TELEMETRY/TELEMETRY.c ../../TurretMaster/LINK/LINK.c ../../TurretSlave/PREDICT/PREDICT.c -lm
+ *      ./predict_sim [seed]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../TurretMaster/TELEMETRY/TELEMETRY.h"
+#include "../../TurretSlave/PREDICT/PREDICT.h"
+
+// Turret settings
+#define SIM_SAMPLE_HZ           150
+#define SIM_DEADBAND            1
+#define SIM_RATE_DEADBAND       20
+#define SIM_KEYFRAME_PERIOD     100
+#define SIM_SERVO_MS            3
+#define SIM_MIN_DEG             20
+#define SIM_MAX_DEG             140
+#define SIM_INIT_DEG            90
+
+#define SIM_LATENCY_MIN         20      // ms, frames stay in order
+#define SIM_LATENCY_SPAN        30
+#define SIM_LEAD_MS             35      // what SYNC measures for that link
+#define SIM_MS                  20000
+#define SIM_MAX_LAG             200     // ms searched for the effective latency
+#define SIM_FRAMES              4096
+#define SIM_FRAME_MAX           (LINK_OVERHEAD + 32)
+
+typedef struct
+{
+    const char *pcName;
+    double (*pfnPosition)(double dSeconds);
+    uint32_t ui32LinkLostMs;            // 0, or the time the link goes down for good
+} tSimScenario;
+
+typedef struct
+{
+    double dMean, dMax;
+    uint32_t ui32LagMs;
+    double dMaxJump;
+} tSimResult;
+
+// Frames in flight, with the time they reach the slave
+static uint8_t g_ppui8Frames[SIM_FRAMES][SIM_FRAME_MAX];
+static uint32_t g_pui32FrameLen[SIM_FRAMES];
+static uint32_t g_pui32Arrival[SIM_FRAMES];
+static uint32_t g_ui32Sent, g_ui32Delivered;
+static uint32_t g_ui32LastArrival;
+static bool g_bLinkUp;
+
+// True position and both outputs at every ms
+static double g_pdTruth[SIM_MS];
+static double g_pdStep[SIM_MS];
+static double g_pdPredict[SIM_MS];
+
+// The master's bytes go into the frame of the current sample
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    uint32_t ui32Slot = g_ui32Sent % SIM_FRAMES;
+
+    (void)ui32Base;
+    if (g_pui32FrameLen[ui32Slot] < SIM_FRAME_MAX)
+        g_ppui8Frames[ui32Slot][g_pui32FrameLen[ui32Slot]++] = ucData;
+}
+
+static double Sine(double dSeconds)
+{
+    return SIM_INIT_DEG + 50 * sin(2 * M_PI * dSeconds / 4);
+}
+
+// Slews at 40 deg/s between random targets, holding in between
+static double Slew(double dSeconds)
+{
+    static double dPos = SIM_INIT_DEG, dTarget = SIM_INIT_DEG, dLast = 0;
+    double dStep = (dSeconds - dLast) * 40;
+
+    dLast = dSeconds;
+    if (fabs(dTarget - dPos) <= dStep)
+    {
+        dPos = dTarget;
+        if (rand() % 500 == 0)
+            dTarget = SIM_MIN_DEG + 10 + rand() % (SIM_MAX_DEG - SIM_MIN_DEG - 20);
+    }
+    else
+        dPos += dTarget > dPos ? dStep : -dStep;
+    return dPos;
+}
+
+static double Hold(double dSeconds)
+{
+    (void)dSeconds;
+    return 60;
+}
+
+static const tSimScenario SCENARIOS[] = {
+    { "sine 50 deg, 4 s", Sine, 0 },
+    { "slews at 40 deg/s", Slew, 0 },
+    { "holding still", Hold, 0 },
+    { "sine, link lost at 10 s", Sine, 10000 },
+};
+
+static void Deliver(uint32_t ui32Now, tLinkParser *psParser, tTelemetryReceiver *psRx, tPredictAxis *psAxis,
+                    double *pdStep)
+{
+    while (g_ui32Delivered < g_ui32Sent && g_pui32Arrival[g_ui32Delivered % SIM_FRAMES] <= ui32Now)
+    {
+        uint32_t ui32Slot = g_ui32Delivered++ % SIM_FRAMES;
+        uint32_t i;
+
+        for (i = 0; i < g_pui32FrameLen[ui32Slot]; i++)
+        {
+            if (LINK_Parse(psParser, g_ppui8Frames[ui32Slot][i]) != LINK_FRAME_READY)
+                continue;
+            // the yaw axis, as the slave's LinkTask does it
+            if (TELEMETRY_Receive(psRx, &psParser->sFrame) & TELEMETRY_AXIS_YAW)
+            {
+                *pdStep = psRx->i32Yaw;
+                PREDICT_Update(psAxis, psRx->i32Yaw * 100, psRx->i32YawRate, ui32Now);
+            }
+        }
+    }
+}
+
+static double MeanError(const double *pdOutput, uint32_t ui32Lag, uint32_t ui32From, uint32_t ui32To)
+{
+    double dSum = 0;
+    uint32_t t, n = 0;
+
+    for (t = ui32From; t < ui32To; t += SIM_SERVO_MS, n++)
+        dSum += fabs(pdOutput[t] - g_pdTruth[t - ui32Lag]);
+    return dSum / n;
+}
+
+static void Evaluate(const double *pdOutput, uint32_t ui32To, tSimResult *psResult)
+{
+    uint32_t ui32From = 1000, t, ui32Lag;
+    double dBest = 1e9, dError;
+
+    psResult->dMean = MeanError(pdOutput, 0, ui32From, ui32To);
+    psResult->dMax = psResult->dMaxJump = 0;
+    for (t = ui32From; t < ui32To; t += SIM_SERVO_MS)
+    {
+        if (fabs(pdOutput[t] - g_pdTruth[t]) > psResult->dMax)
+            psResult->dMax = fabs(pdOutput[t] - g_pdTruth[t]);
+        if (fabs(pdOutput[t] - pdOutput[t - SIM_SERVO_MS]) > psResult->dMaxJump)
+            psResult->dMaxJump = fabs(pdOutput[t] - pdOutput[t - SIM_SERVO_MS]);
+    }
+
+    psResult->ui32LagMs = 0;
+    for (ui32Lag = 0; ui32Lag <= SIM_MAX_LAG; ui32Lag++)
+    {
+        dError = MeanError(pdOutput, ui32Lag, ui32From, ui32To);
+        if (dError < dBest)
+        {
+            dBest = dError;
+            psResult->ui32LagMs = ui32Lag;
+        }
+    }
+}
+
+static bool Fail(const char *pcScenario, const char *pcTest)
+{
+    printf("%s: %s\n", pcScenario, pcTest);
+    return false;
+}
+
+static bool RunScenario(const tSimScenario *psScenario)
+{
+    tLinkParser sParser;
+    tTelemetryReceiver sRx;
+    tPredictAxis sAxis;
+    tSimResult sStep, sPredict;
+    double dStep = SIM_INIT_DEG, dPrevious = psScenario->pfnPosition(0);
+    uint32_t ui32End = psScenario->ui32LinkLostMs ? psScenario->ui32LinkLostMs : SIM_MS;
+    uint32_t ui32Samples = 0, t, i;
+    int32_t i32Output = 0;
+
+    LINK_ParserInit(&sParser);
+    TELEMETRY_ReceiverInit(&sRx);
+    TELEMETRY_Init(0, SIM_DEADBAND, SIM_RATE_DEADBAND, SIM_KEYFRAME_PERIOD);
+    PREDICT_Init(&sAxis, SIM_MIN_DEG * 100, SIM_MAX_DEG * 100, SIM_INIT_DEG * 100, SIM_LEAD_MS);
+    g_ui32Sent = g_ui32Delivered = g_ui32LastArrival = 0;
+    g_bLinkUp = true;
+
+    for (t = 0; t < SIM_MS; t++)
+    {
+        g_pdTruth[t] = psScenario->pfnPosition(t / 1000.0);
+
+        // the master samples, whole degrees and a noisy gyro
+        if (t * SIM_SAMPLE_HZ / 1000 >= ui32Samples)
+        {
+            double dRate = (g_pdTruth[t] - dPrevious) * SIM_SAMPLE_HZ;
+            uint32_t ui32Slot = g_ui32Sent % SIM_FRAMES;
+
+            dPrevious = g_pdTruth[t];
+            ui32Samples++;
+            g_bLinkUp = !psScenario->ui32LinkLostMs || t < psScenario->ui32LinkLostMs;
+            g_pui32FrameLen[ui32Slot] = 0;
+            TELEMETRY_Update((int32_t)lround(g_pdTruth[t]), 0, (int32_t)lround(dRate * 10) + rand() % 9 - 4, 0,
+                             (uint16_t)t);
+            if (g_pui32FrameLen[ui32Slot] && g_bLinkUp)
+            {
+                uint32_t ui32Arrival = t + SIM_LATENCY_MIN + rand() % SIM_LATENCY_SPAN;
+
+                // in order: a late frame holds up the ones behind it, which then come in a burst
+                if (ui32Arrival < g_ui32LastArrival)
+                    ui32Arrival = g_ui32LastArrival;
+                g_pui32Arrival[ui32Slot] = g_ui32LastArrival = ui32Arrival;
+                g_ui32Sent++;
+            }
+        }
+
+        Deliver(t, &sParser, &sRx, &sAxis, &dStep);
+
+        // the servo timer
+        if (t % SIM_SERVO_MS == 0)
+        {
+            i32Output = PREDICT_Output(&sAxis, t);
+            if (i32Output < SIM_MIN_DEG * 1000 || i32Output > SIM_MAX_DEG * 1000)
+                return Fail(psScenario->pcName, "output outside the servo limits");
+        }
+        g_pdStep[t] = dStep;
+        g_pdPredict[t] = i32Output / 1000.0;
+    }
+
+    Evaluate(g_pdStep, ui32End, &sStep);
+    Evaluate(g_pdPredict, ui32End, &sPredict);
+    printf("%-26s %5.2f %5.2f %4u %5.2f   %5.2f %5.2f %4u %5.2f   %5u %5u\n", psScenario->pcName, sStep.dMean,
+           sStep.dMax, sStep.ui32LagMs, sStep.dMaxJump, sPredict.dMean, sPredict.dMax, sPredict.ui32LagMs,
+           sPredict.dMaxJump, PREDICT_ErrorMean(&sAxis), sAxis.ui32ErrorMax);
+
+    if (sPredict.dMaxJump > sStep.dMaxJump + 0.5)
+        return Fail(psScenario->pcName, "the predictor jumps further than the step");
+    if (psScenario->pfnPosition != Hold && sPredict.dMean * 2 > sStep.dMean)
+        return Fail(psScenario->pcName, "mean error not halved");
+    if (psScenario->pfnPosition != Hold && sPredict.ui32LagMs * 2 > sStep.ui32LagMs)
+        return Fail(psScenario->pcName, "latency not halved");
+    if (psScenario->pfnPosition == Hold && sPredict.dMax > SIM_DEADBAND)
+        return Fail(psScenario->pcName, "drifts while holding still");
+
+    if (psScenario->ui32LinkLostMs)
+    {
+        // frames in flight, the blend and the horizon, then nothing may move
+        i = g_ui32LastArrival + PREDICT_BLEND_MS + PREDICT_HORIZON_MS;
+        for (t = i; t < SIM_MS; t++)
+        {
+            if (g_pdPredict[t] != g_pdPredict[i])
+                return Fail(psScenario->pcName, "still moving after the horizon");
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t i;
+
+    srand(argc > 1 ? (unsigned)atoi(argv[1]) : 1);
+    printf("                           step                       predict                   update error\n");
+    printf("                           mean   max  lag  jump      mean   max  lag  jump    mean   max\n");
+    printf("                           (deg) (deg) (ms) (deg)     (deg) (deg) (ms) (deg)   (mdeg)\n");
+    for (i = 0; i < sizeof(SCENARIOS) / sizeof(SCENARIOS[0]); i++)
+    {
+        if (!RunScenario(&SCENARIOS[i]))
+            return 1;
+    }
+    printf("all scenarios pass\n");
+    return 0;
+}
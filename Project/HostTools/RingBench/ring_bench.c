@@ -0,0 +1,337 @@
+/*
+ * ring_bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host check of the RING module. The stress test runs a producer and a
+ *  consumer thread on one small ring, each switching at random between
+ *  single bytes, blocks and spans, and checks that the consumer sees the
+ *  producer's byte sequence without a gap or a repeat. The benchmark then
+ *  moves a fixed amount of data through a ring with each access style, and
+ *  through a copy of the old lab_5 queue (modulo index, shared count) for
+ *  comparison. Exits with 1 on the first error.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -Wall -pthread -o ring_bench ring_bench.c
+ *      ./ring_bench [megabytes]
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../TurretSlave/RING/RING.h"
+
+#define STRESS_SIZE         64          // small, so the indices wrap often
+#define STRESS_BYTES        (16u << 20)
+#define BENCH_SIZE          1024
+#define BENCH_BLOCK         64
+#define QUEUE_SIZE          100
+
+static tRing g_sRing;
+static uint8_t g_pui8Buffer[BENCH_SIZE];
+static uint32_t g_ui32Bytes;
+static volatile uint32_t g_ui32Sink;
+static volatile bool g_bFailed;             // the consumer stopped, the producer must not wait for it
+
+// Both threads pick the access style from their own generator
+static uint32_t Random(uint32_t *pui32State)
+{
+    *pui32State ^= *pui32State << 13;
+    *pui32State ^= *pui32State >> 17;
+    *pui32State ^= *pui32State << 5;
+    return *pui32State;
+}
+
+static double Seconds(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return sNow.tv_sec + sNow.tv_nsec * 1e-9;
+}
+
+/*
+ * Stress test: the byte at stream position n is (uint8_t)(n * 7 + n / 256),
+ * so a lost, repeated or reordered byte changes the sequence
+ */
+static uint8_t Expected(uint32_t ui32Pos)
+{
+    return (uint8_t)(ui32Pos * 7 + ui32Pos / 256);
+}
+
+static void *StressProducer(void *pvArg)
+{
+    uint8_t pui8Block[STRESS_SIZE];
+    uint32_t ui32State = 0x12345678, ui32Pos = 0, ui32Len, i;
+    uint8_t *pui8Span;
+
+    (void)pvArg;
+    while (ui32Pos < STRESS_BYTES && !g_bFailed)
+    {
+        if (!RING_Free(&g_sRing))
+            sched_yield();      // a spinning thread would hold a single core
+        switch (Random(&ui32State) % 3)
+        {
+        case 0:
+            if (RING_Push(&g_sRing, Expected(ui32Pos)))
+                ui32Pos++;
+            break;
+        case 1:
+            ui32Len = Random(&ui32State) % STRESS_SIZE + 1;
+            if (ui32Len > STRESS_BYTES - ui32Pos)
+                ui32Len = STRESS_BYTES - ui32Pos;
+            for (i = 0; i < ui32Len; i++)
+                pui8Block[i] = Expected(ui32Pos + i);
+            ui32Pos += RING_PushN(&g_sRing, pui8Block, ui32Len);
+            break;
+        default:
+            ui32Len = RING_WriteSpan(&g_sRing, &pui8Span);
+            if (ui32Len > STRESS_BYTES - ui32Pos)
+                ui32Len = STRESS_BYTES - ui32Pos;
+            ui32Len = ui32Len ? Random(&ui32State) % ui32Len + 1 : 0;
+            for (i = 0; i < ui32Len; i++)
+                pui8Span[i] = Expected(ui32Pos + i);
+            RING_WriteCommit(&g_sRing, ui32Len);
+            ui32Pos += ui32Len;
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void *StressConsumer(void *pvArg)
+{
+    uint8_t pui8Block[STRESS_SIZE], ui8Byte;
+    uint32_t ui32State = 0x9abcdef0, ui32Pos = 0, ui32Len, i;
+    const uint8_t *pui8Span;
+
+    (void)pvArg;
+    while (ui32Pos < STRESS_BYTES)
+    {
+        if (RING_Empty(&g_sRing))
+            sched_yield();
+        switch (Random(&ui32State) % 3)
+        {
+        case 0:
+            if (!RING_Pop(&g_sRing, &ui8Byte))
+                break;
+            if (ui8Byte != Expected(ui32Pos))
+                return (void *)(uintptr_t)(ui32Pos + 1);
+            ui32Pos++;
+            break;
+        case 1:
+            ui32Len = RING_PopN(&g_sRing, pui8Block, Random(&ui32State) % STRESS_SIZE + 1);
+            for (i = 0; i < ui32Len; i++, ui32Pos++)
+                if (pui8Block[i] != Expected(ui32Pos))
+                    return (void *)(uintptr_t)(ui32Pos + 1);
+            break;
+        default:
+            ui32Len = RING_ReadSpan(&g_sRing, &pui8Span);
+            ui32Len = ui32Len ? Random(&ui32State) % ui32Len + 1 : 0;
+            for (i = 0; i < ui32Len; i++, ui32Pos++)
+                if (pui8Span[i] != Expected(ui32Pos))
+                    return (void *)(uintptr_t)(ui32Pos + 1);
+            RING_ReadCommit(&g_sRing, ui32Len);
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void *StressCheck(void *pvArg)
+{
+    void *pvResult = StressConsumer(pvArg);
+
+    g_bFailed = pvResult != NULL;
+    return pvResult;
+}
+
+static void Stress(void)
+{
+    pthread_t sProducer, sConsumer;
+    void *pvResult;
+    double dStart = Seconds();
+
+    RING_Init(&g_sRing, g_pui8Buffer, STRESS_SIZE);
+    pthread_create(&sConsumer, NULL, StressCheck, NULL);
+    pthread_create(&sProducer, NULL, StressProducer, NULL);
+    pthread_join(sProducer, NULL);
+    pthread_join(sConsumer, &pvResult);
+
+    if (pvResult)
+    {
+        printf("stress: byte %lu out of sequence\n", (unsigned long)(uintptr_t)pvResult - 1);
+        exit(1);
+    }
+    if (!RING_Empty(&g_sRing))
+    {
+        printf("stress: %u bytes left over\n", RING_Count(&g_sRing));
+        exit(1);
+    }
+    printf("stress: %u MB in sequence through a %u byte ring, %.2f s\n",
+           STRESS_BYTES >> 20, STRESS_SIZE, Seconds() - dStart);
+}
+
+/*
+ * Benchmarks: a producer and a consumer thread per access style
+ */
+typedef enum { BENCH_SINGLE, BENCH_BLOCKS, BENCH_SPANS } tBenchMode;
+
+static void *BenchProducer(void *pvArg)
+{
+    tBenchMode eMode = *(tBenchMode *)pvArg;
+    uint8_t pui8Block[BENCH_BLOCK] = { 0 }, *pui8Span;
+    uint32_t ui32Pos = 0, ui32Len;
+
+    while (ui32Pos < g_ui32Bytes)
+    {
+        if (!RING_Free(&g_sRing))
+            sched_yield();
+        if (eMode == BENCH_SINGLE)
+            ui32Pos += RING_Push(&g_sRing, (uint8_t)ui32Pos);
+        else if (eMode == BENCH_BLOCKS)
+            ui32Pos += RING_PushN(&g_sRing, pui8Block, BENCH_BLOCK);
+        else
+        {
+            ui32Len = RING_WriteSpan(&g_sRing, &pui8Span);
+            memset(pui8Span, (uint8_t)ui32Pos, ui32Len);
+            RING_WriteCommit(&g_sRing, ui32Len);
+            ui32Pos += ui32Len;
+        }
+    }
+    return NULL;
+}
+
+static void *BenchConsumer(void *pvArg)
+{
+    tBenchMode eMode = *(tBenchMode *)pvArg;
+    uint8_t pui8Block[BENCH_BLOCK], ui8Byte;
+    const uint8_t *pui8Span;
+    uint32_t ui32Pos = 0, ui32Sum = 0, ui32Len, i;
+
+    while (ui32Pos < g_ui32Bytes)
+    {
+        if (RING_Empty(&g_sRing))
+            sched_yield();
+        if (eMode == BENCH_SINGLE)
+        {
+            if (RING_Pop(&g_sRing, &ui8Byte))
+            {
+                ui32Sum += ui8Byte;
+                ui32Pos++;
+            }
+        }
+        else if (eMode == BENCH_BLOCKS)
+        {
+            ui32Len = RING_PopN(&g_sRing, pui8Block, BENCH_BLOCK);
+            ui32Sum += ui32Len ? pui8Block[0] : 0;
+            ui32Pos += ui32Len;
+        }
+        else
+        {
+            ui32Len = RING_ReadSpan(&g_sRing, &pui8Span);
+            for (i = 0; i < ui32Len; i += BENCH_BLOCK)
+                ui32Sum += pui8Span[i];
+            RING_ReadCommit(&g_sRing, ui32Len);
+            ui32Pos += ui32Len;
+        }
+    }
+    g_ui32Sink = ui32Sum;
+    return NULL;
+}
+
+static void Bench(const char *pcName, tBenchMode eMode)
+{
+    pthread_t sProducer, sConsumer;
+    double dStart = Seconds(), dTime;
+
+    RING_Init(&g_sRing, g_pui8Buffer, BENCH_SIZE);
+    pthread_create(&sConsumer, NULL, BenchConsumer, &eMode);
+    pthread_create(&sProducer, NULL, BenchProducer, &eMode);
+    pthread_join(sProducer, NULL);
+    pthread_join(sConsumer, NULL);
+    dTime = Seconds() - dStart;
+
+    printf("%-28s %9.1f MB/s\n", pcName, g_ui32Bytes / dTime / 1e6);
+}
+
+/*
+ * The queue lab_5 had before, single threaded: enqueue and dequeue a block
+ */
+typedef struct
+{
+    char data[QUEUE_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t count;
+} Queue;
+
+static int Q_Enequeue(Queue *q, char data)
+{
+    if (q->count == QUEUE_SIZE)
+        return -1;
+    q->data[q->tail] = data;
+    q->tail = (q->tail + 1) % QUEUE_SIZE;
+    q->count++;
+    return 0;
+}
+
+static char Q_Dequeue(Queue *q)
+{
+    char data;
+
+    if (q->count == 0)
+        return 0;
+    data = q->data[q->head];
+    q->head = (q->head + 1) % QUEUE_SIZE;
+    q->count--;
+    return data;
+}
+
+static void BenchSingleThread(void)
+{
+    static volatile uint32_t ui32Size = QUEUE_SIZE;     // a run time divisor, as for a non constant size
+    Queue sQueue = { { 0 }, 0, 0, 0 };
+    uint8_t ui8Byte = 0;
+    uint32_t ui32Pos, ui32Sum = 0, i;
+    double dStart;
+
+    dStart = Seconds();
+    for (ui32Pos = 0; ui32Pos < g_ui32Bytes; ui32Pos += ui32Size / 2)
+    {
+        for (i = 0; i < ui32Size / 2; i++)
+            Q_Enequeue(&sQueue, (char)i);
+        for (i = 0; i < ui32Size / 2; i++)
+            ui32Sum += Q_Dequeue(&sQueue);
+    }
+    printf("%-28s %9.1f MB/s\n", "old queue, one thread", g_ui32Bytes / (Seconds() - dStart) / 1e6);
+
+    RING_Init(&g_sRing, g_pui8Buffer, 64);
+    dStart = Seconds();
+    for (ui32Pos = 0; ui32Pos < g_ui32Bytes; ui32Pos += 50)
+    {
+        for (i = 0; i < 50; i++)
+            RING_Push(&g_sRing, (uint8_t)i);
+        for (i = 0; i < 50; i++)
+        {
+            RING_Pop(&g_sRing, &ui8Byte);
+            ui32Sum += ui8Byte;
+        }
+    }
+    printf("%-28s %9.1f MB/s\n", "ring bytes, one thread", g_ui32Bytes / (Seconds() - dStart) / 1e6);
+    g_ui32Sink = ui32Sum;
+}
+
+int main(int argc, char **argv)
+{
+    g_ui32Bytes = (argc > 1 ? (uint32_t)atoi(argv[1]) : 256) << 20;
+
+    Stress();
+    BenchSingleThread();
+    Bench("ring bytes, two threads", BENCH_SINGLE);
+    Bench("ring blocks, two threads", BENCH_BLOCKS);
+    Bench("ring spans, two threads", BENCH_SPANS);
+    return 0;
+}
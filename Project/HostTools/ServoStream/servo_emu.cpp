@@ -0,0 +1,183 @@
+/*
+ * servo_emu.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host stand-in for the UART0 console of ControlServo / TurretSlave on a PTY,
+ *  to try servo_stream without a board. Follows the firmware's line handling:
+ *  echo in terminal mode, "m1"/"m0" to switch machine mode, commands batched
+ *  with ';', "k\n"/"e\n" answers in machine mode, yaw and pitch limits as the
+ *  slave's default calibration. Bytes are delayed by their time on a wire at
+ *  the given baud rate, and each line by the given processing time.
+ *
+ *  Build and run from this directory:
+ *      g++ -std=c++17 -O2 -Wall -o servo_emu servo_emu.cpp
+ *      ./servo_emu [baud] [us per line]       prints the PTY to connect to
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+
+#define EMU_YAW_MIN     20
+#define EMU_YAW_MAX     140
+#define EMU_PITCH_MIN   45
+#define EMU_PITCH_MAX   110
+
+static volatile sig_atomic_t g_bStop = 0;
+
+static void OnSignal(int)
+{
+    g_bStop = 1;
+}
+
+struct Emulator
+{
+    int fd;
+    unsigned baud;
+    unsigned lineUs;
+    bool machineMode = false;
+    std::string line;
+    unsigned long lines = 0, ok = 0, rejected = 0;
+    int yaw = 90, pitch = 60;
+
+    void Put(const char *s)
+    {
+        size_t len = strlen(s);
+        usleep((useconds_t)(len * 10 * 1000000ull / baud));
+        if (write(fd, s, len) != (ssize_t)len)
+            g_bStop = 1;
+    }
+
+    bool Command(const std::string &cmd)
+    {
+        int value = atoi(cmd.c_str() + 1);
+
+        if (cmd.empty())
+            return false;
+        switch (cmd[0])
+        {
+        case 'y': case 'Y':
+            if (value < EMU_YAW_MIN || value > EMU_YAW_MAX)
+                return false;
+            yaw = value;
+            return true;
+        case 'p': case 'P':
+            if (value < EMU_PITCH_MIN || value > EMU_PITCH_MAX)
+                return false;
+            pitch = value;
+            return true;
+        case 'c': case 'C': case 's': case 'S':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool Line(const std::string &text)
+    {
+        if (!text.empty() && (text[0] == 'm' || text[0] == 'M'))
+        {
+            machineMode = text.size() > 1 && text[1] == '1';
+            return true;
+        }
+
+        bool result = true;
+        size_t start = 0;
+        for (;;)
+        {
+            size_t end = text.find(';', start);
+            result &= Command(text.substr(start, end - start));
+            if (end == std::string::npos)
+                break;
+            start = end + 1;
+        }
+        return result;
+    }
+
+    void Byte(char c)
+    {
+        if (c != '\n' && c != '\r')
+        {
+            if (!machineMode)
+            {
+                char echo[2] = { c, 0 };
+                Put(echo);
+            }
+            if (line.size() < 99)
+                line += c;
+            return;
+        }
+
+        bool wasMachine = machineMode;
+        if (!wasMachine)
+            Put("\n\r");
+        else if (line.empty())
+            return;
+
+        usleep(lineUs);
+        bool result = Line(line);
+        line.clear();
+        lines++;
+        (result ? ok : rejected)++;
+        if (wasMachine || machineMode)
+            Put(result ? "k\n" : "e\n");
+    }
+};
+
+int main(int argc, char **argv)
+{
+    unsigned baud = argc > 1 ? atoi(argv[1]) : 115200;
+    unsigned lineUs = argc > 2 ? atoi(argv[2]) : 20;
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) || unlockpt(master) || baud == 0)
+    {
+        perror("pty");
+        return 1;
+    }
+
+    // keep the other side open and raw, so clients come and go without a hangup
+    const char *name = ptsname(master);
+    int slave = open(name, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    printf("%s\n", name);
+    fflush(stdout);
+
+    // no restart, a signal ends the blocking read
+    struct sigaction sa = {};
+    sa.sa_handler = OnSignal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    Emulator emu;
+    emu.fd = master;
+    emu.baud = baud;
+    emu.lineUs = lineUs;
+    char buf[256];
+    while (!g_bStop)
+    {
+        ssize_t n = read(master, buf, sizeof(buf));
+        if (n <= 0)
+            break;
+        // time on the wire, the receive side of the UART
+        usleep((useconds_t)(n * 10 * 1000000ull / baud));
+        for (ssize_t i = 0; i < n; i++)
+            emu.Byte(buf[i]);
+    }
+
+    fprintf(stderr, "lines %lu, ok %lu, rejected %lu, yaw %d, pitch %d\n", emu.lines, emu.ok, emu.rejected,
+            emu.yaw, emu.pitch);
+    close(slave);
+    close(master);
+    return 0;
+}
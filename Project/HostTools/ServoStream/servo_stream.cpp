@@ -0,0 +1,415 @@
+/*
+ * servo_stream.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Streams servo trajectories to ControlServo or TurretSlave over their UART0
+ *  console, in the machine mode of the firmware: "m1" switches echo off, and
+ *  every line is answered with "k\n" (applied) or "e\n" (rejected). One line
+ *  per sample, "y<deg>;p<deg>", so both axes move in the same PWM frame.
+ *
+ *  Samples come from a file ("<yaw> <pitch>" in degrees per line, '#' starts a
+ *  comment) or from a generator around the servo centers. They are paced at a
+ *  fixed rate, written in batches of several lines per write, and at most a
+ *  window of lines waits for its answer; the answers are matched in order.
+ *  Prints the throughput reached and the latency from write to answer.
+ *
+ *  Works with a serial device or a PTY, e.g. the one servo_emu creates.
+ *  Build and run from this directory:
+ *      g++ -std=c++17 -O2 -Wall -o servo_stream servo_stream.cpp
+ *      ./servo_stream /dev/ttyACM0 -r 200 -n 4 -g sine -s 10
+ *      ./servo_stream /dev/ttyACM0 -f path.txt
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#define STREAM_CENTER_YAW       90
+#define STREAM_CENTER_PITCH     60
+#define STREAM_REPLY_TIMEOUT_MS 1000
+
+struct Sample
+{
+    int yaw;
+    int pitch;
+};
+
+struct Options
+{
+    const char *device = nullptr;
+    unsigned baud = 115200;
+    double rate = 100;          // samples per second
+    unsigned batch = 1;         // lines per write
+    unsigned window = 16;       // lines waiting for their answer
+    double seconds = 10;        // generator length
+    const char *file = nullptr;
+    std::string generator = "sine";
+    double amplitude = 30;      // degrees
+    double period = 2;          // seconds
+};
+
+static double NowMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static speed_t BaudFlag(unsigned baud)
+{
+    switch (baud)
+    {
+    case 9600: return B9600;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return 0;
+    }
+}
+
+static int OpenPort(const char *path, unsigned baud)
+{
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+        return -1;
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0)
+        return -1;
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, BaudFlag(baud));
+    cfsetospeed(&tio, BaudFlag(baud));
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if (tcsetattr(fd, TCSANOW, &tio) != 0)
+        return -1;
+    tcflush(fd, TCIOFLUSH);
+    return fd;
+}
+
+static bool LoadFile(const char *path, std::vector<Sample> &samples)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        double yaw, pitch;
+        char *hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+        if (sscanf(line, "%lf %lf", &yaw, &pitch) == 2)
+            samples.push_back({ (int)lround(yaw), (int)lround(pitch) });
+    }
+    fclose(f);
+    return true;
+}
+
+/*
+ * sine: both axes, pitch a quarter period behind; sweep: triangle on yaw;
+ * step: square wave on both axes, the worst case for the servos
+ */
+static bool Generate(const Options &o, std::vector<Sample> &samples)
+{
+    unsigned count = (unsigned)(o.seconds * o.rate);
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        double t = i / o.rate;
+        double phase = fmod(t / o.period, 1.0);
+        double yaw, pitch;
+
+        if (o.generator == "sine")
+        {
+            yaw = o.amplitude * sin(2 * M_PI * phase);
+            pitch = o.amplitude / 2 * cos(2 * M_PI * phase);
+        }
+        else if (o.generator == "sweep")
+        {
+            yaw = o.amplitude * (phase < 0.5 ? 4 * phase - 1 : 3 - 4 * phase);
+            pitch = 0;
+        }
+        else if (o.generator == "step")
+        {
+            yaw = phase < 0.5 ? -o.amplitude : o.amplitude;
+            pitch = phase < 0.5 ? -o.amplitude / 2 : o.amplitude / 2;
+        }
+        else
+            return false;
+        samples.push_back({ STREAM_CENTER_YAW + (int)lround(yaw), STREAM_CENTER_PITCH + (int)lround(pitch) });
+    }
+    return true;
+}
+
+/*
+ * Answers of the firmware, matched against the lines in flight
+ */
+struct Replies
+{
+    std::string partial;
+    std::deque<double> inFlight;    // write time of every unanswered line
+    std::vector<double> latencies;  // ms
+    unsigned ok = 0, rejected = 0;
+
+    // returns the number of "k"/"e" answers found
+    unsigned Read(int fd)
+    {
+        char buf[512];
+        unsigned answers = 0;
+        ssize_t n;
+
+        while ((n = read(fd, buf, sizeof(buf))) > 0)
+        {
+            double now = NowMs();
+            for (ssize_t i = 0; i < n; i++)
+            {
+                if (buf[i] != '\n')
+                {
+                    if (buf[i] != '\r')
+                        partial += buf[i];
+                    continue;
+                }
+                // anything else is terminal output (echo, statistics)
+                if (partial == "k" || partial == "e")
+                {
+                    (partial == "k" ? ok : rejected)++;
+                    answers++;
+                    if (!inFlight.empty())
+                    {
+                        latencies.push_back(now - inFlight.front());
+                        inFlight.pop_front();
+                    }
+                }
+                partial.clear();
+            }
+        }
+        return answers;
+    }
+
+    bool Wait(int fd, unsigned count, double timeoutMs)
+    {
+        double end = NowMs() + timeoutMs;
+        unsigned got = 0;
+
+        while (got < count)
+        {
+            double left = end - NowMs();
+            if (left <= 0)
+                return false;
+            struct pollfd p = { fd, POLLIN, 0 };
+            poll(&p, 1, (int)ceil(left));
+            got += Read(fd);
+        }
+        return true;
+    }
+};
+
+static bool WriteAll(int fd, const std::string &s)
+{
+    size_t done = 0;
+
+    while (done < s.size())
+    {
+        ssize_t n = write(fd, s.data() + done, s.size() - done);
+        if (n < 0 && errno == EAGAIN)
+        {
+            struct pollfd p = { fd, POLLOUT, 0 };
+            poll(&p, 1, 100);
+            continue;
+        }
+        if (n < 0)
+            return false;
+        done += n;
+    }
+    return true;
+}
+
+static double Percentile(std::vector<double> sorted, double percent)
+{
+    if (sorted.empty())
+        return 0;
+    std::sort(sorted.begin(), sorted.end());
+    size_t index = (size_t)ceil(sorted.size() * percent / 100.0);
+    return sorted[index ? index - 1 : 0];
+}
+
+static void Usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s <serial port | pty> [options]\n"
+            "  -b baud       serial rate (default 115200)\n"
+            "  -r rate       samples per second (default 100)\n"
+            "  -n batch      lines per write (default 1)\n"
+            "  -w window     lines waiting for an answer at most (default 16)\n"
+            "  -f file       \"<yaw> <pitch>\" per line, in degrees\n"
+            "  -g generator  sine, sweep or step (default sine)\n"
+            "  -s seconds    generator length (default 10)\n"
+            "  -a degrees    generator amplitude (default 30)\n"
+            "  -p seconds    generator period (default 2)\n",
+            argv0);
+}
+
+int main(int argc, char **argv)
+{
+    Options o;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *val = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg[0] != '-' && !o.device)
+        {
+            o.device = arg;
+            continue;
+        }
+        if (!val || arg[0] != '-' || strlen(arg) != 2)
+        {
+            Usage(argv[0]);
+            return 2;
+        }
+        i++;
+        switch (arg[1])
+        {
+        case 'b': o.baud = atoi(val); break;
+        case 'r': o.rate = atof(val); break;
+        case 'n': o.batch = atoi(val); break;
+        case 'w': o.window = atoi(val); break;
+        case 'f': o.file = val; break;
+        case 'g': o.generator = val; break;
+        case 's': o.seconds = atof(val); break;
+        case 'a': o.amplitude = atof(val); break;
+        case 'p': o.period = atof(val); break;
+        default:
+            Usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!o.device || !BaudFlag(o.baud) || o.rate <= 0 || o.batch == 0 || o.window < o.batch)
+    {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Sample> samples;
+    if (o.file ? !LoadFile(o.file, samples) : !Generate(o, samples))
+    {
+        fprintf(stderr, "no samples from %s\n", o.file ? o.file : o.generator.c_str());
+        return 1;
+    }
+
+    int fd = OpenPort(o.device, o.baud);
+    if (fd < 0)
+    {
+        fprintf(stderr, "%s: %s\n", o.device, strerror(errno));
+        return 1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // end a half typed line, then machine mode
+    Replies replies;
+    WriteAll(fd, "\rm1\r");
+    if (!replies.Wait(fd, 1, STREAM_REPLY_TIMEOUT_MS))
+    {
+        fprintf(stderr, "%s: no answer to m1, is the firmware running?\n", o.device);
+        return 1;
+    }
+    // an unfinished line may have been answered too, let it arrive before counting
+    usleep(50000);
+    replies.Read(fd);
+    replies.ok = replies.rejected = 0;
+    replies.latencies.clear();
+
+    double batchMs = 1000.0 * o.batch / o.rate;
+    double start = NowMs();
+    double next = start;
+    double lateMax = 0;
+    unsigned stalls = 0;
+    size_t sent = 0;
+    bool stalled = false;
+
+    while (sent < samples.size())
+    {
+        double now = NowMs();
+        struct pollfd p = { fd, POLLIN, 0 };
+
+        poll(&p, 1, now < next ? (int)ceil(next - now) : 0);
+        replies.Read(fd);
+
+        now = NowMs();
+        if (now < next)
+            continue;
+        // the firmware is behind, hold the batch until the window has room
+        if (replies.inFlight.size() + o.batch > o.window)
+        {
+            if (!stalled)
+                stalls++;
+            stalled = true;
+            struct pollfd q = { fd, POLLIN, 0 };
+            poll(&q, 1, 1);
+            continue;
+        }
+        stalled = false;
+        lateMax = std::max(lateMax, now - next);
+
+        std::string lines;
+        size_t count = std::min<size_t>(o.batch, samples.size() - sent);
+        for (size_t i = 0; i < count; i++)
+        {
+            char line[32];
+            snprintf(line, sizeof(line), "y%d;p%d\r", samples[sent + i].yaw, samples[sent + i].pitch);
+            lines += line;
+        }
+        if (!WriteAll(fd, lines))
+        {
+            fprintf(stderr, "%s: %s\n", o.device, strerror(errno));
+            return 1;
+        }
+        double written = NowMs();
+        for (size_t i = 0; i < count; i++)
+            replies.inFlight.push_back(written);
+        sent += count;
+        next += batchMs;
+    }
+    double sendEnd = NowMs();
+
+    bool complete = replies.Wait(fd, replies.inFlight.size(), STREAM_REPLY_TIMEOUT_MS);
+    double end = NowMs();
+    unsigned missing = replies.inFlight.size();
+
+    unsigned ok = replies.ok, rejected = replies.rejected;
+
+    replies.inFlight.clear();
+    WriteAll(fd, "m0\r");
+    replies.Wait(fd, 1, STREAM_REPLY_TIMEOUT_MS);
+    close(fd);
+
+    double seconds = (end - start) / 1000;
+    printf("samples %zu in %.2f s: %.1f/s requested %.1f/s, sending took %.2f s\n", sent, seconds,
+           (ok + rejected) / seconds, o.rate, (sendEnd - start) / 1000);
+    printf("answers ok %u, rejected %u, missing %u\n", ok, rejected, missing);
+    printf("latency ms p50 %.2f p90 %.2f p99 %.2f max %.2f\n", Percentile(replies.latencies, 50),
+           Percentile(replies.latencies, 90), Percentile(replies.latencies, 99),
+           Percentile(replies.latencies, 100));
+    printf("window stalls %u, pacing late max %.2f ms\n", stalls, lateMax);
+    return complete && !rejected ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/*
+ * telemetry_replay.c
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Host replay of the master's adaptive telemetry, built from the firmware's
+ *  TELEMETRY and LINK modules with the master's settings. A scripted
+ *  operator alternates between holding still and sweeping both axes at
+ *  random rates, sampled at the master's rate with gyro noise on the rates.
+ *  Every sample goes through TELEMETRY_Update(), the frames through the
+ *  slave's parser and receiver, and a frame is lost now and then.
+ *
+ *  Prints the bytes sent against the ASCII "y<yaw>\n\rp<pitch>\n\r" lines the
+ *  master used to send every sample, overall and while the operator holds
+ *  still. Checks that a synced slave never differs from the master by more
+ *  than the deadband, exits with 1 if it does.
+ *
+ *  Build and run from this directory:
+ *      gcc -O2 -Wall -I. -o telemetry_replay telemetry_replay.c ../../TurretMaster/TELEMETRY/TELEMETRY.c ../../TurretMaster/LINK/LINK.c
+ *      ./telemetry_replay [samples] [loss per 1000 frames] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../TurretMaster/TELEMETRY/TELEMETRY.h"
+
+// TurretMaster settings
+#define REPLAY_SAMPLE_HZ        150
+#define REPLAY_DEADBAND         1
+#define REPLAY_RATE_DEADBAND    20
+#define REPLAY_KEYFRAME_PERIOD  100
+#define REPLAY_YAW_MIN          20
+#define REPLAY_YAW_MAX          89
+#define REPLAY_PITCH_MIN        45
+#define REPLAY_PITCH_MAX        110
+
+#define REPLAY_GYRO_NOISE       4       // 0.1 deg/s, either way
+#define REPLAY_MAX_RATE         60      // deg/s of a sweep
+
+typedef struct
+{
+    double dAngle;
+    double dRate;                       // deg/s
+    int32_t i32Min, i32Max;
+} tReplayAxis;
+
+static tLinkParser g_sParser;
+static tTelemetryReceiver g_sReceiver;
+static bool g_bDrop;                    // the frame being sent is lost
+static bool g_bLost;                    // the slave missed a frame and may hold old values
+
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    (void)ui32Base;
+    if (g_bDrop)
+        return;
+    if (LINK_Parse(&g_sParser, ucData) == LINK_FRAME_READY)
+        TELEMETRY_Receive(&g_sReceiver, &g_sParser.sFrame);
+}
+
+static double Uniform(double dMin, double dMax)
+{
+    return dMin + (dMax - dMin) * rand() / RAND_MAX;
+}
+
+// A new segment: hold still, or sweep both axes
+static uint32_t Segment(tReplayAxis *psYaw, tReplayAxis *psPitch)
+{
+    if (rand() % 2)
+    {
+        psYaw->dRate = psPitch->dRate = 0;
+    }
+    else
+    {
+        psYaw->dRate = Uniform(-REPLAY_MAX_RATE, REPLAY_MAX_RATE);
+        psPitch->dRate = Uniform(-REPLAY_MAX_RATE, REPLAY_MAX_RATE) / 2;
+    }
+    return REPLAY_SAMPLE_HZ / 2 + rand() % (REPLAY_SAMPLE_HZ * 4);
+}
+
+static void Move(tReplayAxis *psAxis)
+{
+    psAxis->dAngle += psAxis->dRate / REPLAY_SAMPLE_HZ;
+    if (psAxis->dAngle < psAxis->i32Min || psAxis->dAngle > psAxis->i32Max)
+    {
+        // turn around at the limits
+        psAxis->dAngle = psAxis->dAngle < psAxis->i32Min ? psAxis->i32Min : psAxis->i32Max;
+        psAxis->dRate = -psAxis->dRate;
+    }
+}
+
+static int32_t Gyro(const tReplayAxis *psAxis)
+{
+    return (int32_t)(psAxis->dRate * 10) + rand() % (2 * REPLAY_GYRO_NOISE + 1) - REPLAY_GYRO_NOISE;
+}
+
+// Length of "<value>"
+static uint32_t Digits(int32_t i32Value)
+{
+    char pcText[16];
+
+    return (uint32_t)snprintf(pcText, sizeof(pcText), "%d", i32Value);
+}
+
+static int32_t Abs(int32_t i32Value)
+{
+    return i32Value < 0 ? -i32Value : i32Value;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ui32Samples = argc > 1 ? (uint32_t)atoi(argv[1]) : 100000;
+    uint32_t ui32LossPermille = argc > 2 ? (uint32_t)atoi(argv[2]) : 1;
+    tReplayAxis sYaw = { 55, 0, REPLAY_YAW_MIN, REPLAY_YAW_MAX };
+    tReplayAxis sPitch = { 50, 0, REPLAY_PITCH_MIN, REPLAY_PITCH_MAX };
+    uint64_t ui64Ascii = 0, ui64HoldAscii = 0, ui64HoldBytes = 0;
+    uint32_t ui32Left = 0, ui32Checked = 0, ui32Dropped = 0, i;
+    tTelemetryStats sStats;
+
+    srand(argc > 3 ? (unsigned)atoi(argv[3]) : 1);
+    LINK_ParserInit(&g_sParser);
+    TELEMETRY_ReceiverInit(&g_sReceiver);
+    TELEMETRY_Init(0, REPLAY_DEADBAND, REPLAY_RATE_DEADBAND, REPLAY_KEYFRAME_PERIOD);
+
+    for (i = 0; i < ui32Samples; i++)
+    {
+        int32_t i32Yaw, i32Pitch;
+        uint32_t ui32Frames, ui32Bytes, ui32Line;
+        bool bHold;
+
+        if (!ui32Left)
+            ui32Left = Segment(&sYaw, &sPitch);
+        ui32Left--;
+        Move(&sYaw);
+        Move(&sPitch);
+        bHold = sYaw.dRate == 0 && sPitch.dRate == 0;
+
+        // the master works in whole degrees
+        i32Yaw = (int32_t)sYaw.dAngle;
+        i32Pitch = (int32_t)sPitch.dAngle;
+        ui32Line = 1 + Digits(i32Yaw) + 2 + 1 + Digits(i32Pitch) + 2;
+        ui64Ascii += ui32Line;
+
+        TELEMETRY_StatsGet(&sStats);
+        ui32Frames = sStats.ui32Frames;
+        ui32Bytes = sStats.ui32Bytes;
+        g_bDrop = (uint32_t)(rand() % 1000) < ui32LossPermille;
+        TELEMETRY_Update(i32Yaw, i32Pitch, Gyro(&sYaw), Gyro(&sPitch),
+                         (uint16_t)((uint64_t)i * 1000 / REPLAY_SAMPLE_HZ));
+        TELEMETRY_StatsGet(&sStats);
+        if (bHold)
+        {
+            ui64HoldAscii += ui32Line;
+            ui64HoldBytes += sStats.ui32Bytes - ui32Bytes;
+        }
+
+        // a lost frame leaves the slave behind until a later one gets through
+        if (sStats.ui32Frames != ui32Frames)
+        {
+            if (g_bDrop)
+                ui32Dropped++;
+            g_bLost = g_bDrop || (g_bLost && !g_sReceiver.bSynced);
+        }
+        if (g_bLost || !g_sReceiver.bSynced)
+            continue;
+        if (Abs(g_sReceiver.i32Yaw - i32Yaw) > REPLAY_DEADBAND ||
+            Abs(g_sReceiver.i32Pitch - i32Pitch) > REPLAY_DEADBAND)
+        {
+            printf("sample %u: slave at %d/%d, master at %d/%d\n", i, g_sReceiver.i32Yaw, g_sReceiver.i32Pitch,
+                   i32Yaw, i32Pitch);
+            return 1;
+        }
+        ui32Checked++;
+    }
+
+    TELEMETRY_StatsGet(&sStats);
+    printf("samples %u, frames %u (keyframes %u), suppressed %u\n", sStats.ui32Samples, sStats.ui32Frames,
+           sStats.ui32Keyframes, sStats.ui32Suppressed);
+    printf("bytes %u, ascii would be %llu: %.1f%%, %.0f bytes/s\n", sStats.ui32Bytes,
+           (unsigned long long)ui64Ascii, 100.0 * sStats.ui32Bytes / ui64Ascii,
+           (double)sStats.ui32Bytes * REPLAY_SAMPLE_HZ / ui32Samples);
+    printf("holding still: %.1f%% of the ascii bytes\n", ui64HoldAscii ? 100.0 * ui64HoldBytes / ui64HoldAscii : 0);
+    printf("frames dropped %u, gaps seen by the slave %u, samples checked %u\n", ui32Dropped, g_sReceiver.ui32Lost,
+           ui32Checked);
+    return 0;
+}
@@ -0,0 +1,237 @@
+/*
+ * BRIDGE.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "BRIDGE.h"
+#include "RING/RING.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/uart.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_uart.h"
+
+typedef struct tBridgePort
+{
+    uint32_t ui32Base;
+    uint32_t ui32Int;
+    struct tBridgePort *psPeer;
+    tRing sRx;                      // received here, sent on the peer
+    bool bHeld;                     // ring full, receive interrupts masked
+    bool bStopped;                  // XOFF sent to the source
+    uint8_t ui8Control;             // XON / XOFF to send on this port before any data, 0 none
+    uint32_t ui32LastBytes;         // ui32RxBytes at the last rate update
+    tBridgeStats sStats;
+} tBridgePort;
+
+static uint8_t g_ppui8Buffers[BRIDGE_PORTS][BRIDGE_RING_SIZE];
+static tBridgePort g_psPorts[BRIDGE_PORTS];
+static bool g_bXonXoff;
+
+/*
+ * Send on a port: a pending flow control byte, then the peer's ring in place
+ * until the TX FIFO is full. Resumes the peer once its ring has room.
+ */
+static void BRIDGE_Transmit(tBridgePort *psPort)
+{
+    tBridgePort *psPeer = psPort->psPeer;
+    const uint8_t *pui8Span;
+    uint32_t ui32Len, i;
+
+    if (psPort->ui8Control && UARTCharPutNonBlocking(psPort->ui32Base, psPort->ui8Control))
+        psPort->ui8Control = 0;
+
+    while ((ui32Len = RING_ReadSpan(&psPeer->sRx, &pui8Span)) != 0)
+    {
+        for (i = 0; i < ui32Len; i++)
+        {
+            if (!UARTCharPutNonBlocking(psPort->ui32Base, pui8Span[i]))
+                break;
+        }
+        RING_ReadCommit(&psPeer->sRx, i);
+        psPort->sStats.ui32TxBytes += i;
+        if (i < ui32Len)
+            break;
+    }
+
+    // resume the peer as soon as a FIFO's worth fits again, XON only at the low water mark
+    if (psPeer->bHeld && RING_Free(&psPeer->sRx) >= BRIDGE_FIFO)
+    {
+        psPeer->bHeld = false;
+        UARTIntEnable(psPeer->ui32Base, UART_INT_RX | UART_INT_RT);
+        // the peer's handler empties what its FIFO held meanwhile
+        IntPendSet(psPeer->ui32Int);
+    }
+    if (psPeer->bStopped && RING_Count(&psPeer->sRx) <= BRIDGE_LOW_WATER)
+    {
+        psPeer->bStopped = false;
+        psPeer->ui8Control = BRIDGE_XON;
+        IntPendSet(psPeer->ui32Int);
+    }
+}
+
+/*
+ * Empty the RX FIFO of a port into its ring, the free space is written in place
+ */
+static void BRIDGE_Receive(tBridgePort *psPort)
+{
+    uint8_t *pui8Span;
+    uint32_t ui32Len, ui32Fill, i;
+    int32_t i32Data;
+
+    while (UARTCharsAvail(psPort->ui32Base))
+    {
+        ui32Len = RING_WriteSpan(&psPort->sRx, &pui8Span);
+        if (!ui32Len)
+        {
+            // the rest waits in the FIFO until the peer has sent some
+            psPort->bHeld = true;
+            psPort->sStats.ui32Holds++;
+            UARTIntDisable(psPort->ui32Base, UART_INT_RX | UART_INT_RT);
+            break;
+        }
+        for (i = 0; i < ui32Len && UARTCharsAvail(psPort->ui32Base); i++)
+        {
+            i32Data = UARTCharGetNonBlocking(psPort->ui32Base);
+            if (i32Data & UART_DR_OE)
+                psPort->sStats.ui32Overruns++;
+            pui8Span[i] = (uint8_t)i32Data;
+        }
+        RING_WriteCommit(&psPort->sRx, i);
+        psPort->sStats.ui32RxBytes += i;
+    }
+
+    ui32Fill = RING_Count(&psPort->sRx);
+    if (ui32Fill > psPort->sStats.ui32MaxFill)
+        psPort->sStats.ui32MaxFill = ui32Fill;
+    if (g_bXonXoff && ui32Fill >= BRIDGE_HIGH_WATER && !psPort->bStopped)
+    {
+        psPort->bStopped = true;
+        psPort->sStats.ui32Xoffs++;
+        psPort->ui8Control = BRIDGE_XOFF;
+        BRIDGE_Transmit(psPort);
+    }
+
+    // forward at once, the peer's TX interrupt only comes once its FIFO was filled
+    BRIDGE_Transmit(psPort->psPeer);
+}
+
+static void BRIDGE_IntHandler(tBridgePort *psPort)
+{
+    uint32_t ui32Status = UARTIntStatus(psPort->ui32Base, true);
+
+    UARTIntClear(psPort->ui32Base, ui32Status);
+
+    // a held port is also entered by IntPendSet() when it resumes
+    if (!psPort->bHeld)
+        BRIDGE_Receive(psPort);
+    BRIDGE_Transmit(psPort);
+}
+
+static void BRIDGE_PcIntHandler(void)
+{
+    BRIDGE_IntHandler(&g_psPorts[BRIDGE_PC]);
+}
+
+static void BRIDGE_BtIntHandler(void)
+{
+    BRIDGE_IntHandler(&g_psPorts[BRIDGE_BT]);
+}
+
+/*
+ * Start bridging, UART0 and UART5 must be configured (pins, baud rate) before
+ * @param <bool> $bXonXoff send XOFF / XON to a source at the high / low water mark
+ * @return void
+ */
+void BRIDGE_Init(bool bXonXoff)
+{
+    static const uint32_t BRIDGE_BASE[BRIDGE_PORTS] = { UART0_BASE, UART5_BASE };
+    static const uint32_t BRIDGE_INT[BRIDGE_PORTS] = { INT_UART0, INT_UART5 };
+    uint32_t i;
+
+    g_bXonXoff = bXonXoff;
+    for (i = 0; i < BRIDGE_PORTS; i++)
+    {
+        tBridgePort *psPort = &g_psPorts[i];
+
+        psPort->ui32Base = BRIDGE_BASE[i];
+        psPort->ui32Int = BRIDGE_INT[i];
+        psPort->psPeer = &g_psPorts[i ^ 1];
+        RING_Init(&psPort->sRx, g_ppui8Buffers[i], BRIDGE_RING_SIZE);
+        psPort->bHeld = false;
+        psPort->bStopped = false;
+        psPort->ui8Control = 0;
+        psPort->ui32LastBytes = 0;
+        psPort->sStats = (tBridgeStats){ 0 };
+
+        // RX interrupt at half full leaves 8 bytes of time, TX refills at 1/4
+        UARTFIFOEnable(psPort->ui32Base);
+        UARTFIFOLevelSet(psPort->ui32Base, UART_FIFO_TX2_8, UART_FIFO_RX4_8);
+        UARTTxIntModeSet(psPort->ui32Base, UART_TXINT_MODE_FIFO);
+    }
+
+    UARTIntRegister(UART0_BASE, BRIDGE_PcIntHandler);          // dynamic isr registering
+    UARTIntRegister(UART5_BASE, BRIDGE_BtIntHandler);          // dynamic isr registering
+    for (i = 0; i < BRIDGE_PORTS; i++)
+        UARTIntEnable(g_psPorts[i].ui32Base, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+}
+
+/*
+ * Send text of the board's own on a port, between bridged data. Not for interrupts.
+ * @param <uint32_t> $ui32Port BRIDGE_PC or BRIDGE_BT
+ * @param <const char *> $pcData bytes to send
+ * @param <uint32_t> $ui32Len number of bytes
+ * @return <uint32_t> bytes queued, the rest did not fit
+ */
+uint32_t BRIDGE_Write(uint32_t ui32Port, const char *pcData, uint32_t ui32Len)
+{
+    tBridgePort *psPort = &g_psPorts[ui32Port];
+    uint32_t ui32Done;
+
+    // the ring belongs to the peer's receive interrupt, which is held off meanwhile
+    IntDisable(psPort->psPeer->ui32Int);
+    ui32Done = RING_PushN(&psPort->psPeer->sRx, (const uint8_t *)pcData, ui32Len);
+    IntEnable(psPort->psPeer->ui32Int);
+
+    IntPendSet(psPort->ui32Int);
+    return ui32Done;
+}
+
+/*
+ * Work out the receive rates, call periodically
+ * @param <uint32_t> $ui32ElapsedMs time since the last call
+ * @return void
+ */
+void BRIDGE_RateUpdate(uint32_t ui32ElapsedMs)
+{
+    uint32_t ui32Bytes, i;
+
+    if (!ui32ElapsedMs)
+        return;
+    for (i = 0; i < BRIDGE_PORTS; i++)
+    {
+        tBridgePort *psPort = &g_psPorts[i];
+
+        ui32Bytes = psPort->sStats.ui32RxBytes;
+        psPort->sStats.ui32RxRate = (uint32_t)((uint64_t)(ui32Bytes - psPort->ui32LastBytes) * 1000 / ui32ElapsedMs);
+        psPort->ui32LastBytes = ui32Bytes;
+        if (psPort->sStats.ui32RxRate > psPort->sStats.ui32RxPeakRate)
+            psPort->sStats.ui32RxPeakRate = psPort->sStats.ui32RxRate;
+    }
+}
+
+/*
+ * @param <uint32_t> $ui32Port BRIDGE_PC or BRIDGE_BT
+ * @param <tBridgeStats *> $psStats filled in
+ * @return void
+ */
+void BRIDGE_StatsGet(uint32_t ui32Port, tBridgeStats *psStats)
+{
+    bool bMasked = IntMasterDisable();
+
+    *psStats = g_psPorts[ui32Port].sStats;
+    if (!bMasked)
+        IntMasterEnable();
+}
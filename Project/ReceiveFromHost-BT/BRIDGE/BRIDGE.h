@@ -0,0 +1,66 @@
+/*
+ * BRIDGE.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Transparent byte bridge between the PC (UART0) and the HC-05 (UART5).
+ *  Each direction has one RING: the RX interrupt of the source port writes
+ *  the FIFO straight into it, and the TX side of the other port sends from
+ *  it in place, span by span, whenever its FIFO drains to 1/4. The bytes
+ *  are never copied in between and main() is not involved.
+ *
+ *  Flow control: the TM4C123 has no RTS / CTS on UART0 and UART5. With
+ *  XON / XOFF enabled, XOFF goes to the source once its ring fills past
+ *  BRIDGE_HIGH_WATER and XON once it drains to BRIDGE_LOW_WATER; the quarter
+ *  of the ring above the high water mark takes what is still in flight. XON
+ *  / XOFF are off for binary data. A full ring masks the source's receive
+ *  interrupts, the 16 byte FIFO holds what still arrives, and reception
+ *  resumes as soon as a FIFO's worth fits again. Bytes lost by a full FIFO
+ *  show up as overruns.
+ *
+ *  Both UART vectors must have the same priority (the default): the two
+ *  handlers then never preempt each other, which keeps one producer and one
+ *  consumer per ring.
+ */
+
+#ifndef BRIDGE_BRIDGE_H_
+#define BRIDGE_BRIDGE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BRIDGE_RING_SIZE    4096                        // per direction, power of 2
+#define BRIDGE_HIGH_WATER   (BRIDGE_RING_SIZE * 3 / 4)
+#define BRIDGE_LOW_WATER    (BRIDGE_RING_SIZE / 4)
+#define BRIDGE_FIFO         16
+#define BRIDGE_XON          0x11
+#define BRIDGE_XOFF         0x13
+
+/*
+ * Ports, the direction of a ring is named by its source
+ */
+#define BRIDGE_PC           0       // UART0
+#define BRIDGE_BT           1       // UART5, HC-05
+#define BRIDGE_PORTS        2
+
+typedef struct
+{
+    uint32_t ui32RxBytes;           // received on this port
+    uint32_t ui32TxBytes;           // sent on this port, from the other one
+    uint32_t ui32RxRate;            // bytes per second, over the last BRIDGE_RateUpdate() interval
+    uint32_t ui32RxPeakRate;
+    uint32_t ui32Overruns;          // the RX FIFO overflowed, the hardware lost bytes
+    uint32_t ui32Xoffs;             // XOFF sent to the source
+    uint32_t ui32Holds;             // the ring was full, reception waited in the FIFO
+    uint32_t ui32MaxFill;           // highest fill of the ring from this port
+} tBridgeStats;
+
+/*
+ * Function declaration(s)
+ */
+extern void BRIDGE_Init(bool bXonXoff);
+extern uint32_t BRIDGE_Write(uint32_t ui32Port, const char *pcData, uint32_t ui32Len);
+extern void BRIDGE_RateUpdate(uint32_t ui32ElapsedMs);
+extern void BRIDGE_StatsGet(uint32_t ui32Port, tBridgeStats *psStats);
+
+#endif /* BRIDGE_BRIDGE_H_ */
@@ -0,0 +1,179 @@
+/*
+ * FORMAT.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "FORMAT.h"
+
+/*
+ * "00" to "99", two characters per entry, so a pair of digits costs one
+ * table lookup instead of a division and a modulo.
+ */
+static const char FORMAT_DIGIT_PAIRS[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+/*
+ * value / 100 for the whole 32-bit range using one UMULL and a shift:
+ *      1374389535 = ceil(2^37 / 100)
+ */
+static inline uint32_t FORMAT_Div100(uint32_t value)
+{
+    return (uint32_t)(((uint64_t)value * 1374389535u) >> 37);
+}
+
+/*
+ * Count the decimal digits of a value with compares only
+ * @param <uint32_t> $value value to measure
+ * @return <uint32_t> number of digits, 1 for zero
+ */
+static uint32_t FORMAT_CountDigits(uint32_t value)
+{
+    uint32_t digits = 1;
+
+    for (;;)
+    {
+        if (value < 10)
+            return digits;
+        if (value < 100)
+            return digits + 1;
+        if (value < 1000)
+            return digits + 2;
+        if (value < 10000)
+            return digits + 3;
+        value = FORMAT_Div100(FORMAT_Div100(value));
+        digits += 4;
+    }
+}
+
+/*
+ * Write the digits of $value backwards, ending right before $end
+ */
+static void FORMAT_WriteDigits(char *end, uint32_t value)
+{
+    while (value >= 100)
+    {
+        uint32_t q = FORMAT_Div100(value);
+        uint32_t r = (value - q * 100) * 2;
+        *--end = FORMAT_DIGIT_PAIRS[r + 1];
+        *--end = FORMAT_DIGIT_PAIRS[r];
+        value = q;
+    }
+
+    if (value >= 10)
+    {
+        *--end = FORMAT_DIGIT_PAIRS[value * 2 + 1];
+        *--end = FORMAT_DIGIT_PAIRS[value * 2];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+}
+
+/*
+ * Convert an unsigned value to decimal ASCII
+ * @param <char *> $buf output buffer, at least FORMAT_INT_MAX_LEN bytes
+ * @param <uint32_t> $value value to convert
+ * @return <uint32_t> number of characters written
+ */
+uint32_t FORMAT_Uint(char *buf, uint32_t value)
+{
+    uint32_t len = FORMAT_CountDigits(value);
+
+    FORMAT_WriteDigits(buf + len, value);
+    buf[len] = '\0';
+
+    return len;
+}
+
+/*
+ * Convert a signed value to decimal ASCII, '-' prefixed when negative
+ * @param <char *> $buf output buffer, at least FORMAT_INT_MAX_LEN bytes
+ * @param <int32_t> $value value to convert
+ * @return <uint32_t> number of characters written
+ */
+uint32_t FORMAT_Int(char *buf, int32_t value)
+{
+    if (value < 0)
+    {
+        *buf = '-';
+        // negate in unsigned arithmetic so INT32_MIN is handled as well
+        return FORMAT_Uint(buf + 1, 0u - (uint32_t)value) + 1;
+    }
+
+    return FORMAT_Uint(buf, (uint32_t)value);
+}
+
+/*
+ * Convert an unsigned value, left padded to a minimum width
+ * @param <char *> $buf output buffer, at least max(width, 10) + 1 bytes
+ * @param <uint32_t> $value value to convert
+ * @param <uint32_t> $width minimum number of characters, longer values are not truncated
+ * @param <char> $pad padding character, normally ' ' or '0'
+ * @return <uint32_t> number of characters written
+ */
+uint32_t FORMAT_UintFixed(char *buf, uint32_t value, uint32_t width, char pad)
+{
+    uint32_t digits = FORMAT_CountDigits(value);
+    uint32_t len = digits > width ? digits : width;
+    uint32_t i;
+
+    for (i = 0; i < len - digits; i++)
+        buf[i] = pad;
+
+    FORMAT_WriteDigits(buf + len, value);
+    buf[len] = '\0';
+
+    return len;
+}
+
+/*
+ * Convert a signed value, left padded to a minimum width.
+ * With '0' padding the sign is placed first ("-007"), otherwise it sits
+ * right in front of the digits ("  -7").
+ * @param <char *> $buf output buffer, at least max(width, 11) + 1 bytes
+ * @param <int32_t> $value value to convert
+ * @param <uint32_t> $width minimum number of characters including the sign
+ * @param <char> $pad padding character, normally ' ' or '0'
+ * @return <uint32_t> number of characters written
+ */
+uint32_t FORMAT_IntFixed(char *buf, int32_t value, uint32_t width, char pad)
+{
+    uint32_t magnitude;
+    uint32_t digits;
+    uint32_t len;
+    uint32_t i;
+
+    if (value >= 0)
+        return FORMAT_UintFixed(buf, (uint32_t)value, width, pad);
+
+    magnitude = 0u - (uint32_t)value;
+    digits = FORMAT_CountDigits(magnitude) + 1;
+    len = digits > width ? digits : width;
+
+    for (i = 0; i < len - digits; i++)
+        buf[i] = pad;
+
+    if (pad == '0')
+        buf[0] = '-';
+    else
+        buf[len - digits] = '-';
+    if (pad == '0' && len > digits)
+        buf[len - digits] = '0';
+
+    FORMAT_WriteDigits(buf + len, magnitude);
+    buf[len] = '\0';
+
+    return len;
+}
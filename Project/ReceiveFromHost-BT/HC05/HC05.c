@@ -0,0 +1,228 @@
+/*
+ * HC05.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "HC05.h"
+#include "../FORMAT/FORMAT.h"
+
+#define HC05_BOOT_MS        800     // time the module needs after EN goes high
+#define HC05_REPLY_MS       300     // time to wait for "OK"
+#define HC05_REPLY_LEN      32
+
+// UART rate the module is currently set to
+static uint32_t g_ui32Baud = HC05_DEFAULT_BAUD;
+
+// SysCtlDelay() count for one millisecond, cached so it is only computed once
+static uint32_t g_ui32DelayPerMs;
+
+static void HC05_DelayMs(uint32_t ms)
+{
+    SysCtlDelay(g_ui32DelayPerMs * ms);
+}
+
+/*
+ * Reprogram UART5 and drop whatever is left in the RX FIFO
+ */
+static void HC05_UARTSet(uint32_t baud)
+{
+    UARTConfigSetExpClk(HC05_UART_BASE, SysCtlClockGet(), baud,
+                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+
+    while (UARTCharsAvail(HC05_UART_BASE))
+        UARTCharGetNonBlocking(HC05_UART_BASE);
+}
+
+static void HC05_Send(const char *str)
+{
+    while (*str != '\0')
+        UARTCharPut(HC05_UART_BASE, *str++);
+}
+
+/*
+ * Send a command and wait for its reply line
+ * @param <const char *> $cmd command including the trailing "\r\n"
+ * @return <bool> true if the module answered "OK"
+ */
+static bool HC05_Command(const char *cmd)
+{
+    char reply[HC05_REPLY_LEN];
+    uint32_t len = 0;
+    uint32_t ticks;
+
+    HC05_Send(cmd);
+
+    // poll in 0.1 ms steps until a full line arrived or the reply timed out
+    for (ticks = 0; ticks < HC05_REPLY_MS * 10; ticks++)
+    {
+        while (UARTCharsAvail(HC05_UART_BASE))
+        {
+            char c = UARTCharGetNonBlocking(HC05_UART_BASE);
+
+            if (c == '\n')
+            {
+                reply[len] = '\0';
+                if (len >= 2 && reply[0] == 'O' && reply[1] == 'K')
+                    return true;
+                // "ERROR:(..)" or an unsolicited line, keep waiting for OK
+                len = 0;
+            }
+            else if (c != '\r' && len < HC05_REPLY_LEN - 1)
+            {
+                reply[len++] = c;
+            }
+        }
+        SysCtlDelay(g_ui32DelayPerMs / 10);
+    }
+
+    return false;
+}
+
+/*
+ * Power cycle the module with KEY high so it boots into full AT mode,
+ * which always runs at 38400 baud regardless of the stored UART setting.
+ */
+static void HC05_EnterATMode(void)
+{
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_KEY, HC05_PIN_KEY);
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_EN, 0);
+    HC05_DelayMs(100);
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_EN, HC05_PIN_EN);
+    HC05_DelayMs(HC05_BOOT_MS);
+
+    HC05_UARTSet(HC05_DEFAULT_BAUD);
+}
+
+/*
+ * Power cycle the module with KEY low so it boots into data mode
+ * @param <uint32_t> $baud UART rate the module was programmed to
+ */
+static void HC05_EnterDataMode(uint32_t baud)
+{
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_KEY, 0);
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_EN, 0);
+    HC05_DelayMs(100);
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_EN, HC05_PIN_EN);
+    HC05_DelayMs(HC05_BOOT_MS);
+
+    HC05_UARTSet(baud);
+}
+
+/*
+ * Program the module UART rate while in AT mode
+ */
+static bool HC05_SetRate(uint32_t baud)
+{
+    char cmd[HC05_REPLY_LEN] = "AT+UART=";
+    uint32_t len = 8;
+
+    len += FORMAT_Uint(cmd + len, baud);
+    cmd[len++] = ',';
+    cmd[len++] = '0';
+    cmd[len++] = ',';
+    cmd[len++] = '0';
+    cmd[len++] = '\r';
+    cmd[len++] = '\n';
+    cmd[len] = '\0';
+
+    return HC05_Command(cmd);
+}
+
+/*
+ * Set up UART5 and the control pins, module running at HC05_DEFAULT_BAUD
+ * @param none
+ * @return void
+ */
+void HC05_Init(void)
+{
+    g_ui32DelayPerMs = SysCtlClockGet() / (3 * 1000);
+
+    // enable UART5 and GPIOE
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART5);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
+
+    // Configure board PE4 for RX
+    // configure board PE5 for TX
+    GPIOPinConfigure(GPIO_PE4_U5RX);
+    GPIOPinConfigure(GPIO_PE5_U5TX);
+    // set PORTE pin4 and pin5 as UART type
+    GPIOPinTypeUART(GPIO_PORTE_BASE, GPIO_PIN_4 | GPIO_PIN_5);
+
+    // module enabled, data mode
+    GPIOPinTypeGPIOOutput(HC05_GPIO_BASE, HC05_PIN_EN | HC05_PIN_KEY | HC05_PIN_SPARE);
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_EN | HC05_PIN_KEY | HC05_PIN_SPARE, HC05_PIN_EN);
+
+    g_ui32Baud = HC05_DEFAULT_BAUD;
+    HC05_UARTSet(g_ui32Baud);
+}
+
+/*
+ * Check that the module answers at the current rate.
+ * KEY high without a power cycle gives the "mini" AT mode,
+ * which takes commands at the data mode rate.
+ * @param none
+ * @return <bool> true if the module answered "OK"
+ */
+bool HC05_Probe(void)
+{
+    bool ok;
+
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_KEY, HC05_PIN_KEY);
+    HC05_DelayMs(20);
+    ok = HC05_Command("AT\r\n") || HC05_Command("AT\r\n");
+    GPIOPinWrite(HC05_GPIO_BASE, HC05_PIN_KEY, 0);
+
+    return ok;
+}
+
+/*
+ * Negotiate the fastest working UART rate with the module.
+ * Must be called before UART5 interrupts are enabled.
+ * @param <const uint32_t *> $pui32Rates candidate rates, fastest first
+ * @param <uint32_t> $ui32Count number of candidate rates
+ * @return <uint32_t> rate UART5 and the module are running at afterwards
+ */
+uint32_t HC05_Configure(const uint32_t *pui32Rates, uint32_t ui32Count)
+{
+    uint32_t i;
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        HC05_EnterATMode();
+        if (!HC05_Command("AT\r\n"))
+        {
+            // no module in AT mode, leave everything at the default rate
+            break;
+        }
+
+        if (!HC05_SetRate(pui32Rates[i]))
+            continue;
+
+        HC05_EnterDataMode(pui32Rates[i]);
+        if (HC05_Probe())
+        {
+            g_ui32Baud = pui32Rates[i];
+            return g_ui32Baud;
+        }
+    }
+
+    // fall back to the default rate, restoring the module setting if it was changed
+    if (i > 0)
+    {
+        HC05_EnterATMode();
+        HC05_SetRate(HC05_DEFAULT_BAUD);
+    }
+    HC05_EnterDataMode(HC05_DEFAULT_BAUD);
+    g_ui32Baud = HC05_DEFAULT_BAUD;
+
+    return g_ui32Baud;
+}
+
+/*
+ * @return <uint32_t> rate UART5 is currently running at
+ */
+uint32_t HC05_BaudGet(void)
+{
+    return g_ui32Baud;
+}
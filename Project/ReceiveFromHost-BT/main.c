@@ -13,14 +13,18 @@ VCC -> VBUS
 EN -> VCC (for AT mode)
 
 Software Implementation:
-UART0 used to communicate with computer (only send in this demo)
-UART5 used to communicate with HC05 (only receive in this demo)
+UART0 used to communicate with computer
+UART5 used to communicate with HC05
+Both run at the rate the HC05 was raised to, the BRIDGE module forwards
+every byte in both directions from interrupts.
 
 Procedures:
 1. Smartphone/PC with bluetooth use bluetooth serial to send message to HC05,
 2. HC05 is connected to the UART5 on Tiva board. HC05 sends the message via UART5.
-3. Board receive character from HC05 in UART5 and forward to UART0 to computer.
-4. (recommended tools are listed in slide appendix).
+3. Board receive character from HC05 in UART5 and forward to UART0 to computer,
+   and the characters from the computer back to the HC05.
+4. Press SW1 to print the byte counters and rates of both directions.
+5. (recommended tools are listed in slide appendix).
 */
 
 
@@ -35,8 +39,75 @@ Procedures:
 #include "utils/uartstdio.h"
 #include "inc/hw_ints.h"
 #include "driverlib/interrupt.h"
+#include "FORMAT/FORMAT.h"
+#include "HC05/HC05.h"
+#include "TIME/TIME.h"
+#include "BUTTON/BUTTON.h"
+#include "BRIDGE/BRIDGE.h"
+
+// UART5 rates tried with the HC-05 at boot, fastest first
+static const uint32_t HC05_RATES[] = { 460800, 230400, 115200 };
+
+// Receive rates are worked out over this interval
+#define RATE_PERIOD_MS 1000
+
+tTimeTimer rateTimer;
+
+void RateTick(void *pvData)
+{
+    BRIDGE_RateUpdate(RATE_PERIOD_MS);
+}
+
+// Edges only wake the debounce
+void ButtonIntHandler(void)
+{
+    BUTTON_IntHandler();
+}
+
+uint32_t AppendString(char *line, uint32_t pos, const char *str)
+{
+    while (*str != '\0')
+        line[pos++] = *str++;
+    return pos;
+}
+
+uint32_t AppendUint(char *line, uint32_t pos, const char *label, uint32_t value)
+{
+    pos = AppendString(line, pos, label);
+    return pos + FORMAT_Uint(line + pos, value);
+}
+
+// One line per direction, sent to the computer between the bridged bytes
+void ReportDirection(const char *name, uint32_t from, uint32_t to)
+{
+    tBridgeStats source, sink;
+    char line[160];
+    uint32_t pos;
+
+    BRIDGE_StatsGet(from, &source);
+    BRIDGE_StatsGet(to, &sink);
+    pos = AppendString(line, 0, name);
+    pos = AppendUint(line, pos, " in/out: ", source.ui32RxBytes);
+    pos = AppendUint(line, pos, "/", sink.ui32TxBytes);
+    pos = AppendUint(line, pos, " rate/peak (B/s): ", source.ui32RxRate);
+    pos = AppendUint(line, pos, "/", source.ui32RxPeakRate);
+    pos = AppendUint(line, pos, " overruns: ", source.ui32Overruns);
+    pos = AppendUint(line, pos, " xoffs/holds: ", source.ui32Xoffs);
+    pos = AppendUint(line, pos, "/", source.ui32Holds);
+    pos = AppendUint(line, pos, " max fill: ", source.ui32MaxFill);
+    pos = AppendString(line, pos, "\n");
+    BRIDGE_Write(BRIDGE_PC, line, pos);
+}
+
+void UARTStringPut(uint32_t ui32Base, const char *str)
+{
+    while (*str != '\0')
+        UARTCharPut(ui32Base, *str++);
+}
 
 int main(void) {
+    tButtonEvent event;
+    char baud[FORMAT_INT_MAX_LEN];
 
     // set clock
     SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
@@ -52,84 +123,49 @@ int main(void) {
     // Set PORTA pin0 and pin1 as UART type
     GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
 
+    // UART5 is used to communicate with HC-05,
+    // raise its rate from the 38400 baud default as far as the module allows
+    HC05_Init();
+    HC05_Configure(HC05_RATES, sizeof(HC05_RATES) / sizeof(HC05_RATES[0]));
+
     // set UART base addr., clock get and baud rate.
-    // used to communicate with computer
-    UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 38400,
+    // used to communicate with computer, as fast as the bluetooth side
+    // so that neither direction has to wait for the other
+    UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), HC05_BaudGet(),
         (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
 
+    FORMAT_Uint(baud, HC05_BaudGet());
+    UARTStringPut(UART0_BASE, "HC-05 baud: ");
+    UARTStringPut(UART0_BASE, baud);
+    UARTStringPut(UART0_BASE, "\n");
+    UARTStringPut(UART0_BASE, "Waiting...\n");
 
-    // enable UART5 and GPIOE
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART5);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-
-    // Configure board PE4 for RX
-    // configure board PE5 for TX
-    GPIOPinConfigure(GPIO_PE4_U5RX);
-    GPIOPinConfigure(GPIO_PE5_U5TX);
-    // set PORTE pin4 and pin5 as UART type
-    GPIOPinTypeUART(GPIO_PORTE_BASE, GPIO_PIN_4 | GPIO_PIN_5);
-
-    // set UART base addr., system clock, baud rate
-    // used to communicate with HC-05
-    UARTConfigSetExpClk(UART5_BASE, SysCtlClockGet(), 38400,
-        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+    TIME_Init();
+    TIME_TimerInit(&rateTimer, RateTick, 0);
+    TIME_TimerStart(&rateTimer, RATE_PERIOD_MS, RATE_PERIOD_MS);
 
-    GPIOPinTypeGPIOOutput(GPIO_PORTE_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3);
-    GPIOPinWrite(GPIO_PORTE_BASE, GPIO_PIN_2|GPIO_PIN_1|GPIO_PIN_3, 2) ;
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+    BUTTON_Init(GPIO_PORTF_BASE, GPIO_PIN_4, 0);
+    GPIOIntRegister(GPIO_PORTF_BASE, ButtonIntHandler);           // dynamic isr registering
 
-    // set interrupt for receiving and showing values
+    // bytes are forwarded from the UART interrupts from now on, binary safe
+    BRIDGE_Init(false);
     IntMasterEnable();
-    IntEnable(INT_UART5);
-    UARTIntEnable(UART5_BASE, UART_INT_RX | UART_INT_RT);
-
-    UARTCharPut(UART0_BASE, 'W');
-    UARTCharPut(UART0_BASE, 'a');
-    UARTCharPut(UART0_BASE, 'i');
-    UARTCharPut(UART0_BASE, 't');
-    UARTCharPut(UART0_BASE, 'i');
-    UARTCharPut(UART0_BASE, 'n');
-    UARTCharPut(UART0_BASE, 'g');
-    UARTCharPut(UART0_BASE, '.');
-    UARTCharPut(UART0_BASE, '.');
-    UARTCharPut(UART0_BASE, '.');
-    UARTCharPut(UART0_BASE, '\n');
 
     while (1)
     {
+        while (BUTTON_EventGet(&event))
+        {
+            if (event.ui8Type != BUTTON_EVENT_PRESS)
+                continue;
+            ReportDirection("bt->pc", BRIDGE_BT, BRIDGE_PC);
+            ReportDirection("pc->bt", BRIDGE_PC, BRIDGE_BT);
+        }
+
+        IntMasterDisable();
+        if (!BUTTON_Pending())
+            SysCtlSleep();
+        IntMasterEnable();
     }
 
 }
-
-void UART0IntHandler(void)
-{
-    uint32_t ui32Status;
-
-    ui32Status = UARTIntStatus(UART5_BASE, true); //get interrupt status
-
-    UARTIntClear(UART0_BASE, ui32Status); //clear the asserted interrupts
-
-    while(UARTCharsAvail(UART0_BASE)) //loop while there are chars
-    {
-        UARTCharPut(UART5_BASE, UARTCharGet(UART0_BASE)); //echo character
-        SysCtlDelay(SysCtlClockGet() / (1000 * 3)); //delay some time
-    }
-}
-
-//check whether there are any items in the FIFO of UART5.
-//get characters from UART5 that communicates with bluetooth.
-//send received characters to UART0 that communicates with PC.
-void UART5IntHandler(void)
-{
-    uint32_t ui32Status;
-
-    ui32Status = UARTIntStatus(UART5_BASE, true); //get interrupt status
-
-    UARTIntClear(UART5_BASE, ui32Status); //clear the asserted interrupts
-
-    while(UARTCharsAvail(UART5_BASE)) //loop while there are chars
-    {
-        UARTCharPut(UART0_BASE, UARTCharGet(UART5_BASE)); //echo character
-        SysCtlDelay(SysCtlClockGet() / (1000 * 3)); //delay some time
-    }
-}
-
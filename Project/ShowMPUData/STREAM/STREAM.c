@@ -0,0 +1,220 @@
+/*
+ * STREAM.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "STREAM.h"
+#include "../DMAUART/DMAUART.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_types.h"
+
+/*
+ * Debug and trace registers of the Cortex-M4 core
+ */
+#define STREAM_DEMCR        0xE000EDFC
+#define STREAM_DEMCR_TRCENA 0x01000000
+#define STREAM_DWT_CTRL     0xE0001000
+#define STREAM_DWT_CYCCNTENA 0x00000001
+#define STREAM_DWT_CYCCNT   0xE0001004
+
+static uint32_t g_ui32Base;
+static uint8_t g_ui8FsFlags;
+static volatile uint32_t g_ui32Mode;
+static uint32_t g_ui32Seq;
+static tStreamStats g_sStats;
+
+// microsecond clock extended from the cycle counter
+static uint32_t g_ui32CyclesPerUs;
+static uint32_t g_ui32LastCycles;
+static uint32_t g_ui32CycleRest;
+static uint32_t g_ui32TimeUs;
+
+static void STREAM_Put16(uint8_t *pui8Buf, uint16_t ui16Value)
+{
+    pui8Buf[0] = (uint8_t)ui16Value;
+    pui8Buf[1] = (uint8_t)(ui16Value >> 8);
+}
+
+static void STREAM_Put32(uint8_t *pui8Buf, uint32_t ui32Value)
+{
+    pui8Buf[0] = (uint8_t)ui32Value;
+    pui8Buf[1] = (uint8_t)(ui32Value >> 8);
+    pui8Buf[2] = (uint8_t)(ui32Value >> 16);
+    pui8Buf[3] = (uint8_t)(ui32Value >> 24);
+}
+
+/*
+ * CRC-16/CCITT, polynomial 0x1021, MSB first
+ * @param <uint16_t> $ui16Crc initial value, 0xFFFF for a new record
+ * @param <const uint8_t *> $pui8Data data
+ * @param <uint32_t> $ui32Len number of bytes
+ * @return <uint16_t> updated CRC
+ */
+uint16_t STREAM_Crc16(uint16_t ui16Crc, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    uint32_t i, j;
+
+    for (i = 0; i < ui32Len; i++)
+    {
+        ui16Crc ^= (uint16_t)pui8Data[i] << 8;
+        for (j = 0; j < 8; j++)
+            ui16Crc = (ui16Crc & 0x8000) ? (uint16_t)((ui16Crc << 1) ^ 0x1021) : (uint16_t)(ui16Crc << 1);
+    }
+    return ui16Crc;
+}
+
+/*
+ * Set up the stream, the UART must already be on the DMA (DMAUART_Init)
+ * @param <uint32_t> $ui32Base UART to the PC
+ * @param <uint8_t> $ui8GyroFs gyro_FS_SEL the sensor was configured with
+ * @param <uint8_t> $ui8AccelFs accel_FS_SEL the sensor was configured with
+ * @param <uint32_t> $ui32Mode STREAM_MODE_* to start with
+ * @return void
+ */
+void STREAM_Init(uint32_t ui32Base, uint8_t ui8GyroFs, uint8_t ui8AccelFs, uint32_t ui32Mode)
+{
+    HWREG(STREAM_DEMCR) |= STREAM_DEMCR_TRCENA;
+    HWREG(STREAM_DWT_CTRL) |= STREAM_DWT_CYCCNTENA;
+    g_ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    g_ui32LastCycles = HWREG(STREAM_DWT_CYCCNT);
+    g_ui32CycleRest = 0;
+    g_ui32TimeUs = 0;
+
+    g_ui32Base = ui32Base;
+    g_ui8FsFlags = (ui8GyroFs & 0x03) | ((ui8AccelFs & 0x03) << 2);
+    g_ui32Mode = ui32Mode;
+    g_ui32Seq = 0;
+    g_sStats = (tStreamStats){ 0 };
+}
+
+/*
+ * Apply a command byte from the PC, other bytes are ignored.
+ * Starting from STREAM_MODE_OFF restarts SEQ at 0.
+ * @param <uint8_t> $ui8Cmd STREAM_CMD_*
+ * @return void
+ */
+void STREAM_Command(uint8_t ui8Cmd)
+{
+    uint32_t ui32Mode;
+
+    switch (ui8Cmd)
+    {
+    case STREAM_CMD_RAW:
+        ui32Mode = STREAM_MODE_RAW;
+        break;
+    case STREAM_CMD_FUSED:
+        ui32Mode = STREAM_MODE_FUSED;
+        break;
+    case STREAM_CMD_BOTH:
+        ui32Mode = STREAM_MODE_BOTH;
+        break;
+    case STREAM_CMD_STOP:
+        ui32Mode = STREAM_MODE_OFF;
+        break;
+    default:
+        return;
+    }
+
+    if (g_ui32Mode == STREAM_MODE_OFF)
+        g_ui32Seq = 0;
+    g_ui32Mode = ui32Mode;
+}
+
+/*
+ * @return <uint32_t> current STREAM_MODE_*
+ */
+uint32_t STREAM_ModeGet(void)
+{
+    return g_ui32Mode;
+}
+
+/*
+ * Microseconds since STREAM_Init, must be called at least once per
+ * cycle counter wrap (86 s at the 50 MHz this board runs at)
+ * @return <uint32_t> time in us
+ */
+uint32_t STREAM_TimeUs(void)
+{
+    uint32_t ui32Now = HWREG(STREAM_DWT_CYCCNT);
+
+    g_ui32CycleRest += ui32Now - g_ui32LastCycles;
+    g_ui32LastCycles = ui32Now;
+    g_ui32TimeUs += g_ui32CycleRest / g_ui32CyclesPerUs;
+    g_ui32CycleRest %= g_ui32CyclesPerUs;
+
+    return g_ui32TimeUs;
+}
+
+/*
+ * Build one record
+ * @param <uint8_t *> $pui8Buf STREAM_RECORD_SIZE bytes
+ * @param <uint8_t> $ui8Type STREAM_TYPE_RAW or STREAM_TYPE_FUSED
+ * @param <const tStreamSample *> $psSample sample to encode
+ * @param <uint32_t> $ui32Seq sequence number of the sample
+ * @return <uint32_t> STREAM_RECORD_SIZE
+ */
+uint32_t STREAM_Encode(uint8_t *pui8Buf, uint8_t ui8Type, const tStreamSample *psSample, uint32_t ui32Seq)
+{
+    uint8_t *pui8Data = pui8Buf + 12;
+    uint32_t i;
+
+    pui8Buf[0] = STREAM_SYNC0;
+    pui8Buf[1] = STREAM_SYNC1;
+    pui8Buf[2] = ui8Type;
+    pui8Buf[3] = g_ui8FsFlags | psSample->ui8Flags;
+    STREAM_Put32(pui8Buf + 4, ui32Seq);
+    STREAM_Put32(pui8Buf + 8, psSample->ui32TimeUs);
+
+    if (ui8Type == STREAM_TYPE_RAW)
+    {
+        for (i = 0; i < 7; i++)
+            STREAM_Put16(pui8Data + 2 * i, (uint16_t)psSample->pi16Raw[i]);
+    }
+    else
+    {
+        for (i = 0; i < 3; i++)
+            STREAM_Put32(pui8Data + 4 * i, (uint32_t)psSample->pi32Angle[i]);
+        STREAM_Put16(pui8Data + 12, (uint16_t)psSample->i16TempCenti);
+    }
+
+    STREAM_Put16(pui8Buf + 26, STREAM_Crc16(0xFFFF, pui8Buf + 2, 24));
+    return STREAM_RECORD_SIZE;
+}
+
+/*
+ * Queue the records of one sample for the current mode, nothing when stopped.
+ * Both records go out in one write, they share a DMA slot.
+ * @param <const tStreamSample *> $psSample sample to send
+ * @return void
+ */
+void STREAM_Send(const tStreamSample *psSample)
+{
+    uint8_t pui8Buf[2 * STREAM_RECORD_SIZE];
+    uint32_t ui32Mode = g_ui32Mode;
+    uint32_t ui32Len = 0;
+
+    if (ui32Mode == STREAM_MODE_OFF)
+        return;
+
+    if (ui32Mode & STREAM_MODE_RAW)
+        ui32Len += STREAM_Encode(pui8Buf + ui32Len, STREAM_TYPE_RAW, psSample, g_ui32Seq);
+    if (ui32Mode & STREAM_MODE_FUSED)
+        ui32Len += STREAM_Encode(pui8Buf + ui32Len, STREAM_TYPE_FUSED, psSample, g_ui32Seq);
+    DMAUART_Write(g_ui32Base, pui8Buf, ui32Len);
+
+    g_ui32Seq++;
+    g_sStats.ui32Samples++;
+    g_sStats.ui32Records += ui32Len / STREAM_RECORD_SIZE;
+    if (psSample->ui8Flags & STREAM_FLAG_OVERRUN)
+        g_sStats.ui32Overruns++;
+}
+
+/*
+ * @param <tStreamStats *> $psStats filled in
+ * @return void
+ */
+void STREAM_StatsGet(tStreamStats *psStats)
+{
+    *psStats = g_sStats;
+}
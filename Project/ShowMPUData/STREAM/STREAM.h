@@ -0,0 +1,96 @@
+/*
+ * STREAM.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Binary IMU stream to the PC, one fixed size record per sample and type.
+ *
+ *  Record format (STREAM_RECORD_SIZE bytes, all values little endian):
+ *      SYNC0(0xA5) SYNC1(0x5A) TYPE FLAGS SEQ[4] TIME[4] DATA[14] CRC16[2]
+ *  SEQ counts the samples sent since the stream was started, the raw and the
+ *  fused record of the same sample carry the same SEQ. TIME is the sample time
+ *  in us. CRC16 is CRC-16/CCITT (polynomial 0x1021, initial 0xFFFF) over
+ *  TYPE to the end of DATA, so a receiver can resync on SYNC0 SYNC1 and
+ *  check the candidate record.
+ *
+ *  DATA of STREAM_TYPE_RAW: ACCEL_X ACCEL_Y ACCEL_Z TEMP GYRO_X GYRO_Y GYRO_Z,
+ *  int16 sensor counts (calibrated), scaled by the FS_SEL values in FLAGS.
+ *  DATA of STREAM_TYPE_FUSED: PITCH[4] ROLL[4] YAW[4] in 0.001 deg, TEMP[2]
+ *  in 0.01 degree Celsius.
+ *
+ *  One byte commands from the PC select what is sent: STREAM_CMD_RAW,
+ *  STREAM_CMD_FUSED, STREAM_CMD_BOTH, STREAM_CMD_STOP.
+ *  Bandwidth at 1 kHz: 28 kB/s for one type, 56 kB/s for both, within
+ *  the 92 kB/s of 921600 baud.
+ */
+
+#ifndef STREAM_STREAM_H_
+#define STREAM_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define STREAM_SYNC0        0xA5
+#define STREAM_SYNC1        0x5A
+#define STREAM_RECORD_SIZE  28
+#define STREAM_DATA_SIZE    14
+
+/*
+ * Record types
+ */
+#define STREAM_TYPE_RAW     'R'
+#define STREAM_TYPE_FUSED   'F'
+
+/*
+ * FLAGS: full scale selection of the sensor and sample state
+ */
+#define STREAM_FLAG_GYRO_FS(f)  ((f) & 0x03)            // gyro_FS_SEL of MPU6050_Config()
+#define STREAM_FLAG_ACCEL_FS(f) (((f) >> 2) & 0x03)     // accel_FS_SEL of MPU6050_Config()
+#define STREAM_FLAG_SETTLING    0x40    // gyro zero offset still being measured, fused angles held
+#define STREAM_FLAG_OVERRUN     0x80    // the previous sample period was missed
+
+/*
+ * Stream modes, bit per record type
+ */
+#define STREAM_MODE_OFF     0x00
+#define STREAM_MODE_RAW     0x01
+#define STREAM_MODE_FUSED   0x02
+#define STREAM_MODE_BOTH    (STREAM_MODE_RAW | STREAM_MODE_FUSED)
+
+/*
+ * Commands from the PC
+ */
+#define STREAM_CMD_RAW      'r'
+#define STREAM_CMD_FUSED    'f'
+#define STREAM_CMD_BOTH     'b'
+#define STREAM_CMD_STOP     'x'
+
+typedef struct
+{
+    int16_t pi16Raw[7];             // accel x y z, temp, gyro x y z
+    int32_t pi32Angle[3];           // pitch, roll, yaw in 0.001 deg
+    int16_t i16TempCenti;           // 0.01 degree Celsius
+    uint32_t ui32TimeUs;            // STREAM_TimeUs() when the sensor was read
+    uint8_t ui8Flags;               // STREAM_FLAG_SETTLING / STREAM_FLAG_OVERRUN
+} tStreamSample;
+
+typedef struct
+{
+    uint32_t ui32Samples;           // samples sent
+    uint32_t ui32Records;
+    uint32_t ui32Overruns;          // samples sent with STREAM_FLAG_OVERRUN
+} tStreamStats;
+
+/*
+ * Function declaration(s)
+ */
+extern uint16_t STREAM_Crc16(uint16_t ui16Crc, const uint8_t *pui8Data, uint32_t ui32Len);
+extern void STREAM_Init(uint32_t ui32Base, uint8_t ui8GyroFs, uint8_t ui8AccelFs, uint32_t ui32Mode);
+extern void STREAM_Command(uint8_t ui8Cmd);
+extern uint32_t STREAM_ModeGet(void);
+extern uint32_t STREAM_TimeUs(void);
+extern uint32_t STREAM_Encode(uint8_t *pui8Buf, uint8_t ui8Type, const tStreamSample *psSample, uint32_t ui32Seq);
+extern void STREAM_Send(const tStreamSample *psSample);
+extern void STREAM_StatsGet(tStreamStats *psStats);
+
+#endif /* STREAM_STREAM_H_ */
@@ -0,0 +1,321 @@
+/*
+ * TWHEEL.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "TWHEEL.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_timer.h"
+#include "inc/hw_types.h"
+
+#define TWHEEL_TIMER_BASE   TIMER0_BASE
+#define TWHEEL_TIMER_PERIPH SYSCTL_PERIPH_TIMER0
+#define TWHEEL_TIMER_INT    INT_TIMER0A
+
+#define TWHEEL_SLOT_MASK    (TWHEEL_SLOTS - 1)
+
+static tTWheelTimer *g_pppsSlots[TWHEEL_LEVELS][TWHEEL_SLOTS];
+static uint32_t g_pui32Occupied[TWHEEL_LEVELS];     // bit per slot with timers
+
+// the wheel's time, and the counter value at that time
+static uint32_t g_ui32Now;
+static uint32_t g_ui32Base;
+static uint32_t g_ui32CyclesPerUs;
+
+static tTWheelStats g_sStats;
+
+/*
+ * Index of the lowest set bit, ui32Bits must not be 0
+ */
+static uint32_t TWHEEL_Lowest(uint32_t ui32Bits)
+{
+    static const uint8_t pui8DeBruijn[32] = {
+        0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+    };
+
+    return pui8DeBruijn[(uint32_t)((ui32Bits & -ui32Bits) * 0x077CB531UL) >> 27];
+}
+
+/*
+ * Microseconds the counter is ahead of the wheel
+ */
+static uint32_t TWHEEL_Elapsed(void)
+{
+    return (TimerValueGet(TWHEEL_TIMER_BASE, TIMER_A) - g_ui32Base) / g_ui32CyclesPerUs;
+}
+
+static void TWHEEL_Link(tTWheelTimer *psTimer)
+{
+    uint32_t ui32Delta = psTimer->ui32Expires - g_ui32Now;
+    uint32_t ui32Expires = psTimer->ui32Expires;
+    uint32_t ui32Level = 0;
+    tTWheelTimer **ppsSlot;
+
+    if ((int32_t)ui32Delta < 0)
+        ui32Delta = 0;
+    // out of range: park in the farthest slot, it moves down from there
+    if (ui32Delta >= TWHEEL_RANGE)
+    {
+        ui32Delta = TWHEEL_RANGE - 1;
+        ui32Expires = g_ui32Now + ui32Delta;
+    }
+    while (ui32Delta >= (1UL << (TWHEEL_SLOT_BITS * (ui32Level + 1))))
+        ui32Level++;
+
+    psTimer->ui8Level = ui32Level;
+    psTimer->ui8Slot = (ui32Expires >> (TWHEEL_SLOT_BITS * ui32Level)) & TWHEEL_SLOT_MASK;
+
+    ppsSlot = &g_pppsSlots[ui32Level][psTimer->ui8Slot];
+    psTimer->psNext = *ppsSlot;
+    if (*ppsSlot)
+        (*ppsSlot)->ppsPrev = &psTimer->psNext;
+    *ppsSlot = psTimer;
+    psTimer->ppsPrev = ppsSlot;
+    g_pui32Occupied[ui32Level] |= 1UL << psTimer->ui8Slot;
+}
+
+static void TWHEEL_Unlink(tTWheelTimer *psTimer)
+{
+    *psTimer->ppsPrev = psTimer->psNext;
+    if (psTimer->psNext)
+        psTimer->psNext->ppsPrev = psTimer->ppsPrev;
+    psTimer->ppsPrev = 0;
+
+    if (!g_pppsSlots[psTimer->ui8Level][psTimer->ui8Slot])
+        g_pui32Occupied[psTimer->ui8Level] &= ~(1UL << psTimer->ui8Slot);
+}
+
+/*
+ * Time of the next slot that has timers to call or to move down
+ * @return <bool> false if the wheel is empty
+ */
+static bool TWHEEL_Next(uint32_t *pui32Next)
+{
+    uint32_t ui32Level, ui32Shift, ui32Index, ui32Bits, ui32After, ui32Block, ui32Time;
+    bool bFound = false;
+
+    for (ui32Level = 0; ui32Level < TWHEEL_LEVELS; ui32Level++)
+    {
+        ui32Bits = g_pui32Occupied[ui32Level];
+        if (!ui32Bits)
+            continue;
+
+        // slots after the current one are in this turn of the level, the others in the next
+        ui32Shift = TWHEEL_SLOT_BITS * ui32Level;
+        ui32Index = (g_ui32Now >> ui32Shift) & TWHEEL_SLOT_MASK;
+        ui32Block = (g_ui32Now >> ui32Shift) & ~TWHEEL_SLOT_MASK;
+        ui32After = ui32Bits & ~((2UL << ui32Index) - 1);
+        if (ui32After)
+            ui32Block |= TWHEEL_Lowest(ui32After);
+        else
+            ui32Block = (ui32Block + TWHEEL_SLOTS) | TWHEEL_Lowest(ui32Bits);
+        ui32Time = ui32Block << ui32Shift;
+
+        if (!bFound || ui32Time - g_ui32Now < *pui32Next - g_ui32Now)
+            *pui32Next = ui32Time;
+        bFound = true;
+    }
+    return bFound;
+}
+
+/*
+ * The wheel has reached g_ui32Now: move timers down, then call the due ones
+ */
+static void TWHEEL_Process(void)
+{
+    tTWheelTimer **ppsSlot;
+    tTWheelTimer *psTimer;
+    uint32_t ui32Level;
+
+    for (ui32Level = 1; ui32Level < TWHEEL_LEVELS; ui32Level++)
+    {
+        if (g_ui32Now & ((1UL << (TWHEEL_SLOT_BITS * ui32Level)) - 1))
+            break;
+        ppsSlot = &g_pppsSlots[ui32Level][(g_ui32Now >> (TWHEEL_SLOT_BITS * ui32Level)) & TWHEEL_SLOT_MASK];
+        while ((psTimer = *ppsSlot) != 0)
+        {
+            TWHEEL_Unlink(psTimer);
+            TWHEEL_Link(psTimer);
+            g_sStats.ui32Cascaded++;
+        }
+    }
+
+    // a rearmed or newly started timer is at least 1 us away, never in this slot
+    ppsSlot = &g_pppsSlots[0][g_ui32Now & TWHEEL_SLOT_MASK];
+    while ((psTimer = *ppsSlot) != 0)
+    {
+        TWHEEL_Unlink(psTimer);
+        if (psTimer->ui32Period)
+        {
+            psTimer->ui32Expires += psTimer->ui32Period;
+            if ((int32_t)(psTimer->ui32Expires - g_ui32Now) <= 0)
+                psTimer->ui32Expires = g_ui32Now + 1;
+            TWHEEL_Link(psTimer);
+        }
+        g_sStats.ui32Fired++;
+        psTimer->pfnCallback(psTimer->pvData);
+    }
+}
+
+/*
+ * Bring the wheel up to the counter, stepping only to slots that need work
+ */
+static void TWHEEL_Advance(void)
+{
+    uint32_t ui32Target = g_ui32Now + TWHEEL_Elapsed();
+    uint32_t ui32Next;
+
+    while (g_ui32Now != ui32Target)
+    {
+        if (!TWHEEL_Next(&ui32Next) || ui32Next - g_ui32Now > ui32Target - g_ui32Now)
+            ui32Next = ui32Target;
+        g_ui32Base += (ui32Next - g_ui32Now) * g_ui32CyclesPerUs;
+        g_ui32Now = ui32Next;
+        TWHEEL_Process();
+    }
+}
+
+/*
+ * Set the match to the next slot that needs work, a slot the callbacks ran past pends the interrupt again
+ */
+static void TWHEEL_Program(void)
+{
+    uint32_t ui32Next, ui32Match;
+
+    if (!TWHEEL_Next(&ui32Next) || ui32Next - g_ui32Now > TWHEEL_MAX_SLEEP)
+        ui32Next = g_ui32Now + TWHEEL_MAX_SLEEP;
+    ui32Match = g_ui32Base + (ui32Next - g_ui32Now) * g_ui32CyclesPerUs;
+    TimerMatchSet(TWHEEL_TIMER_BASE, TIMER_A, ui32Match);
+
+    // the counter may already be past it
+    if ((int32_t)(ui32Match - TimerValueGet(TWHEEL_TIMER_BASE, TIMER_A)) <= 0)
+        IntPendSet(TWHEEL_TIMER_INT);
+}
+
+static void TWHEEL_IntHandler(void)
+{
+    TimerIntClear(TWHEEL_TIMER_BASE, TIMER_TIMA_MATCH);
+    g_sStats.ui32Wakeups++;
+
+    TWHEEL_Advance();
+    TWHEEL_Program();
+}
+
+/*
+ * Start the counter, TIMER0 belongs to the wheel from now on
+ * @param none
+ * @return void
+ */
+void TWHEEL_Init(void)
+{
+    uint32_t ui32Level, ui32Slot;
+
+    for (ui32Level = 0; ui32Level < TWHEEL_LEVELS; ui32Level++)
+    {
+        for (ui32Slot = 0; ui32Slot < TWHEEL_SLOTS; ui32Slot++)
+            g_pppsSlots[ui32Level][ui32Slot] = 0;
+        g_pui32Occupied[ui32Level] = 0;
+    }
+    g_ui32Now = g_ui32Base = 0;
+    g_ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    g_sStats = (tTWheelStats){ 0 };
+
+    SysCtlPeripheralEnable(TWHEEL_TIMER_PERIPH);
+    TimerConfigure(TWHEEL_TIMER_BASE, TIMER_CFG_PERIODIC_UP);
+    TimerLoadSet(TWHEEL_TIMER_BASE, TIMER_A, 0xFFFFFFFF);
+    // match interrupt enable is a mode bit TimerConfigure() does not set
+    HWREG(TWHEEL_TIMER_BASE + TIMER_O_TAMR) |= TIMER_TAMR_TAMIE;
+    TimerMatchSet(TWHEEL_TIMER_BASE, TIMER_A, TWHEEL_MAX_SLEEP * g_ui32CyclesPerUs);
+    TimerIntRegister(TWHEEL_TIMER_BASE, TIMER_A, TWHEEL_IntHandler);    // dynamic isr registering
+    TimerIntEnable(TWHEEL_TIMER_BASE, TIMER_TIMA_MATCH);
+    TimerEnable(TWHEEL_TIMER_BASE, TIMER_A);
+}
+
+/*
+ * @return <uint32_t> microseconds since TWHEEL_Init(), wraps after 71 minutes
+ */
+uint32_t TWHEEL_Now(void)
+{
+    bool bMasked = IntMasterDisable();
+    uint32_t ui32Now = g_ui32Now + TWHEEL_Elapsed();
+
+    if (!bMasked)
+        IntMasterEnable();
+    return ui32Now;
+}
+
+/*
+ * @param <tTWheelTimer *> $psTimer timer, stopped
+ * @param <tTWheelCallback> $pfnCallback called in the timer interrupt
+ * @param <void *> $pvData passed to the callback
+ * @return void
+ */
+void TWHEEL_TimerInit(tTWheelTimer *psTimer, tTWheelCallback pfnCallback, void *pvData)
+{
+    psTimer->psNext = 0;
+    psTimer->ppsPrev = 0;
+    psTimer->ui32Period = 0;
+    psTimer->pfnCallback = pfnCallback;
+    psTimer->pvData = pvData;
+}
+
+/*
+ * (Re)start a timer, from the main loop, an interrupt or a callback
+ * @param <tTWheelTimer *> $psTimer timer
+ * @param <uint32_t> $ui32DelayUs time to the first call, at least 1
+ * @param <uint32_t> $ui32PeriodUs time between the following calls, 0 for a one shot
+ * @return void
+ */
+void TWHEEL_TimerStart(tTWheelTimer *psTimer, uint32_t ui32DelayUs, uint32_t ui32PeriodUs)
+{
+    bool bMasked = IntMasterDisable();
+
+    if (psTimer->ppsPrev)
+        TWHEEL_Unlink(psTimer);
+    psTimer->ui32Expires = g_ui32Now + TWHEEL_Elapsed() + (ui32DelayUs ? ui32DelayUs : 1);
+    psTimer->ui32Period = ui32PeriodUs;
+    TWHEEL_Link(psTimer);
+    TWHEEL_Program();
+
+    if (!bMasked)
+        IntMasterEnable();
+}
+
+/*
+ * @param <tTWheelTimer *> $psTimer timer, nothing happens if it is stopped
+ * @return void
+ */
+void TWHEEL_TimerStop(tTWheelTimer *psTimer)
+{
+    bool bMasked = IntMasterDisable();
+
+    if (psTimer->ppsPrev)
+        TWHEEL_Unlink(psTimer);
+
+    if (!bMasked)
+        IntMasterEnable();
+}
+
+/*
+ * @param <const tTWheelTimer *> $psTimer timer
+ * @return <bool> true if the timer has a call coming
+ */
+bool TWHEEL_TimerActive(const tTWheelTimer *psTimer)
+{
+    return psTimer->ppsPrev != 0;
+}
+
+/*
+ * @param <tTWheelStats *> $psStats filled in
+ * @return void
+ */
+void TWHEEL_StatsGet(tTWheelStats *psStats)
+{
+    *psStats = g_sStats;
+}
@@ -43,8 +43,11 @@
 
 // User libraries
 #include "I2C/I2C.h"
+#include "TWHEEL/TWHEEL.h"
 #include "TIMER/TIMER.h"
 #include "MPU6050.h"
+#include "DMAUART/DMAUART.h"
+#include "STREAM/STREAM.h"
 
 #include "stdlib.h"         // atof() to read number
 
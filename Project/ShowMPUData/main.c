@@ -13,7 +13,10 @@
 // I2C0 used to communicate with MPU
 
 // send package format:
-// R aaa bbb ccc x
+// binary records on UART0 at 921600 baud, one per sample and type at SAMPLE_HZ,
+// see STREAM/STREAM.h. Nothing is sent until the PC selects a mode with one
+// command byte: 'r' raw, 'f' fused, 'b' both, 'x' stop.
+// Project/HostTools/ImuStream/imu_recv.cpp decodes the stream on the PC.
 
 
 // NOTE:
@@ -127,29 +130,33 @@ void I2CMSimpleIntHandler(void){
 
 
 // read data from MPU6050.
+#define SAMPLE_HZ       1000
+#define STREAM_BAUD     921600
+#define MPU_GYRO_FS     1           // +- 500 deg/s
+#define MPU_ACCEL_FS    1           // +- 4 g
+
 static const float dt = 1 / 200.0;
 static const int ZERO_OFFSET_COUN = (int)(200);
 
-static const float dt_2 = 1 / 150.0;
-static const int ZERO_OFFSET_COUN_2 = (int)(150);
+// integration starts once the zero offset is known, the step is the sample period
+static const int ZERO_OFFSET_COUN_2 = (int)(200);
 
 static int g_GetZeroOffset = 0;
 static float gyroX_offset = 0.0f, gyroY_offset = 0.0f, gyroZ_offset = 0.0f;
+static double g_AccelScale, g_GyroScale;
 
 
-void MPU6050Example(int *pitch, int *roll, int *yaw)
+void MPU6050Example(tStreamSample *psSample)
 {
-    double fAccel[3], fGyro[3];
-    double tmp;
+    int16_t *raw = psSample->pi16Raw;
     float gyroX, gyroY, gyroZ;
 
-    MPU6050_Read(&fAccel[0], &fAccel[1],&fAccel[2], &fGyro[0],&fGyro[1],&fGyro[2],&tmp);
-
-    gyroX = fGyro[0];
-    gyroY = fGyro[1];
-    gyroZ = fGyro[2];
-
+    // one bus transaction per sample, the fused angles are computed from the same reading
+    MPU6050_Read_raw_Calibrated(&raw[0], &raw[1], &raw[2], &raw[4], &raw[5], &raw[6], &raw[3]);
 
+    gyroX = raw[4] / g_GyroScale;
+    gyroY = raw[5] / g_GyroScale;
+    gyroZ = raw[6] / g_GyroScale;
 
     if (g_GetZeroOffset++ < ZERO_OFFSET_COUN)
     {
@@ -166,9 +173,9 @@ void MPU6050Example(int *pitch, int *roll, int *yaw)
     static float integralX = 0.0f, integralY = 0.0f, integralZ = 0.0f;
     if (g_GetZeroOffset > ZERO_OFFSET_COUN_2)
     {
-        integralX += gyroX * dt_2;
-        integralY += gyroY * dt_2;
-        integralZ += gyroZ * dt_2;
+        integralX += gyroX * loop_time;
+        integralY += gyroY * loop_time;
+        integralZ += gyroZ * loop_time;
         if (integralX > 360)
             integralX -= 360;
         if (integralX < -360)
@@ -181,30 +188,80 @@ void MPU6050Example(int *pitch, int *roll, int *yaw)
             integralZ -= 360;
         if (integralZ < -360)
             integralZ += 360;
+        psSample->ui8Flags &= ~STREAM_FLAG_SETTLING;
     }
+    else
+        psSample->ui8Flags |= STREAM_FLAG_SETTLING;
+
+    psSample->pi32Angle[0] = (int32_t)(integralX * 1000);
+    psSample->pi32Angle[1] = (int32_t)(integralY * 1000);
+    psSample->pi32Angle[2] = (int32_t)(integralZ * 1000);
+    // datasheet: temp / 340 + 36.53 degree Celsius
+    psSample->i16TempCenti = (int16_t)((int32_t)raw[3] * 100 / 340 + 3653);
+}
+
+void InitUART0(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
 
-    *pitch = (int)integralX;
-    *roll = (int)integralY;
-    *yaw = (int)integralZ;
-    delayMS(5);
+    GPIOPinConfigure(GPIO_PA0_U0RX);
+    GPIOPinConfigure(GPIO_PA1_U0TX);
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+
+    // 50 MHz / (16 * 921600) = 3.39, the fractional divider keeps the error below 0.1%
+    UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), STREAM_BAUD,
+                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+
+    // records leave on the DMA, UART0IntHandler only sees its completions
+    DMAUART_Init(UART0_BASE);
+    IntEnable(INT_UART0);
 }
 
-int X = 0, Y = 0, Z = 0;
+// The interrupt handler for UART0, DMA completions and the receive timeout.
+void UART0IntHandler(void){
+    DMAUART_IntHandler(UART0_BASE);
+}
+
+// Apply the command bytes the PC sent since the last sample.
+void StreamCommands(void){
+    const uint8_t *pui8Data;
+    uint32_t ui32Len, i;
+
+    while (DMAUART_RxGet(UART0_BASE, &pui8Data, &ui32Len))
+    {
+        for (i = 0; i < ui32Len; i++)
+            STREAM_Command(pui8Data[i]);
+        DMAUART_RxRelease(UART0_BASE);
+    }
+}
+
+tStreamSample g_sSample;
 int main(){
     SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
 
     // initialize I2C, you may do not care this part
     InitI2C0();
 
-    MPU6050_Config(0x68, 1, 1);
+    MPU6050_Config(0x68, MPU_GYRO_FS, MPU_ACCEL_FS);
     MPU6050_Calib_Set(903, 156, 1362, -4, 56, -16);
+    MPU6050_Scale_Get(&g_AccelScale, &g_GyroScale);
+
+    InitUART0();
+    STREAM_Init(UART0_BASE, MPU_GYRO_FS, MPU_ACCEL_FS, STREAM_MODE_OFF);
 
+    // the timer paces the samples, loop_time is the integration step
+    TWHEEL_Init();
+    TIMER_Config(SAMPLE_HZ);
 
     while(1){
-        // get raw data from MPU6050
-        MPU6050Example(&X, &Y, &Z);
-        // scale to a proper Master rotation
+        while (!end_loop)
+            ;
+        end_loop = false;
 
+        // get raw data from MPU6050 and integrate it
+        g_sSample.ui32TimeUs = STREAM_TimeUs();
+        MPU6050Example(&g_sSample);
 
         // NOTE:
         // the raw data of these three axes are all from -180 to 180.
@@ -213,16 +270,15 @@ int main(){
         // and the scale of servo Yaw angle should be constrained to 20 - 160.
         // Otherwise, the servo may be broken!
 
-        // design your parse to process the collected raw MPU data here
-
-
-        // show data here (recommend to use interrupt)
-        // example: R aaa bbb ccc x
+        STREAM_Send(&g_sSample);
+        StreamCommands();
 
+        // the next tick came before this sample was done, the PC sees it in FLAGS
+        if (end_loop)
+            g_sSample.ui8Flags |= STREAM_FLAG_OVERRUN;
+        else
+            g_sSample.ui8Flags &= ~STREAM_FLAG_OVERRUN;
     }
 
     return(0);
 }
-
-
-
@@ -0,0 +1,51 @@
+/*
+ * HC05.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  HC-05 Bluetooth module on UART5 (PE4 RX, PE5 TX).
+ *  At boot the module is switched to AT command mode, asked to run its UART
+ *  faster than the 38400 baud default, and verified with an "AT" probe at the
+ *  new rate. If a rate does not answer, the next slower one is tried, and the
+ *  module is left at HC05_DEFAULT_BAUD if none works.
+ */
+
+#ifndef HC05_HC05_H_
+#define HC05_HC05_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+
+/*
+ * Wiring of the module
+ *      PE1 -> EN, module enable, low while power cycling the module
+ *      PE2 -> KEY, high selects AT command mode
+ *      PE3 -> unused, kept low
+ */
+#define HC05_UART_BASE      UART5_BASE
+#define HC05_GPIO_BASE      GPIO_PORTE_BASE
+#define HC05_PIN_EN         GPIO_PIN_1
+#define HC05_PIN_KEY        GPIO_PIN_2
+#define HC05_PIN_SPARE      GPIO_PIN_3
+
+/*
+ * Full AT mode (KEY high at power up) always talks at 38400 baud,
+ * which is also the data rate the modules of this project are shipped with.
+ */
+#define HC05_DEFAULT_BAUD   38400
+
+/*
+ * Function declaration(s)
+ */
+extern void HC05_Init(void);
+extern uint32_t HC05_Configure(const uint32_t *pui32Rates, uint32_t ui32Count);
+extern bool HC05_Probe(void);
+extern uint32_t HC05_BaudGet(void);
+
+#endif /* HC05_HC05_H_ */
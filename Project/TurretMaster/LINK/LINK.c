@@ -0,0 +1,342 @@
+/*
+ * LINK.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "LINK.h"
+#include "driverlib/uart.h"
+
+/*
+ * Parser states
+ */
+#define LINK_STATE_SYNC     0
+#define LINK_STATE_TYPE     1
+#define LINK_STATE_LEN      2
+#define LINK_STATE_PAYLOAD  3
+#define LINK_STATE_CRC      4
+
+// own address, source of every addressed frame sent
+static uint8_t g_ui8Addr = LINK_ADDR_MASTER;
+
+// writes whole frames, UARTCharPut() byte by byte when not set
+static void (*g_pfnWrite)(uint32_t ui32Base, const uint8_t *pui8Data, uint32_t ui32Len);
+
+/*
+ * CRC8 (x^8 + x^2 + x + 1) one nibble at a time
+ */
+static const uint8_t LINK_CRC8_NIBBLE[16] = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
+    0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D
+};
+
+/*
+ * Update a CRC8 with more data
+ * @param <uint8_t> $ui8Crc CRC so far, 0 to start
+ * @param <const uint8_t *> $pui8Data data to add
+ * @param <uint32_t> $ui32Len number of bytes
+ * @return <uint8_t> updated CRC
+ */
+uint8_t LINK_Crc8(uint8_t ui8Crc, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    while (ui32Len--)
+    {
+        ui8Crc ^= *pui8Data++;
+        ui8Crc = (uint8_t)(ui8Crc << 4) ^ LINK_CRC8_NIBBLE[ui8Crc >> 4];
+        ui8Crc = (uint8_t)(ui8Crc << 4) ^ LINK_CRC8_NIBBLE[ui8Crc >> 4];
+    }
+    return ui8Crc;
+}
+
+/*
+ * Build a complete frame
+ * @param <uint8_t *> $pui8Buf output buffer, at least ui8Len + LINK_OVERHEAD bytes
+ * @param <uint8_t> $ui8Type frame type
+ * @param <const uint8_t *> $pui8Payload payload bytes
+ * @param <uint8_t> $ui8Len payload length, at most LINK_MAX_PAYLOAD
+ * @return <uint32_t> frame length
+ */
+uint32_t LINK_Encode(uint8_t *pui8Buf, uint8_t ui8Type, const uint8_t *pui8Payload, uint8_t ui8Len)
+{
+    uint32_t i;
+
+    pui8Buf[0] = LINK_SYNC;
+    pui8Buf[1] = ui8Type;
+    pui8Buf[2] = ui8Len;
+    for (i = 0; i < ui8Len; i++)
+        pui8Buf[3 + i] = pui8Payload[i];
+    pui8Buf[3 + ui8Len] = LINK_Crc8(0, pui8Buf + 1, ui8Len + 2);
+
+    return ui8Len + LINK_OVERHEAD;
+}
+
+/*
+ * Build a frame and write it to a UART
+ */
+void LINK_Send(uint32_t ui32Base, uint8_t ui8Type, const uint8_t *pui8Payload, uint8_t ui8Len)
+{
+    uint8_t pui8Frame[LINK_MAX_FRAME];
+    uint32_t ui32Len = LINK_Encode(pui8Frame, ui8Type, pui8Payload, ui8Len);
+    uint32_t i;
+
+    if (g_pfnWrite)
+    {
+        g_pfnWrite(ui32Base, pui8Frame, ui32Len);
+        return;
+    }
+    for (i = 0; i < ui32Len; i++)
+        UARTCharPut(ui32Base, pui8Frame[i]);
+}
+
+/*
+ * Send frames through another transport than the UART FIFO, e.g. DMAUART_Write()
+ * @param <void (*)(uint32_t, const uint8_t *, uint32_t)> $pfnWrite writes a whole frame
+ * @return void
+ */
+void LINK_TransportSet(void (*pfnWrite)(uint32_t ui32Base, const uint8_t *pui8Data, uint32_t ui32Len))
+{
+    g_pfnWrite = pfnWrite;
+}
+
+/*
+ * Send an addressed frame, the source is the own address
+ * @param <uint32_t> $ui32Base UART of the link
+ * @param <const tLinkFrame *> $psFrame type, payload (at most LINK_MAX_PAYLOAD - LINK_ADDR_HEADER
+ *                                      bytes), DST, FLAGS and SEQ
+ * @return <uint32_t> bytes put on the link
+ */
+uint32_t LINK_SendTo(uint32_t ui32Base, const tLinkFrame *psFrame)
+{
+    uint8_t pui8Payload[LINK_MAX_PAYLOAD];
+    uint32_t i;
+
+    pui8Payload[0] = psFrame->ui8Dst;
+    pui8Payload[1] = g_ui8Addr;
+    pui8Payload[2] = psFrame->ui8Flags & ~LINK_FLAG_ADDRESSED;
+    pui8Payload[3] = psFrame->ui8Seq;
+    for (i = 0; i < psFrame->ui8Len; i++)
+        pui8Payload[LINK_ADDR_HEADER + i] = psFrame->pui8Payload[i];
+    LINK_Send(ui32Base, psFrame->ui8Type | LINK_TYPE_ADDRESSED, pui8Payload, psFrame->ui8Len + LINK_ADDR_HEADER);
+
+    return psFrame->ui8Len + LINK_ADDR_HEADER + LINK_OVERHEAD;
+}
+
+/*
+ * Answer a received frame: addressed back to its source if it had a header,
+ * plain otherwise
+ * @param <uint32_t> $ui32Base UART of the link
+ * @param <const tLinkFrame *> $psRequest frame being answered
+ * @param <uint8_t> $ui8Type frame type of the answer
+ * @param <const uint8_t *> $pui8Payload payload bytes
+ * @param <uint8_t> $ui8Len payload length
+ * @return <bool> false if nothing was sent because the request went to a group or everyone
+ */
+bool LINK_Reply(uint32_t ui32Base, const tLinkFrame *psRequest, uint8_t ui8Type, const uint8_t *pui8Payload,
+                uint8_t ui8Len)
+{
+    tLinkFrame sReply;
+    uint32_t i;
+
+    if (!(psRequest->ui8Flags & LINK_FLAG_ADDRESSED))
+    {
+        LINK_Send(ui32Base, ui8Type, pui8Payload, ui8Len);
+        return true;
+    }
+    // several nodes answering at once would collide
+    if (psRequest->ui8Dst != g_ui8Addr)
+        return false;
+
+    sReply.ui8Type = ui8Type;
+    sReply.ui8Len = ui8Len;
+    for (i = 0; i < ui8Len; i++)
+        sReply.pui8Payload[i] = pui8Payload[i];
+    sReply.ui8Dst = psRequest->ui8Src;
+    sReply.ui8Flags = 0;
+    sReply.ui8Seq = psRequest->ui8Seq;
+    LINK_SendTo(ui32Base, &sReply);
+
+    return true;
+}
+
+/*
+ * Set the own address, LINK_ADDR_MASTER until changed
+ * @param <uint8_t> $ui8Addr node address
+ * @return void
+ */
+void LINK_AddressSet(uint8_t ui8Addr)
+{
+    g_ui8Addr = ui8Addr;
+}
+
+/*
+ * Start a parser that accepts frames for the master, broadcasts and plain frames
+ */
+void LINK_ParserInit(tLinkParser *psParser)
+{
+    psParser->ui8State = LINK_STATE_SYNC;
+    psParser->ui8Index = 0;
+    psParser->ui8Crc = 0;
+    psParser->ui8Addr = LINK_ADDR_MASTER;
+    psParser->ui8Groups = 0;
+    psParser->ui32Errors = 0;
+    psParser->ui32Filtered = 0;
+}
+
+/*
+ * Select the addressed frames a parser passes on
+ * @param <tLinkParser *> $psParser parser state
+ * @param <uint8_t> $ui8Addr own address
+ * @param <uint8_t> $ui8Groups groups joined, bit n for LINK_ADDR_GROUP(n)
+ * @return void
+ */
+void LINK_ParserFilterSet(tLinkParser *psParser, uint8_t ui8Addr, uint8_t ui8Groups)
+{
+    psParser->ui8Addr = ui8Addr;
+    psParser->ui8Groups = ui8Groups;
+}
+
+/*
+ * Split the address header off a complete frame
+ * @return <bool> true if the frame is for this parser
+ */
+static bool LINK_Accept(tLinkParser *psParser)
+{
+    tLinkFrame *psFrame = &psParser->sFrame;
+    uint8_t ui8Dst;
+    uint32_t i;
+
+    if (!(psFrame->ui8Type & LINK_TYPE_ADDRESSED))
+    {
+        psFrame->ui8Dst = LINK_ADDR_BROADCAST;
+        psFrame->ui8Src = 0;
+        psFrame->ui8Flags = 0;
+        psFrame->ui8Seq = 0;
+        return true;
+    }
+    if (psFrame->ui8Len < LINK_ADDR_HEADER)
+    {
+        psParser->ui32Errors++;
+        return false;
+    }
+
+    ui8Dst = psFrame->pui8Payload[0];
+    if (ui8Dst != LINK_ADDR_BROADCAST && ui8Dst != psParser->ui8Addr &&
+        !(LINK_ADDR_IS_GROUP(ui8Dst) && (psParser->ui8Groups & (1 << (ui8Dst & 7)))))
+    {
+        psParser->ui32Filtered++;
+        return false;
+    }
+
+    psFrame->ui8Type &= ~LINK_TYPE_ADDRESSED;
+    psFrame->ui8Dst = ui8Dst;
+    psFrame->ui8Src = psFrame->pui8Payload[1];
+    psFrame->ui8Flags = psFrame->pui8Payload[2] | LINK_FLAG_ADDRESSED;
+    psFrame->ui8Seq = psFrame->pui8Payload[3];
+    psFrame->ui8Len -= LINK_ADDR_HEADER;
+    for (i = 0; i < psFrame->ui8Len; i++)
+        psFrame->pui8Payload[i] = psFrame->pui8Payload[LINK_ADDR_HEADER + i];
+
+    return true;
+}
+
+/*
+ * Feed one received byte to the parser
+ * @param <tLinkParser *> $psParser parser state
+ * @param <uint8_t> $ui8Byte received byte
+ * @return <uint32_t> LINK_BYTE_UNUSED, LINK_BYTE_USED or LINK_FRAME_READY
+ */
+uint32_t LINK_Parse(tLinkParser *psParser, uint8_t ui8Byte)
+{
+    switch (psParser->ui8State)
+    {
+    case LINK_STATE_SYNC:
+        if (ui8Byte != LINK_SYNC)
+            return LINK_BYTE_UNUSED;
+        psParser->ui8State = LINK_STATE_TYPE;
+        break;
+
+    case LINK_STATE_TYPE:
+        psParser->sFrame.ui8Type = ui8Byte;
+        psParser->ui8Crc = LINK_Crc8(0, &ui8Byte, 1);
+        psParser->ui8State = LINK_STATE_LEN;
+        break;
+
+    case LINK_STATE_LEN:
+        if (ui8Byte > LINK_MAX_PAYLOAD)
+        {
+            psParser->ui32Errors++;
+            psParser->ui8State = LINK_STATE_SYNC;
+            break;
+        }
+        psParser->sFrame.ui8Len = ui8Byte;
+        psParser->ui8Crc = LINK_Crc8(psParser->ui8Crc, &ui8Byte, 1);
+        psParser->ui8Index = 0;
+        psParser->ui8State = ui8Byte ? LINK_STATE_PAYLOAD : LINK_STATE_CRC;
+        break;
+
+    case LINK_STATE_PAYLOAD:
+        psParser->sFrame.pui8Payload[psParser->ui8Index++] = ui8Byte;
+        psParser->ui8Crc = LINK_Crc8(psParser->ui8Crc, &ui8Byte, 1);
+        if (psParser->ui8Index == psParser->sFrame.ui8Len)
+            psParser->ui8State = LINK_STATE_CRC;
+        break;
+
+    case LINK_STATE_CRC:
+        psParser->ui8State = LINK_STATE_SYNC;
+        if (ui8Byte != psParser->ui8Crc)
+            psParser->ui32Errors++;
+        else if (LINK_Accept(psParser))
+            return LINK_FRAME_READY;
+        break;
+    }
+
+    return LINK_BYTE_USED;
+}
+
+/*
+ * Append a zigzag encoded varint: small magnitudes of either sign take one byte
+ * @param <uint8_t *> $pui8Buf output, up to 5 bytes are written
+ * @param <int32_t> $i32Value value to encode
+ * @return <uint32_t> number of bytes written
+ */
+uint32_t LINK_PutVarint(uint8_t *pui8Buf, int32_t i32Value)
+{
+    uint32_t ui32Zigzag = ((uint32_t)i32Value << 1) ^ (uint32_t)(i32Value >> 31);
+    uint32_t ui32Len = 0;
+
+    while (ui32Zigzag >= 0x80)
+    {
+        pui8Buf[ui32Len++] = (uint8_t)(ui32Zigzag | 0x80);
+        ui32Zigzag >>= 7;
+    }
+    pui8Buf[ui32Len++] = (uint8_t)ui32Zigzag;
+
+    return ui32Len;
+}
+
+/*
+ * Read a zigzag encoded varint
+ * @param <const uint8_t *> $pui8Buf input
+ * @param <uint32_t> $ui32Len bytes available in the input
+ * @param <int32_t *> $pi32Value decoded value
+ * @return <uint32_t> number of bytes consumed, 0 if the input is truncated
+ */
+uint32_t LINK_GetVarint(const uint8_t *pui8Buf, uint32_t ui32Len, int32_t *pi32Value)
+{
+    uint32_t ui32Zigzag = 0;
+    uint32_t ui32Shift = 0;
+    uint32_t i;
+
+    for (i = 0; i < ui32Len && i < 5; i++)
+    {
+        ui32Zigzag |= (uint32_t)(pui8Buf[i] & 0x7F) << ui32Shift;
+        if (!(pui8Buf[i] & 0x80))
+        {
+            *pi32Value = (int32_t)(ui32Zigzag >> 1) ^ -(int32_t)(ui32Zigzag & 1);
+            return i + 1;
+        }
+        ui32Shift += 7;
+    }
+
+    return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * NODE.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "NODE.h"
+#include "../LOAD/LOAD.h"
+
+static uint32_t g_ui32Base;
+static tNode g_psNodes[NODE_MAX];
+static uint32_t g_ui32Count;
+
+// node served first by the next NODE_Service()
+static uint32_t g_ui32Next;
+
+static uint32_t NODE_FrameBytes(const tLinkFrame *psFrame)
+{
+    return psFrame->ui8Len + LINK_ADDR_HEADER + LINK_OVERHEAD;
+}
+
+static void NODE_Pop(tNode *psNode)
+{
+    psNode->ui32Head = (psNode->ui32Head + 1) % NODE_QUEUE;
+    psNode->ui32Count--;
+    psNode->bWaitAck = false;
+}
+
+/*
+ * Forget all nodes
+ * @param <uint32_t> $ui32Base UART of the link
+ * @return void
+ */
+void NODE_Init(uint32_t ui32Base)
+{
+    g_ui32Base = ui32Base;
+    g_ui32Count = 0;
+    g_ui32Next = 0;
+}
+
+/*
+ * Add a slave
+ * @param <uint8_t> $ui8Addr its address, 1 - LINK_ADDR_MAX_NODE
+ * @return <int32_t> index of the node, -1 if the table is full
+ */
+int32_t NODE_Add(uint8_t ui8Addr)
+{
+    tNode *psNode;
+
+    if (g_ui32Count == NODE_MAX)
+        return -1;
+
+    psNode = &g_psNodes[g_ui32Count];
+    psNode->ui8Addr = ui8Addr;
+    psNode->ui32Head = 0;
+    psNode->ui32Count = 0;
+    psNode->ui8Seq = 0;
+    psNode->ui32Deficit = 0;
+    psNode->bWaitAck = false;
+    psNode->i32AckSeq = -1;
+    psNode->ui32Frames = 0;
+    psNode->ui32Bytes = 0;
+    psNode->ui32Acked = 0;
+    psNode->ui32Retries = 0;
+    psNode->ui32Dropped = 0;
+    psNode->ui32Replaced = 0;
+    psNode->ui32LastHeard = 0;
+    psNode->ui32Load = 0;
+    psNode->ui32PeakLoad = 0;
+
+    return (int32_t)g_ui32Count++;
+}
+
+/*
+ * @return <uint32_t> number of nodes added
+ */
+uint32_t NODE_Count(void)
+{
+    return g_ui32Count;
+}
+
+/*
+ * @return <const tNode *> state and statistics of a node
+ */
+const tNode *NODE_Get(uint32_t ui32Index)
+{
+    return &g_psNodes[ui32Index];
+}
+
+/*
+ * Queue a frame for a node, replacing an unsent one of the same type
+ * @param <uint32_t> $ui32Index node index
+ * @param <uint8_t> $ui8Type frame type
+ * @param <const uint8_t *> $pui8Payload payload bytes
+ * @param <uint8_t> $ui8Len payload length, at most LINK_MAX_PAYLOAD - LINK_ADDR_HEADER
+ * @param <uint8_t> $ui8Flags LINK_FLAG_ACK to have it acknowledged
+ * @return <bool> false if the queue is full
+ */
+bool NODE_Post(uint32_t ui32Index, uint8_t ui8Type, const uint8_t *pui8Payload, uint8_t ui8Len,
+               uint8_t ui8Flags)
+{
+    tNode *psNode = &g_psNodes[ui32Index];
+    tLinkFrame *psFrame = 0;
+    uint32_t i;
+
+    // the head is on the link already while it waits for its ACK
+    for (i = psNode->bWaitAck ? 1 : 0; i < psNode->ui32Count; i++)
+    {
+        tLinkFrame *psQueued = &psNode->psQueue[(psNode->ui32Head + i) % NODE_QUEUE];
+
+        if (psQueued->ui8Type == ui8Type)
+        {
+            psFrame = psQueued;
+            psNode->ui32Replaced++;
+            break;
+        }
+    }
+    if (!psFrame)
+    {
+        if (psNode->ui32Count == NODE_QUEUE)
+        {
+            psNode->ui32Dropped++;
+            return false;
+        }
+        psFrame = &psNode->psQueue[(psNode->ui32Head + psNode->ui32Count++) % NODE_QUEUE];
+        psFrame->ui8Seq = ++psNode->ui8Seq;
+    }
+
+    psFrame->ui8Type = ui8Type;
+    psFrame->ui8Len = ui8Len;
+    for (i = 0; i < ui8Len; i++)
+        psFrame->pui8Payload[i] = pui8Payload[i];
+    psFrame->ui8Dst = psNode->ui8Addr;
+    psFrame->ui8Flags = ui8Flags;
+
+    return true;
+}
+
+/*
+ * Send queued frames, sharing the budget fairly between the nodes
+ * @param <uint32_t> $ui32Budget bytes the link can take now
+ * @param <uint32_t> $ui32Now time (ms)
+ * @return <uint32_t> bytes sent
+ */
+uint32_t NODE_Service(uint32_t ui32Budget, uint32_t ui32Now)
+{
+    uint32_t ui32Sent = 0;
+    uint32_t i;
+
+    for (i = 0; i < g_ui32Count; i++)
+    {
+        uint32_t ui32Index = (g_ui32Next + i) % g_ui32Count;
+        tNode *psNode = &g_psNodes[ui32Index];
+        int32_t i32AckSeq = psNode->i32AckSeq;
+
+        // the ACK of the head frame, recorded by NODE_HandleFrame()
+        if (i32AckSeq >= 0)
+        {
+            psNode->i32AckSeq = -1;
+            if (psNode->bWaitAck && (uint8_t)i32AckSeq == psNode->psQueue[psNode->ui32Head].ui8Seq)
+            {
+                psNode->ui32Acked++;
+                NODE_Pop(psNode);
+            }
+        }
+
+        // give up on a frame that was never acknowledged
+        if (psNode->bWaitAck && ui32Now - psNode->ui32SentAt >= NODE_ACK_TIMEOUT_MS &&
+            psNode->ui32Tries > NODE_RETRIES)
+        {
+            psNode->ui32Dropped++;
+            NODE_Pop(psNode);
+        }
+        if (!psNode->ui32Count)
+        {
+            // an idle node does not save up credit
+            psNode->ui32Deficit = 0;
+            continue;
+        }
+        if (psNode->bWaitAck && ui32Now - psNode->ui32SentAt < NODE_ACK_TIMEOUT_MS)
+            continue;
+
+        psNode->ui32Deficit += NODE_QUANTUM;
+        while (psNode->ui32Count)
+        {
+            tLinkFrame *psFrame = &psNode->psQueue[psNode->ui32Head];
+            uint32_t ui32Bytes = NODE_FrameBytes(psFrame);
+
+            if (ui32Bytes > psNode->ui32Deficit)
+                break;
+            if (ui32Bytes > ui32Budget - ui32Sent)
+            {
+                // out of budget, this node goes first next time
+                g_ui32Next = ui32Index;
+                return ui32Sent;
+            }
+
+            LINK_SendTo(g_ui32Base, psFrame);
+            psNode->ui32Deficit -= ui32Bytes;
+            psNode->ui32Frames++;
+            psNode->ui32Bytes += ui32Bytes;
+            ui32Sent += ui32Bytes;
+
+            if (!(psFrame->ui8Flags & LINK_FLAG_ACK))
+            {
+                NODE_Pop(psNode);
+                continue;
+            }
+            if (psNode->bWaitAck)
+                psNode->ui32Retries++;
+            else
+                psNode->ui32Tries = 0;
+            psNode->ui32Tries++;
+            psNode->bWaitAck = true;
+            psNode->ui32SentAt = ui32Now;
+            break;
+        }
+    }
+    g_ui32Next = (g_ui32Next + 1) % (g_ui32Count ? g_ui32Count : 1);
+
+    return ui32Sent;
+}
+
+/*
+ * Process a frame from a node: ACK and STATUS are consumed, any frame
+ * counts as a sign of life. An ACK is left for NODE_Service() to match
+ * against the head, the queue is not touched here.
+ * @param <const tLinkFrame *> $psFrame received frame
+ * @param <uint32_t> $ui32Now time (ms)
+ * @return void
+ */
+void NODE_HandleFrame(const tLinkFrame *psFrame, uint32_t ui32Now)
+{
+    tNode *psNode = 0;
+    uint32_t i;
+
+    if (!(psFrame->ui8Flags & LINK_FLAG_ADDRESSED))
+        return;
+    for (i = 0; i < g_ui32Count; i++)
+        if (g_psNodes[i].ui8Addr == psFrame->ui8Src)
+            psNode = &g_psNodes[i];
+    if (!psNode)
+        return;
+
+    psNode->ui32LastHeard = ui32Now;
+    if (psFrame->ui8Type == LINK_TYPE_ACK)
+    {
+        if (psFrame->ui8Len == 1)
+            psNode->i32AckSeq = psFrame->pui8Payload[0];
+    }
+    else if (psFrame->ui8Type == LINK_TYPE_STATUS)
+        LOAD_StatusDecode(psFrame, &psNode->ui32Load, &psNode->ui32PeakLoad);
+}
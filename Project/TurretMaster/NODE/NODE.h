@@ -0,0 +1,78 @@
+/*
+ * NODE.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Per-slave traffic of a master driving several turrets over one link.
+ *
+ *  Every node has a short queue of addressed frames. Posting a frame of a
+ *  type that is still waiting in the queue replaces it, so a slow node gets
+ *  the latest update instead of a backlog. NODE_Service() hands out the link
+ *  budget left after the broadcast telemetry with deficit round robin: each
+ *  node with something to send earns NODE_QUANTUM bytes per call and sends
+ *  while its deficit covers the next frame, and a node that did not fit is
+ *  served first next time. Every node gets the same share of the link, no
+ *  matter how large its frames are.
+ *
+ *  A frame posted with LINK_FLAG_ACK stays at the head of its queue until
+ *  the ACK with its SEQ arrives, and is sent again after NODE_ACK_TIMEOUT_MS,
+ *  at most NODE_RETRIES times. NODE_HandleFrame() may run in an interrupt
+ *  and only records the SEQ of the ACK; the queues are changed by
+ *  NODE_Post() and NODE_Service() alone, which must run in one context.
+ */
+
+#ifndef NODE_NODE_H_
+#define NODE_NODE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../LINK/LINK.h"
+
+#define NODE_MAX            8
+#define NODE_QUEUE          4
+#define NODE_QUANTUM        (LINK_MAX_PAYLOAD + LINK_OVERHEAD)
+#define NODE_ACK_TIMEOUT_MS 50
+#define NODE_RETRIES        3
+
+typedef struct
+{
+    uint8_t ui8Addr;
+
+    // frames waiting, the head is psQueue[ui32Head]
+    tLinkFrame psQueue[NODE_QUEUE];
+    uint32_t ui32Head;
+    uint32_t ui32Count;
+    uint8_t ui8Seq;
+
+    // deficit round robin and acknowledgement of the head frame
+    uint32_t ui32Deficit;
+    bool bWaitAck;
+    uint32_t ui32SentAt;
+    uint32_t ui32Tries;
+    volatile int32_t i32AckSeq;     // SEQ of the last ACK for NODE_Service(), -1 if none
+
+    // statistics
+    uint32_t ui32Frames;            // frames sent, retries included
+    uint32_t ui32Bytes;             // bytes sent
+    uint32_t ui32Acked;             // frames acknowledged
+    uint32_t ui32Retries;           // frames sent again after a timeout
+    uint32_t ui32Dropped;           // frames given up after NODE_RETRIES or with a full queue
+    uint32_t ui32Replaced;          // queued frames overwritten by a newer one
+    uint32_t ui32LastHeard;         // time of the last frame from the node, ms
+    uint32_t ui32Load;              // load reported by the node, 1/1000
+    uint32_t ui32PeakLoad;          // peak load reported by the node, 1/1000
+} tNode;
+
+/*
+ * Function declaration(s)
+ */
+extern void NODE_Init(uint32_t ui32Base);
+extern int32_t NODE_Add(uint8_t ui8Addr);
+extern uint32_t NODE_Count(void);
+extern const tNode *NODE_Get(uint32_t ui32Index);
+extern bool NODE_Post(uint32_t ui32Index, uint8_t ui8Type, const uint8_t *pui8Payload, uint8_t ui8Len,
+                      uint8_t ui8Flags);
+extern uint32_t NODE_Service(uint32_t ui32Budget, uint32_t ui32Now);
+extern void NODE_HandleFrame(const tLinkFrame *psFrame, uint32_t ui32Now);
+
+#endif /* NODE_NODE_H_ */
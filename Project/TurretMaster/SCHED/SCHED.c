@@ -0,0 +1,199 @@
+/*
+ * SCHED.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "SCHED.h"
+#include "driverlib/cpu.h"
+#include "driverlib/interrupt.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_nvic.h"
+#include "inc/hw_types.h"
+
+/*
+ * Debug and trace registers of the Cortex-M4 core
+ */
+#define SCHED_DEMCR         0xE000EDFC
+#define SCHED_DEMCR_TRCENA  0x01000000
+#define SCHED_DWT_CTRL      0xE0001000
+#define SCHED_DWT_CYCCNTENA 0x00000001
+#define SCHED_DWT_CYCCNT    0xE0001004
+
+// lowest priority, PendSV must never preempt an interrupt handler
+#define SCHED_PENDSV_PRIORITY 0xE0
+
+static tSchedTaskInfo g_psTasks[SCHED_MAX_TASKS];
+
+// one bit per task id, set by SCHED_Post() through the bit-band alias
+static volatile uint32_t g_ui32Pending;
+static volatile uint32_t g_ui32UrgentPending;
+
+// cycles spent in WFI, only changed with interrupts masked
+static uint64_t g_ui64IdleCycles;
+
+/*
+ * Index of the lowest set bit, ui32Bits must not be 0
+ */
+static uint32_t SCHED_LowestBit(uint32_t ui32Bits)
+{
+    uint32_t ui32Id = 0;
+
+    while (!(ui32Bits & 1))
+    {
+        ui32Bits >>= 1;
+        ui32Id++;
+    }
+    return ui32Id;
+}
+
+static void SCHED_Execute(uint32_t ui32Id)
+{
+    tSchedTaskInfo *psTask = &g_psTasks[ui32Id];
+    uint32_t ui32Start = SCHED_Cycles();
+    uint32_t ui32Elapsed;
+
+    psTask->pfnTask();
+
+    ui32Elapsed = SCHED_Cycles() - ui32Start;
+    psTask->ui32Runs++;
+    psTask->ui64Cycles += ui32Elapsed;
+    if (ui32Elapsed > psTask->ui32MaxCycles)
+        psTask->ui32MaxCycles = ui32Elapsed;
+}
+
+static void SCHED_PendSVHandler(void)
+{
+    uint32_t ui32Id;
+
+    while (g_ui32UrgentPending)
+    {
+        ui32Id = SCHED_LowestBit(g_ui32UrgentPending);
+
+        // clear before running, a post while it runs schedules it again
+        HWREGBITW(&g_ui32UrgentPending, ui32Id) = 0;
+        SCHED_Execute(ui32Id);
+    }
+}
+
+/*
+ * Start the cycle counter and install the PendSV handler
+ * @param none
+ * @return void
+ */
+void SCHED_Init(void)
+{
+    uint32_t i;
+
+    HWREG(SCHED_DEMCR) |= SCHED_DEMCR_TRCENA;
+    HWREG(SCHED_DWT_CTRL) |= SCHED_DWT_CYCCNTENA;
+
+    for (i = 0; i < SCHED_MAX_TASKS; i++)
+        g_psTasks[i].pfnTask = 0;
+    g_ui32Pending = 0;
+    g_ui32UrgentPending = 0;
+    g_ui64IdleCycles = 0;
+
+    IntRegister(FAULT_PENDSV, SCHED_PendSVHandler);    // dynamic isr registering
+    IntPrioritySet(FAULT_PENDSV, SCHED_PENDSV_PRIORITY);
+}
+
+/*
+ * Register a task, do this before anything can post it
+ * @param <uint32_t> $ui32Id task id, also its priority: 0 runs first
+ * @param <const char *> $pcName name shown in statistics
+ * @param <tSchedTask> $pfnTask function that runs to completion
+ * @param <bool> $bUrgent run from PendSV instead of the main loop
+ * @return void
+ */
+void SCHED_TaskAdd(uint32_t ui32Id, const char *pcName, tSchedTask pfnTask, bool bUrgent)
+{
+    tSchedTaskInfo *psTask = &g_psTasks[ui32Id];
+
+    psTask->pcName = pcName;
+    psTask->pfnTask = pfnTask;
+    psTask->bUrgent = bUrgent;
+    psTask->ui32Runs = 0;
+    psTask->ui32MaxCycles = 0;
+    psTask->ui64Cycles = 0;
+}
+
+/*
+ * Mark a task as pending, safe from any interrupt handler
+ * @param <uint32_t> $ui32Id task id
+ * @return void
+ */
+void SCHED_Post(uint32_t ui32Id)
+{
+    if (g_psTasks[ui32Id].bUrgent)
+    {
+        HWREGBITW(&g_ui32UrgentPending, ui32Id) = 1;
+        HWREG(NVIC_INT_CTRL) = NVIC_INT_CTRL_PEND_SV;
+    }
+    else
+    {
+        HWREGBITW(&g_ui32Pending, ui32Id) = 1;
+    }
+}
+
+/*
+ * Run pending tasks forever, sleeping while there are none
+ * @param none
+ * @return void
+ */
+void SCHED_Run(void)
+{
+    uint32_t ui32Id, ui32Start;
+
+    while (1)
+    {
+        // a post between the check and WFI still wakes the core up,
+        // the interrupt stays pending while interrupts are masked
+        IntMasterDisable();
+        if (!g_ui32Pending)
+        {
+            // the waking interrupt only runs after IntMasterEnable()
+            ui32Start = SCHED_Cycles();
+            CPUwfi();
+            g_ui64IdleCycles += SCHED_Cycles() - ui32Start;
+            IntMasterEnable();
+            continue;
+        }
+        IntMasterEnable();
+
+        ui32Id = SCHED_LowestBit(g_ui32Pending);
+        HWREGBITW(&g_ui32Pending, ui32Id) = 0;
+        SCHED_Execute(ui32Id);
+    }
+}
+
+/*
+ * @param <uint32_t> $ui32Id task id
+ * @return <const tSchedTaskInfo *> name and runtime statistics of the task
+ */
+const tSchedTaskInfo *SCHED_TaskGet(uint32_t ui32Id)
+{
+    return &g_psTasks[ui32Id];
+}
+
+/*
+ * @return <uint32_t> current value of the free running cycle counter
+ */
+uint32_t SCHED_Cycles(void)
+{
+    return HWREG(SCHED_DWT_CYCCNT);
+}
+
+/*
+ * @return <uint64_t> cycles spent asleep waiting for work since SCHED_Init()
+ */
+uint64_t SCHED_IdleCycles(void)
+{
+    uint64_t ui64Idle;
+    bool bMasked = IntMasterDisable();
+
+    ui64Idle = g_ui64IdleCycles;
+    if (!bMasked)
+        IntMasterEnable();
+    return ui64Idle;
+}
@@ -0,0 +1,56 @@
+/*
+ * SCHED.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Event driven run-to-completion scheduler.
+ *  Interrupt handlers only acknowledge the hardware and SCHED_Post() a task,
+ *  the work itself runs later as a task:
+ *      - normal tasks run from SCHED_Run() in main(), lowest id first;
+ *      - urgent tasks run in the PendSV exception, which has the lowest
+ *        interrupt priority, so they run as soon as no interrupt is active
+ *        and preempt whatever normal task is running.
+ *  A task posted several times before it runs, runs once.
+ *
+ *  Pending tasks are bits of a word that SCHED_Post() sets through the
+ *  bit-band alias, a single store that needs neither a lock nor disabling
+ *  interrupts. With nothing pending the core sleeps in WFI.
+ *
+ *  Every task keeps the number of runs and the DWT cycles spent in it
+ *  (interrupts that preempt a task are counted in its time). Cycles spent
+ *  asleep in WFI are counted as idle, interrupts excluded.
+ */
+
+#ifndef SCHED_SCHED_H_
+#define SCHED_SCHED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SCHED_MAX_TASKS     32
+
+typedef void (*tSchedTask)(void);
+
+typedef struct
+{
+    const char *pcName;
+    tSchedTask pfnTask;
+    bool bUrgent;
+
+    uint32_t ui32Runs;
+    uint32_t ui32MaxCycles;         // longest single run
+    uint64_t ui64Cycles;            // all runs
+} tSchedTaskInfo;
+
+/*
+ * Function declaration(s)
+ */
+extern void SCHED_Init(void);
+extern void SCHED_TaskAdd(uint32_t ui32Id, const char *pcName, tSchedTask pfnTask, bool bUrgent);
+extern void SCHED_Post(uint32_t ui32Id);
+extern void SCHED_Run(void);
+extern const tSchedTaskInfo *SCHED_TaskGet(uint32_t ui32Id);
+extern uint32_t SCHED_Cycles(void);
+extern uint64_t SCHED_IdleCycles(void);
+
+#endif /* SCHED_SCHED_H_ */
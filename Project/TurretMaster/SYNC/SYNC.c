@@ -0,0 +1,281 @@
+/*
+ * SYNC.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "SYNC.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_types.h"
+
+/*
+ * Debug and trace registers of the Cortex-M4 core
+ */
+#define SYNC_DEMCR          0xE000EDFC
+#define SYNC_DEMCR_TRCENA   0x01000000
+#define SYNC_DWT_CTRL       0xE0001000
+#define SYNC_DWT_CYCCNTENA  0x00000001
+#define SYNC_DWT_CYCCNT     0xE0001004
+
+// cycles per microsecond
+static uint32_t g_ui32CyclesPerUs;
+
+// master: outstanding ping, round trip history and filter window
+static uint8_t g_ui8Seq;
+static uint32_t g_pui32Rtt[SYNC_RTT_HISTORY];
+static uint32_t g_ui32RttCount;
+static uint32_t g_ui32FilterCount;
+static uint32_t g_ui32FilterRtt;
+static int32_t g_i32FilterOffset;
+static uint32_t g_ui32FilterTime;
+static uint32_t g_ui32Pings, g_ui32Pongs;
+
+// both: current estimate, taken at master time g_ui32RefTime
+static bool g_bValid;
+static int32_t g_i32Offset;
+static int32_t g_i32DriftPpb;
+static uint32_t g_ui32RefTime;
+static uint32_t g_ui32RttUs;
+
+static void SYNC_Put32(uint8_t *pui8Buf, uint32_t ui32Value)
+{
+    pui8Buf[0] = (uint8_t)ui32Value;
+    pui8Buf[1] = (uint8_t)(ui32Value >> 8);
+    pui8Buf[2] = (uint8_t)(ui32Value >> 16);
+    pui8Buf[3] = (uint8_t)(ui32Value >> 24);
+}
+
+static uint32_t SYNC_Get32(const uint8_t *pui8Buf)
+{
+    return pui8Buf[0] | ((uint32_t)pui8Buf[1] << 8) | ((uint32_t)pui8Buf[2] << 16) |
+           ((uint32_t)pui8Buf[3] << 24);
+}
+
+/*
+ * Start the cycle counter
+ * @param none
+ * @return void
+ */
+void SYNC_Init(void)
+{
+    HWREG(SYNC_DEMCR) |= SYNC_DEMCR_TRCENA;
+    HWREG(SYNC_DWT_CYCCNT) = 0;
+    HWREG(SYNC_DWT_CTRL) |= SYNC_DWT_CYCCNTENA;
+
+    g_ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    g_ui8Seq = 0;
+    g_ui32RttCount = 0;
+    g_ui32FilterCount = 0;
+    g_ui32Pings = 0;
+    g_ui32Pongs = 0;
+    g_bValid = false;
+    g_i32Offset = 0;
+    g_i32DriftPpb = 0;
+    g_ui32RttUs = 0;
+}
+
+/*
+ * @return <uint32_t> current value of the free running cycle counter
+ */
+uint32_t SYNC_Cycles(void)
+{
+    return HWREG(SYNC_DWT_CYCCNT);
+}
+
+/*
+ * Offset predicted for a master time, following the drift since the estimate
+ */
+static int32_t SYNC_OffsetAt(uint32_t ui32MasterCycles)
+{
+    int32_t i32Elapsed = (int32_t)(ui32MasterCycles - g_ui32RefTime);
+
+    return g_i32Offset + (int32_t)((int64_t)i32Elapsed * g_i32DriftPpb / 1000000000);
+}
+
+/*
+ * Send a ping carrying the current estimate to the slave
+ * @param <uint32_t> $ui32Base UART of the link
+ * @param <uint8_t> $ui8Dst address of the slave the estimate is kept for
+ * @return void
+ */
+void SYNC_SendPing(uint32_t ui32Base, uint8_t ui8Dst)
+{
+    tLinkFrame sPing;
+    uint8_t *pui8Payload = sPing.pui8Payload;
+
+    sPing.ui8Type = LINK_TYPE_PING;
+    sPing.ui8Len = 17;
+    sPing.ui8Dst = ui8Dst;
+    sPing.ui8Flags = 0;
+    sPing.ui8Seq = ++g_ui8Seq;
+    pui8Payload[0] = g_ui8Seq;
+    SYNC_Put32(pui8Payload + 5, (uint32_t)(g_bValid ? SYNC_OffsetAt(SYNC_Cycles()) : 0));
+    SYNC_Put32(pui8Payload + 9, (uint32_t)g_i32DriftPpb);
+    SYNC_Put32(pui8Payload + 13, g_ui32RttUs);
+    // T1 as late as possible
+    SYNC_Put32(pui8Payload + 1, SYNC_Cycles());
+    LINK_SendTo(ui32Base, &sPing);
+
+    g_ui32Pings++;
+}
+
+/*
+ * Process a pong on the master
+ * @param <const tLinkFrame *> $psFrame received frame
+ * @param <uint32_t> $ui32T4 cycle counter when the frame was completed
+ * @return void
+ */
+void SYNC_HandlePong(const tLinkFrame *psFrame, uint32_t ui32T4)
+{
+    uint32_t ui32T1, ui32T2, ui32T3, ui32Rtt;
+    int32_t i32A, i32B, i32Offset;
+
+    if (psFrame->ui8Len != 13 || psFrame->pui8Payload[0] != g_ui8Seq)
+        return;
+
+    ui32T1 = SYNC_Get32(psFrame->pui8Payload + 1);
+    ui32T2 = SYNC_Get32(psFrame->pui8Payload + 5);
+    ui32T3 = SYNC_Get32(psFrame->pui8Payload + 9);
+
+    ui32Rtt = (ui32T4 - ui32T1) - (ui32T3 - ui32T2);
+    i32A = (int32_t)(ui32T2 - ui32T1);
+    i32B = (int32_t)(ui32T3 - ui32T4);
+    // midpoint without overflowing, the offset can be anywhere in 32 bits
+    i32Offset = i32A + (int32_t)((uint32_t)i32B - (uint32_t)i32A) / 2;
+
+    g_ui32Pongs++;
+    g_pui32Rtt[g_ui32RttCount++ % SYNC_RTT_HISTORY] = ui32Rtt;
+
+    // keep the sample of the window least disturbed by queueing
+    if (g_ui32FilterCount == 0 || ui32Rtt < g_ui32FilterRtt)
+    {
+        g_ui32FilterRtt = ui32Rtt;
+        g_i32FilterOffset = i32Offset;
+        g_ui32FilterTime = ui32T1 + ui32Rtt / 2;
+    }
+    if (++g_ui32FilterCount < SYNC_FILTER_LEN)
+        return;
+    g_ui32FilterCount = 0;
+
+    if (g_bValid)
+    {
+        int32_t i32Elapsed = (int32_t)(g_ui32FilterTime - g_ui32RefTime);
+        int32_t i32Change = g_i32FilterOffset - g_i32Offset;
+
+        if (i32Elapsed > 0)
+        {
+            int32_t i32Drift = (int32_t)((int64_t)i32Change * 1000000000 / i32Elapsed);
+            // smooth the slope, 1/4 of each new measurement
+            g_i32DriftPpb += (i32Drift - g_i32DriftPpb) / 4;
+        }
+    }
+    g_i32Offset = g_i32FilterOffset;
+    g_ui32RefTime = g_ui32FilterTime;
+    g_ui32RttUs = g_ui32FilterRtt / g_ui32CyclesPerUs;
+    g_bValid = true;
+}
+
+/*
+ * Round trip percentile over the history, in us
+ */
+static uint32_t SYNC_Percentile(const uint32_t *pui32Sorted, uint32_t ui32Count, uint32_t ui32Percent)
+{
+    uint32_t ui32Index = (ui32Count * ui32Percent + 99) / 100;
+
+    if (ui32Index > 0)
+        ui32Index--;
+    return pui32Sorted[ui32Index] / g_ui32CyclesPerUs;
+}
+
+/*
+ * Collect link timing statistics on the master
+ * @param <tSyncStats *> $psStats filled in
+ * @return void
+ */
+void SYNC_StatsGet(tSyncStats *psStats)
+{
+    uint32_t pui32Sorted[SYNC_RTT_HISTORY];
+    uint32_t ui32Count = g_ui32RttCount < SYNC_RTT_HISTORY ? g_ui32RttCount : SYNC_RTT_HISTORY;
+    uint32_t i, j;
+
+    // insertion sort of a copy, the history is small
+    for (i = 0; i < ui32Count; i++)
+    {
+        uint32_t ui32Value = g_pui32Rtt[i];
+        for (j = i; j > 0 && pui32Sorted[j - 1] > ui32Value; j--)
+            pui32Sorted[j] = pui32Sorted[j - 1];
+        pui32Sorted[j] = ui32Value;
+    }
+
+    psStats->ui32Pings = g_ui32Pings;
+    psStats->ui32Pongs = g_ui32Pongs;
+    psStats->i32Offset = g_i32Offset;
+    psStats->i32DriftPpb = g_i32DriftPpb;
+    if (ui32Count == 0)
+    {
+        psStats->ui32RttP50 = psStats->ui32RttP90 = psStats->ui32RttP99 = psStats->ui32RttMax = 0;
+        return;
+    }
+    psStats->ui32RttP50 = SYNC_Percentile(pui32Sorted, ui32Count, 50);
+    psStats->ui32RttP90 = SYNC_Percentile(pui32Sorted, ui32Count, 90);
+    psStats->ui32RttP99 = SYNC_Percentile(pui32Sorted, ui32Count, 99);
+    psStats->ui32RttMax = pui32Sorted[ui32Count - 1] / g_ui32CyclesPerUs;
+}
+
+/*
+ * Answer a ping on the slave and take over the master's estimate
+ * @param <uint32_t> $ui32Base UART of the link
+ * @param <const tLinkFrame *> $psFrame received frame
+ * @param <uint32_t> $ui32T2 cycle counter when the frame was completed
+ * @return void
+ */
+void SYNC_HandlePing(uint32_t ui32Base, const tLinkFrame *psFrame, uint32_t ui32T2)
+{
+    uint8_t pui8Payload[13];
+    int32_t i32Offset;
+
+    if (psFrame->ui8Len != 17)
+        return;
+
+    pui8Payload[0] = psFrame->pui8Payload[0];
+    pui8Payload[1] = psFrame->pui8Payload[1];
+    pui8Payload[2] = psFrame->pui8Payload[2];
+    pui8Payload[3] = psFrame->pui8Payload[3];
+    pui8Payload[4] = psFrame->pui8Payload[4];
+    SYNC_Put32(pui8Payload + 5, ui32T2);
+    // T3 as late as possible
+    SYNC_Put32(pui8Payload + 9, SYNC_Cycles());
+    if (!LINK_Reply(ui32Base, psFrame, LINK_TYPE_PONG, pui8Payload, sizeof(pui8Payload)))
+        return;
+
+    i32Offset = (int32_t)SYNC_Get32(psFrame->pui8Payload + 5);
+    g_ui32RttUs = SYNC_Get32(psFrame->pui8Payload + 13);
+    if (g_ui32RttUs == 0)
+        return;
+
+    // the estimate was taken at T1 on the master
+    g_ui32RefTime = SYNC_Get32(psFrame->pui8Payload + 1);
+    g_i32Offset = i32Offset;
+    g_i32DriftPpb = (int32_t)SYNC_Get32(psFrame->pui8Payload + 9);
+    g_bValid = true;
+}
+
+/*
+ * Map a master timestamp onto the slave clock
+ * @param <uint32_t> $ui32MasterCycles master cycle counter value
+ * @return <uint32_t> slave cycle counter value at the same instant
+ */
+uint32_t SYNC_LocalFromMaster(uint32_t ui32MasterCycles)
+{
+    if (!g_bValid)
+        return ui32MasterCycles;
+    return ui32MasterCycles + (uint32_t)SYNC_OffsetAt(ui32MasterCycles);
+}
+
+/*
+ * @return <uint32_t> filtered round trip in us, 0 until the first estimate
+ */
+uint32_t SYNC_RttGet(void)
+{
+    return g_ui32RttUs;
+}
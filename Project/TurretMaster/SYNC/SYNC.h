@@ -0,0 +1,61 @@
+/*
+ * SYNC.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Round trip measurement and clock synchronisation over the master/slave link,
+ *  using the Cortex-M4 DWT cycle counter as timebase on both boards.
+ *
+ *  PING (master -> slave): SEQ T1[4] OFFSET[4] DRIFT[4] RTT[4]
+ *  PONG (slave -> master): SEQ T1[4] T2[4] T3[4]
+ *
+ *  T1 master send time, T2 slave receive time, T3 slave send time and T4 the
+ *  master receive time, all in cycles of the respective board. NTP style:
+ *      rtt    = (T4 - T1) - (T3 - T2)
+ *      offset = ((T2 - T1) + (T3 - T4)) / 2        slave clock - master clock
+ *  Offsets are filtered by keeping the sample with the lowest round trip of
+ *  each SYNC_FILTER_LEN pings, and drift is the slope between filtered offsets.
+ *  Every PING carries the current estimate, so the slave can map master
+ *  timestamps onto its own clock as well. All values are little endian.
+ *  The estimate is kept for one slave, the one the pings are addressed to.
+ */
+
+#ifndef SYNC_SYNC_H_
+#define SYNC_SYNC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../LINK/LINK.h"
+
+#define SYNC_RTT_HISTORY    64      // round trips kept for the percentiles
+#define SYNC_FILTER_LEN     8       // pings per filtered offset sample
+
+typedef struct
+{
+    uint32_t ui32Pings;
+    uint32_t ui32Pongs;
+    uint32_t ui32RttP50;            // us
+    uint32_t ui32RttP90;            // us
+    uint32_t ui32RttP99;            // us
+    uint32_t ui32RttMax;            // us
+    int32_t i32Offset;              // cycles, slave - master
+    int32_t i32DriftPpb;            // slave clock rate error against master, parts per billion
+} tSyncStats;
+
+/*
+ * Function declaration(s)
+ */
+extern void SYNC_Init(void);
+extern uint32_t SYNC_Cycles(void);
+
+// master side
+extern void SYNC_SendPing(uint32_t ui32Base, uint8_t ui8Dst);
+extern void SYNC_HandlePong(const tLinkFrame *psFrame, uint32_t ui32T4);
+extern void SYNC_StatsGet(tSyncStats *psStats);
+
+// slave side
+extern void SYNC_HandlePing(uint32_t ui32Base, const tLinkFrame *psFrame, uint32_t ui32T2);
+extern uint32_t SYNC_LocalFromMaster(uint32_t ui32MasterCycles);
+extern uint32_t SYNC_RttGet(void);
+
+#endif /* SYNC_SYNC_H_ */
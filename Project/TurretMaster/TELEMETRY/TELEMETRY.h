@@ -0,0 +1,70 @@
+/*
+ * TELEMETRY.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Adaptive yaw/pitch telemetry between TurretMaster and TurretSlave.
+ *
+ *  The master only sends an axis when its angle moved by more than the
+ *  deadband, or its angular rate changed by more than the rate deadband.
+ *  Those updates are DELTA frames carrying zigzag varint changes against the
+ *  last values sent. A KEYFRAME with the absolute values is sent every
+ *  keyframe period, and it doubles as the heartbeat. A slave that misses a
+ *  DELTA (sequence gap) ignores deltas until the next KEYFRAME.
+ *
+ *  Every frame carries the master sample time (ms, 16-bit, little endian) and
+ *  the angular rate of each axis it contains (0.1 deg/s), so the slave can
+ *  extrapolate between frames.
+ *
+ *  KEYFRAME payload: SEQ TS0 TS1 yaw pitch yawRate pitchRate
+ *  DELTA payload:    SEQ TS0 TS1 MASK [dyaw yawRate] [dpitch pitchRate]
+ *                    MASK bit0 = yaw, bit1 = pitch
+ */
+
+#ifndef TELEMETRY_TELEMETRY_H_
+#define TELEMETRY_TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../LINK/LINK.h"
+
+#define TELEMETRY_AXIS_YAW      0x01
+#define TELEMETRY_AXIS_PITCH    0x02
+
+typedef struct
+{
+    uint32_t ui32Samples;       // TELEMETRY_Update() calls
+    uint32_t ui32Suppressed;    // samples that were not sent because of the deadband
+    uint32_t ui32Frames;        // frames sent, keyframes included
+    uint32_t ui32Keyframes;     // keyframes sent
+    uint32_t ui32Bytes;         // bytes put on the link
+} tTelemetryStats;
+
+typedef struct
+{
+    int32_t i32Yaw;
+    int32_t i32Pitch;
+    int32_t i32YawRate;         // 0.1 deg/s
+    int32_t i32PitchRate;       // 0.1 deg/s
+    uint16_t ui16Timestamp;     // master sample time of the last frame, ms
+    uint8_t ui8Seq;
+    bool bSynced;               // false until the first keyframe or after a lost frame
+
+    uint32_t ui32Frames;        // frames applied
+    uint32_t ui32Lost;          // sequence gaps detected
+} tTelemetryReceiver;
+
+/*
+ * Function declaration(s)
+ */
+extern void TELEMETRY_Init(uint32_t ui32Base, int32_t i32Deadband, int32_t i32RateDeadband,
+                           uint32_t ui32KeyframePeriod);
+extern void TELEMETRY_Update(int32_t i32Yaw, int32_t i32Pitch, int32_t i32YawRate, int32_t i32PitchRate,
+                             uint16_t ui16Timestamp);
+extern void TELEMETRY_StatsGet(tTelemetryStats *psStats);
+extern uint32_t TELEMETRY_UtilizationGet(uint32_t ui32Baud, uint32_t ui32ElapsedMs);
+
+extern void TELEMETRY_ReceiverInit(tTelemetryReceiver *psRx);
+extern uint32_t TELEMETRY_Receive(tTelemetryReceiver *psRx, const tLinkFrame *psFrame);
+
+#endif /* TELEMETRY_TELEMETRY_H_ */
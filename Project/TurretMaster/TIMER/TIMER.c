@@ -8,43 +8,35 @@
 
 #include "TIMER.h"
 
+static tTWheelTimer g_sLoopTimer;
+
 /*
- * Interrupt handler
- *      clear interrupt, set $end_loop value to 1
- * @param none
+ * Timer wheel callback
+ *      set $end_loop value to 1
+ * @param <void *> $pvData unused
  * @return void
  */
-static void TIMER_ISR(void) {
-    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+static void TIMER_Tick(void *pvData) {
     end_loop = true;
 }
 
 /*
- * Configure TIMER for timing Program's main loop
+ * Configure a timer wheel timer for timing Program's main loop, call after TWHEEL_Init()
  * @param <double> $freq system's frequency
  * @return void
  */
 void TIMER_Config(double freq)
 {
-    /*
-     * Configure TIMERA full-width
-     */
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
-    TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
-
-    // Load value = (number of clocks in a second) / (system frequency)
-    TimerLoadSet(TIMER0_BASE, TIMER_A, SysCtlClockGet()/freq - 1 );
-
-    TimerEnable(TIMER0_BASE, TIMER_A);
+    // Period in microseconds, the wheel's resolution
+    uint32_t ui32PeriodUs = (uint32_t)(1000000 / freq + 0.5);
 
-    TimerIntRegister(TIMER0_BASE, TIMER_A, &TIMER_ISR);
+    TWHEEL_TimerInit(&g_sLoopTimer, TIMER_Tick, 0);
+    TWHEEL_TimerStart(&g_sLoopTimer, ui32PeriodUs, ui32PeriodUs);
 
-    IntEnable(INT_TIMER0A);
-    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
     IntMasterEnable();
 
     /*
      * Set the loop_time variable's value
      */
-    loop_time = 1/freq;
+    loop_time = ui32PeriodUs / 1000000.0;
 }
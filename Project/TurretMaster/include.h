@@ -43,8 +43,21 @@
 
 // User libraries
 #include "I2C/I2C.h"
+#include "TWHEEL/TWHEEL.h"
 #include "TIMER/TIMER.h"
 #include "MPU6050.h"
+#include "FORMAT/FORMAT.h"
+#include "HC05/HC05.h"
+#include "LINK/LINK.h"
+#include "TELEMETRY/TELEMETRY.h"
+#include "SYNC/SYNC.h"
+#include "TIME/TIME.h"
+#include "SCHED/SCHED.h"
+#include "LOAD/LOAD.h"
+#include "NODE/NODE.h"
+#include "DMAUART/DMAUART.h"
+#include "BUTTON/BUTTON.h"
+#include "RING/RING.h"
 
 #include "stdlib.h"         // atof() to read number
 
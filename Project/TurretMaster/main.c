@@ -26,13 +26,38 @@
 #include "sensorlib/mpu6050.h"
 #include "utils/uartstdio.h"
 
+// Sampling rate of the MPU6050, matches the integration step dt_2
+#define SAMPLE_HZ 150
+#define SAMPLE_PERIOD_US (1000000 / SAMPLE_HZ)
+// Samples between two clock sync pings
+#define PING_PERIOD 40
+// Samples between two cpu load reports to the slaves
+#define STATUS_PERIOD SAMPLE_HZ
+// Share of the link (%) the telemetry and per-node frames may use together
+#define LINK_BUDGET_PERCENT 80
+
+// Slaves on the link, the clock sync runs with the first one.
+// Telemetry frames carry no address and drive all of them.
+static const uint8_t NODE_ADDRS[] = { 1 };
+
 /*
- * Generic Utilities
+ * Tasks, the id is also the priority (0 runs first)
  */
-void delayMS(int ms)
-{
-    SysCtlDelay((SysCtlClockGet() / (3 * 1000)) * ms); // less accurate
-}
+#define TASK_LINK 0         // urgent, hands the UART5 DMA buffers back before they run out
+#define TASK_SAMPLE 1
+#define TASK_BUTTON 2
+#define TASK_CONSOLE 3
+#define TASK_COUNT 4
+
+/*
+ * Interrupt handlers with their own busy time
+ */
+#define ISR_CONSOLE 0
+#define ISR_LINK 1
+#define ISR_BUTTON 2
+#define ISR_SAMPLE 3
+#define ISR_I2C 4
+#define ISR_COUNT 5
 
 /*
  * UART Functions to handle the communication via UART.
@@ -50,61 +75,311 @@ void UARTStringPut(uint32_t ui32Base, char *str)
 
 void UARTIntPut(uint32_t ui32Base, int value)
 {
-    char temp[10];
-    char result[10];
-    int tempCount = 0;
-    int resultCount = 0;
+    char result[FORMAT_INT_MAX_LEN];
+
+    FORMAT_Int(result, value);
+    UARTStringPut(ui32Base, result);
+}
+
+// Replies from the slave on UART5
+tLinkParser linkParser;
+
+// Link bytes per sample, and the telemetry bytes counted so far
+uint32_t linkBudget;
+uint32_t telemetryBytes = 0;
 
-    if (value == 0)
+// Number of samples sent through the telemetry so far
+uint32_t sampleCount = 0;
+
+// UART0 bytes from the interrupt to ConsoleTask
+#define CONSOLE_RING_SIZE 256
+uint8_t consoleRxBuffer[CONSOLE_RING_SIZE];
+tRing consoleRx;
+volatile uint32_t consoleRxDropped = 0;
+
+// Runs, mean and longest run of every task
+void ShowTaskStats(void)
+{
+    uint32_t ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    uint32_t i;
+
+    for (i = 0; i < TASK_COUNT; i++)
     {
-        result[0] = '0';
-        result[1] = '\0';
-        UARTCharPut(ui32Base, '0');
+        const tSchedTaskInfo *psTask = SCHED_TaskGet(i);
+
+        UARTStringPut(UART0_BASE, (char *)psTask->pcName);
+        UARTStringPut(UART0_BASE, " runs: ");
+        UARTIntPut(UART0_BASE, psTask->ui32Runs);
+        UARTStringPut(UART0_BASE, " mean/max (us): ");
+        UARTIntPut(UART0_BASE, psTask->ui32Runs ? psTask->ui64Cycles / psTask->ui32Runs / ui32CyclesPerUs : 0);
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, psTask->ui32MaxCycles / ui32CyclesPerUs);
+        UARTStringPut(UART0_BASE, "\n\r");
     }
+}
+
+// Calls, share of the last load window and longest run of every instrumented handler
+void ShowIsrStats(void)
+{
+    uint32_t ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    uint32_t i;
 
-    if (value < 0)
+    for (i = 0; i < ISR_COUNT; i++)
     {
-        result[resultCount++] = '-';
-        value *= -1;
+        const tLoadIsrInfo *psIsr = LOAD_IsrGet(i);
+
+        UARTStringPut(UART0_BASE, (char *)psIsr->pcName);
+        UARTStringPut(UART0_BASE, " isr calls: ");
+        UARTIntPut(UART0_BASE, psIsr->ui32Count);
+        UARTStringPut(UART0_BASE, " load (1/1000): ");
+        UARTIntPut(UART0_BASE, psIsr->ui32Permille);
+        UARTStringPut(UART0_BASE, " max (us): ");
+        UARTIntPut(UART0_BASE, psIsr->ui32MaxCycles / ui32CyclesPerUs);
+        UARTStringPut(UART0_BASE, "\n\r");
     }
+}
 
-    // Covert to char from LSB
-    while (value > 0)
+void ShowStats(void)
+{
+    tTelemetryStats sTelemetry;
+    tSyncStats sSync;
+    uint32_t ui32ElapsedMs = TIME_Ms();
+
+    TELEMETRY_StatsGet(&sTelemetry);
+    SYNC_StatsGet(&sSync);
+
+    UARTStringPut(UART0_BASE, "samples: ");
+    UARTIntPut(UART0_BASE, sTelemetry.ui32Samples);
+    UARTStringPut(UART0_BASE, " suppressed: ");
+    UARTIntPut(UART0_BASE, sTelemetry.ui32Suppressed);
+    UARTStringPut(UART0_BASE, " frames: ");
+    UARTIntPut(UART0_BASE, sTelemetry.ui32Frames);
+    UARTStringPut(UART0_BASE, " bytes: ");
+    UARTIntPut(UART0_BASE, sTelemetry.ui32Bytes);
+    UARTStringPut(UART0_BASE, " link use (1/1000): ");
+    UARTIntPut(UART0_BASE, TELEMETRY_UtilizationGet(HC05_BaudGet(), ui32ElapsedMs));
+    UARTStringPut(UART0_BASE, "\n\r");
+
+    UARTStringPut(UART0_BASE, "pings: ");
+    UARTIntPut(UART0_BASE, sSync.ui32Pings);
+    UARTStringPut(UART0_BASE, " pongs: ");
+    UARTIntPut(UART0_BASE, sSync.ui32Pongs);
+    UARTStringPut(UART0_BASE, " rtt p50/p90/p99/max (us): ");
+    UARTIntPut(UART0_BASE, sSync.ui32RttP50);
+    UARTStringPut(UART0_BASE, "/");
+    UARTIntPut(UART0_BASE, sSync.ui32RttP90);
+    UARTStringPut(UART0_BASE, "/");
+    UARTIntPut(UART0_BASE, sSync.ui32RttP99);
+    UARTStringPut(UART0_BASE, "/");
+    UARTIntPut(UART0_BASE, sSync.ui32RttMax);
+    UARTStringPut(UART0_BASE, "\n\r");
+
+    UARTStringPut(UART0_BASE, "clock offset (cycles): ");
+    UARTIntPut(UART0_BASE, sSync.i32Offset);
+    UARTStringPut(UART0_BASE, " drift (ppb): ");
+    UARTIntPut(UART0_BASE, sSync.i32DriftPpb);
+    UARTStringPut(UART0_BASE, "\n\r");
+
+    UARTStringPut(UART0_BASE, "cpu load mean/peak (1/1000): ");
+    UARTIntPut(UART0_BASE, LOAD_Permille());
+    UARTStringPut(UART0_BASE, "/");
+    UARTIntPut(UART0_BASE, LOAD_PeakPermille());
+    UARTStringPut(UART0_BASE, " slave: ");
+    UARTIntPut(UART0_BASE, LOAD_RemotePermille());
+    UARTStringPut(UART0_BASE, "/");
+    UARTIntPut(UART0_BASE, LOAD_RemotePeakPermille());
+    UARTStringPut(UART0_BASE, "\n\r");
+
+    ShowTaskStats();
+    ShowIsrStats();
+}
+
+// Traffic, acknowledgements and load of every slave
+void ShowNodeStats(void)
+{
+    uint32_t ui32Now = TIME_Ms();
+    uint32_t i;
+
+    for (i = 0; i < NODE_Count(); i++)
     {
-        temp[tempCount++] = (value % 10) + '0';
-        value /= 10;
+        const tNode *psNode = NODE_Get(i);
+
+        UARTStringPut(UART0_BASE, "node ");
+        UARTIntPut(UART0_BASE, psNode->ui8Addr);
+        UARTStringPut(UART0_BASE, " frames: ");
+        UARTIntPut(UART0_BASE, psNode->ui32Frames);
+        UARTStringPut(UART0_BASE, " bytes: ");
+        UARTIntPut(UART0_BASE, psNode->ui32Bytes);
+        UARTStringPut(UART0_BASE, " acked: ");
+        UARTIntPut(UART0_BASE, psNode->ui32Acked);
+        UARTStringPut(UART0_BASE, " retries: ");
+        UARTIntPut(UART0_BASE, psNode->ui32Retries);
+        UARTStringPut(UART0_BASE, " dropped: ");
+        UARTIntPut(UART0_BASE, psNode->ui32Dropped);
+        UARTStringPut(UART0_BASE, " replaced: ");
+        UARTIntPut(UART0_BASE, psNode->ui32Replaced);
+        UARTStringPut(UART0_BASE, " load/peak (1/1000): ");
+        UARTIntPut(UART0_BASE, psNode->ui32Load);
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, psNode->ui32PeakLoad);
+        UARTStringPut(UART0_BASE, " last heard (ms ago): ");
+        UARTIntPut(UART0_BASE, psNode->ui32LastHeard ? ui32Now - psNode->ui32LastHeard : -1);
+        UARTStringPut(UART0_BASE, "\n\r");
     }
+    UARTStringPut(UART0_BASE, "filtered: ");
+    UARTIntPut(UART0_BASE, linkParser.ui32Filtered);
+    UARTStringPut(UART0_BASE, " link errors: ");
+    UARTIntPut(UART0_BASE, linkParser.ui32Errors);
+    UARTStringPut(UART0_BASE, "\n\r");
+}
+
+// DMA completions and the receive timeout of the link
+void LinkIntHandler(void)
+{
+    uint32_t ui32Start = LOAD_IsrBegin();
 
-    // Put back the result from MSB
-    while (--tempCount >= 0)
+    if (DMAUART_IntHandler(UART5_BASE) & DMAUART_EVENT_RX)
+        SCHED_Post(TASK_LINK);
+    LOAD_IsrEnd(ISR_LINK, ui32Start);
+}
+
+// DMA traffic of the link
+void ShowDmaStats(void)
+{
+    tDmaUartStats sStats;
+
+    DMAUART_StatsGet(UART5_BASE, &sStats);
+    UARTStringPut(UART0_BASE, "dma rx bytes: ");
+    UARTIntPut(UART0_BASE, sStats.ui32RxBytes);
+    UARTStringPut(UART0_BASE, " buffers: ");
+    UARTIntPut(UART0_BASE, sStats.ui32RxBuffers);
+    UARTStringPut(UART0_BASE, " timeouts: ");
+    UARTIntPut(UART0_BASE, sStats.ui32RxTimeouts);
+    UARTStringPut(UART0_BASE, " starved: ");
+    UARTIntPut(UART0_BASE, sStats.ui32RxStarved);
+    UARTStringPut(UART0_BASE, "\n\r");
+    UARTStringPut(UART0_BASE, "dma tx bytes: ");
+    UARTIntPut(UART0_BASE, sStats.ui32TxBytes);
+    UARTStringPut(UART0_BASE, " transfers: ");
+    UARTIntPut(UART0_BASE, sStats.ui32TxTransfers);
+    UARTStringPut(UART0_BASE, " waits: ");
+    UARTIntPut(UART0_BASE, sStats.ui32TxWaits);
+    UARTStringPut(UART0_BASE, " console dropped: ");
+    UARTIntPut(UART0_BASE, consoleRxDropped);
+    UARTStringPut(UART0_BASE, "\n\r");
+}
+
+// CPU cycles per byte on the link UART, polled vs FIFO interrupts vs DMA.
+// The link is down for the few ms this takes.
+void RunDmaBenchmark(void)
+{
+    tDmaUartBench sBench;
+
+    DMAUART_Benchmark(UART5_BASE, DMAUART_BENCH_MAX, &sBench);
+    UARTIntRegister(UART5_BASE, LinkIntHandler);
+
+    UARTStringPut(UART0_BASE, "cycles/byte polled: ");
+    UARTIntPut(UART0_BASE, sBench.ui32PolledCycles / sBench.ui32Bytes);
+    UARTStringPut(UART0_BASE, " interrupt: ");
+    UARTIntPut(UART0_BASE, sBench.ui32IntCycles / sBench.ui32Bytes);
+    UARTStringPut(UART0_BASE, " (");
+    UARTIntPut(UART0_BASE, sBench.ui32IntCount);
+    UARTStringPut(UART0_BASE, " isr) dma: ");
+    UARTIntPut(UART0_BASE, sBench.ui32DmaCycles / sBench.ui32Bytes);
+    UARTStringPut(UART0_BASE, " (");
+    UARTIntPut(UART0_BASE, sBench.ui32DmaCount);
+    UARTStringPut(UART0_BASE, " isr) over ");
+    UARTIntPut(UART0_BASE, sBench.ui32Bytes);
+    UARTStringPut(UART0_BASE, " bytes\n\r");
+}
+
+// Single character commands from the PC
+void ConsoleTask(void)
+{
+    uint8_t c;
+
+    while (RING_Pop(&consoleRx, &c))
     {
-        result[resultCount++] = temp[tempCount];
+        if (c == 's' || c == 'S')
+            ShowStats();
+        else if (c == 'n' || c == 'N')
+            ShowNodeStats();
+        else if (c == 'd' || c == 'D')
+            ShowDmaStats();
+        else if (c == 'b' || c == 'B')
+            RunDmaBenchmark();
     }
-    result[resultCount] = '\0';
+}
 
-    UARTStringPut(ui32Base, result);
+// Frames from the slaves, parsed straight out of the DMA buffers
+void LinkTask(void)
+{
+    const uint8_t *pui8Data;
+    uint32_t ui32Len, i;
+
+    while (DMAUART_RxGet(UART5_BASE, &pui8Data, &ui32Len))
+    {
+        for (i = 0; i < ui32Len; i++)
+        {
+            if (LINK_Parse(&linkParser, pui8Data[i]) != LINK_FRAME_READY)
+                continue;
+
+            NODE_HandleFrame(&linkParser.sFrame, TIME_Ms());
+            if (linkParser.sFrame.ui8Type == LINK_TYPE_PONG)
+                SYNC_HandlePong(&linkParser.sFrame, SYNC_Cycles());
+            else if (linkParser.sFrame.ui8Type == LINK_TYPE_STATUS)
+                LOAD_HandleStatus(&linkParser.sFrame);
+        }
+        DMAUART_RxRelease(UART5_BASE);
+    }
 }
 
+// Empties the FIFO into the console ring, a full ring drops the bytes
+void ConsoleIntHandler(void)
+{
+    uint32_t ui32Start = LOAD_IsrBegin();
+
+    UARTIntClear(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    while (UARTCharsAvail(UART0_BASE))
+    {
+        if (!RING_Push(&consoleRx, (uint8_t)UARTCharGetNonBlocking(UART0_BASE)))
+            consoleRxDropped++;
+    }
+    SCHED_Post(TASK_CONSOLE);
+    LOAD_IsrEnd(ISR_CONSOLE, ui32Start);
+}
+
+// UART5 rates tried with the HC-05 at boot, fastest first
+static const uint32_t HC05_RATES[] = { 460800, 230400, 115200 };
+
 void InitializeUART(void)
 {
-    // enable UART5 and GPIOE
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART5);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-
-    // Configure board PE4 for RX
-    // configure board PE5 for TX
-    GPIOPinConfigure(GPIO_PE4_U5RX);
-    GPIOPinConfigure(GPIO_PE5_U5TX);
-    // set PORTE pin4 and pin5 as UART type
-    GPIOPinTypeUART(GPIO_PORTE_BASE, GPIO_PIN_4 | GPIO_PIN_5);
-
-    // set UART base addr., system clock, baud rate
-    // used to communicate with HC-05
-    UARTConfigSetExpClk(UART5_BASE, SysCtlClockGet(), 38400,
+    // enable UART0 and GPIOA, used for the statistics console on the PC
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+
+    // Configure PA0 for RX
+    // Configure PA1 for TX
+    GPIOPinConfigure(GPIO_PA0_U0RX);
+    GPIOPinConfigure(GPIO_PA1_U0TX);
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+    UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 115200,
                         (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
 
-    GPIOPinTypeGPIOOutput(GPIO_PORTE_BASE, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
-    GPIOPinWrite(GPIO_PORTE_BASE, GPIO_PIN_2 | GPIO_PIN_1 | GPIO_PIN_3, 2);
+    // UART5 is used to communicate with HC-05,
+    // raise its rate from the 38400 baud default as far as the module allows
+    HC05_Init();
+    HC05_Configure(HC05_RATES, sizeof(HC05_RATES) / sizeof(HC05_RATES[0]));
+    linkBudget = HC05_BaudGet() / 10 / SAMPLE_HZ * LINK_BUDGET_PERCENT / 100;
+
+    // receive console commands and replies from the slave
+    LINK_ParserInit(&linkParser);
+    RING_Init(&consoleRx, consoleRxBuffer, CONSOLE_RING_SIZE);
+    UARTIntRegister(UART0_BASE, ConsoleIntHandler);
+    UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    DMAUART_Init(UART5_BASE);
+    LINK_TransportSet(DMAUART_Write);
+    UARTIntRegister(UART5_BASE, LinkIntHandler);
 }
 
 /*
@@ -117,11 +392,22 @@ void InitializeUART(void)
 #define INIT_YAW_ANGLE 55
 #define MAX_YAW_ANGLE 89
 
+// Telemetry to the slave: minimum change worth sending (degrees),
+// and samples between two keyframes, which also serve as heartbeat
+#define TELEMETRY_DEADBAND 1
+#define TELEMETRY_KEYFRAME_PERIOD 100
+// ... and minimum change of angular rate worth sending (0.1 deg/s)
+#define TELEMETRY_RATE_DEADBAND 20
+
+
 // Storing the data from the MPU and the data to be sent via UART
 int X = 0, Y = 0, Z = 0, pitch = 0, yaw = 0;
 
 int lastX = 0, lastY = 0, lastZ = 0;
 
+// Angular rates of the pitch and yaw axes (deg/s), sent along so the slave can extrapolate
+float pitchRate = 0.0f, yawRate = 0.0f;
+
 // A boolean that is set when a MPU6050 command has completed.
 volatile bool g_bMPU6050Done;
 
@@ -218,6 +504,8 @@ void GetMPU6050Data(int *pitch, int *roll, int *yaw)
         integralX += gyroX * dt_2;
         integralY += gyroY * dt_2;
         integralZ += gyroZ * dt_2;
+        pitchRate = gyroX;
+        yawRate = gyroZ;
         if (integralX > 360)
             integralX -= 360;
         if (integralX < -360)
@@ -271,32 +559,102 @@ void InitI2C0(void)
     I2CMInit(&g_sI2CMSimpleInst, I2C0_BASE, INT_I2C0, 0xff, 0xff, SysCtlClockGet());
 }
 
+void ButtonTask(void)
+{
+    tButtonEvent event;
+
+    while (BUTTON_EventGet(&event))
+    {
+        if (event.ui8Type != BUTTON_EVENT_PRESS)
+            continue;
+
+        // Reset data
+        lastX = 0, lastY = 0, lastZ = 0, X= 0, Y = 0, Z= 0;
+        gyroX_offset = 0.0f, gyroY_offset = 0.0f, gyroZ_offset = 0.0f;
+    }
+}
+
+// Debounced button events are queued from the SysTick interrupt
+void ButtonNotify(void)
+{
+    SCHED_Post(TASK_BUTTON);
+}
+
+// Only wakes the debounce, the edge stays masked while it samples
 void ButtonIntHandler(void)
 {
-    GPIOIntClear(GPIO_PORTF_BASE, GPIO_INT_PIN_4 | GPIO_INT_PIN_0);
-    // Reset data
-    lastX = 0, lastY = 0, lastZ = 0, X= 0, Y = 0, Z= 0;
-    gyroX_offset = 0.0f, gyroY_offset = 0.0f, gyroZ_offset = 0.0f;
+    uint32_t ui32Start = LOAD_IsrBegin();
+
+    BUTTON_IntHandler();
+    LOAD_IsrEnd(ISR_BUTTON, ui32Start);
 }
 
 void InitializeButton(void)
 {
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
-    HWREG(GPIO_PORTF_BASE + GPIO_O_CR)  |= 0x01;
-    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = 0;
-    GPIODirModeSet(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0, GPIO_DIR_MODE_IN);
-    GPIOPadConfigSet(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
-    GPIOIntEnable(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0);                 // interrupt enable
-    GPIOIntTypeSet(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0, GPIO_FALLING_EDGE); // only interrupt at falling edge (pressed)
+    BUTTON_Init(GPIO_PORTF_BASE, GPIO_PIN_4 | GPIO_PIN_0, ButtonNotify);
     GPIOIntRegister(GPIO_PORTF_BASE, ButtonIntHandler);           // dynamic isr registering
 }
 
+tTWheelTimer sampleTimer;
+
+// Runs in the timer wheel interrupt
+void SampleTick(void *pvData)
+{
+    uint32_t ui32Start = LOAD_IsrBegin();
+
+    SCHED_Post(TASK_SAMPLE);
+    LOAD_IsrEnd(ISR_SAMPLE, ui32Start);
+}
+
+// Paces the sampling, so the integration step dt_2 holds
+void InitializeSampleTimer(void)
+{
+    TWHEEL_TimerInit(&sampleTimer, SampleTick, 0);
+    TWHEEL_TimerStart(&sampleTimer, SAMPLE_PERIOD_US, SAMPLE_PERIOD_US);
+}
+
+void SampleTask(void)
+{
+    tTelemetryStats sTelemetry;
+    uint8_t pui8Status[LOAD_STATUS_MAX];
+    uint32_t ui32Len, ui32Used, i;
+
+    // Get the data from the MPU
+    GetMPU6050Data(&X, &Y, &Z);
+
+    // Normalize the data
+    GetNormalizedPitchYaw(X, Y, Z, &pitch, &yaw);
+
+    // Send the data to UART5, only if an axis moved past the deadband
+    sampleCount++;
+    if (sampleCount % PING_PERIOD == 0)
+        SYNC_SendPing(UART5_BASE, NODE_ADDRS[0]);
+    if (sampleCount % STATUS_PERIOD == 0)
+    {
+        // every slave answers its own poll with its load
+        ui32Len = LOAD_StatusEncode(pui8Status);
+        for (i = 0; i < NODE_Count(); i++)
+            NODE_Post(i, LINK_TYPE_STATUS, pui8Status, (uint8_t)ui32Len, 0);
+    }
+    TELEMETRY_Update(yaw, pitch, (int32_t)(yawRate * 10), (int32_t)(pitchRate * 10),
+                     (uint16_t)((uint64_t)sampleCount * SAMPLE_PERIOD_US / 1000));
+
+    // per-node frames share what the telemetry left of the budget
+    TELEMETRY_StatsGet(&sTelemetry);
+    ui32Used = sTelemetry.ui32Bytes - telemetryBytes;
+    telemetryBytes = sTelemetry.ui32Bytes;
+    if (ui32Used < linkBudget)
+        NODE_Service(linkBudget - ui32Used, TIME_Ms());
+}
+
 /*
  * Main System
  */
 void Initialize(void)
 {
+    uint32_t i;
+
     // Initialize Data
     yaw = INIT_YAW_ANGLE;
     pitch = INIT_PITCH_ANGLE;
@@ -304,48 +662,63 @@ void Initialize(void)
     // set clock
     SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
 
+    // Millisecond timebase
+    TIME_Init();
+
+    // Periodic activities share TIMER0
+    TWHEEL_Init();
+
+    // Everything but acknowledging interrupts runs as a task
+    SCHED_Init();
+    SCHED_TaskAdd(TASK_LINK, "link", LinkTask, true);
+    SCHED_TaskAdd(TASK_SAMPLE, "sample", SampleTask, false);
+    SCHED_TaskAdd(TASK_BUTTON, "button", ButtonTask, false);
+    SCHED_TaskAdd(TASK_CONSOLE, "console", ConsoleTask, false);
+
+    // Idle and interrupt time
+    LOAD_Init();
+    LOAD_IsrAdd(ISR_CONSOLE, "console");
+    LOAD_IsrAdd(ISR_LINK, "link");
+    LOAD_IsrAdd(ISR_BUTTON, "button");
+    LOAD_IsrAdd(ISR_SAMPLE, "sample");
+    LOAD_IsrAdd(ISR_I2C, "i2c");
+
     InitializeButton();
 
+    // Cycle counter for link timing
+    SYNC_Init();
+
+    // Slaves addressed by the master
+    NODE_Init(UART5_BASE);
+    for (i = 0; i < sizeof(NODE_ADDRS) / sizeof(NODE_ADDRS[0]); i++)
+        NODE_Add(NODE_ADDRS[i]);
+
     // Initialize UART
     InitializeUART();
+    TELEMETRY_Init(UART5_BASE, TELEMETRY_DEADBAND, TELEMETRY_RATE_DEADBAND, TELEMETRY_KEYFRAME_PERIOD);
 
     // initialize I2C, you may do not care this part
     InitI2C0();
 
     // Initialize MPU6050
     InitializeMPU();
+
+    InitializeSampleTimer();
 }
 
 int main(void)
 {
     Initialize();
 
-    while (1)
-    {
-    }
+    // Never returns, sleeps whenever no task is pending
+    SCHED_Run();
 }
 
 void I2CIntHandler(void)
 {
+    uint32_t ui32Start = LOAD_IsrBegin();
+
     // Call the I2C master driver interrupt handler.
     I2CMIntHandler(&g_sI2CMSimpleInst);
-
-    // Get the data from the MPU
-    GetMPU6050Data(&X, &Y, &Z);
-
-    // Normalize the data
-    GetNormalizedPitchYaw(X, Y, Z, &pitch, &yaw);
-
-    // Send the data to UART5
-    UARTCharPut(UART5_BASE, 'y');
-    UARTIntPut(UART5_BASE, yaw);
-    UARTStringPut(UART5_BASE, "\n\r");
-
-    delayMS(5);
-
-    UARTCharPut(UART5_BASE, 'p');
-    UARTIntPut(UART5_BASE, pitch);
-    UARTStringPut(UART5_BASE, "\n\r");
-
-    delayMS(5);
+    LOAD_IsrEnd(ISR_I2C, ui32Start);
 }
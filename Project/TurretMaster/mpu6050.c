@@ -159,6 +159,18 @@ void MPU6050_Calib_Set(int32_t a_x, int32_t a_y, int32_t a_z, int32_t g_x, int32
     gyro_z_calib  = g_z;
 }
 
+/*
+ * Get the sensitivities of the full scale ranges selected in MPU6050_Config()
+ * @param <double*> $accel_lsb_g LSB per g
+ * @param <double*> $gyro_lsb_deg LSB per deg/sec
+ * @return void
+ */
+void MPU6050_Scale_Get(double *accel_lsb_g, double *gyro_lsb_deg)
+{
+    *accel_lsb_g  = accel_scale;
+    *gyro_lsb_deg = gyro_scale;
+}
+
 /*
  * Read raw data from MPU6050, subtracted by the measured initial offsets
  * @param <int16_t*> $accel_x, $accel_y, $accel_z, $gyro_x, $gyro_y, $gyro_z, $temp
@@ -0,0 +1,567 @@
+/*
+ * DMAUART.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "DMAUART.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_uart.h"
+
+#define DMAUART_DWT_CYCCNT  0xE0001004
+
+// exception entry and return without FPU context, added to every handler run
+#define DMAUART_EXC_CYCLES  24
+
+#define DMAUART_NONE        0xFFFFFFFF
+
+typedef struct
+{
+    uint32_t ui32Base;
+    uint32_t ui32Int;
+    uint32_t ui32RxChannel;
+    uint32_t ui32TxChannel;
+    bool bStarted;
+
+    // receive buffers: two belong to the DMA, filled ones wait in the ready ring
+    uint8_t ppui8Rx[DMAUART_RX_BUFS][DMAUART_RX_SIZE];
+    uint32_t pui32RxLen[DMAUART_RX_BUFS];
+    uint32_t ui32RxFree;                // bit per free buffer
+    uint32_t ui32RxPri, ui32RxAlt;      // buffers of the primary / alternate structure
+    bool bRxAlt;                        // the alternate structure is filling
+    uint32_t pui32Ready[DMAUART_RX_BUFS];
+    uint32_t ui32ReadyHead;
+    volatile uint32_t ui32ReadyCount;
+
+    // transmit slots, the oldest ui32TxInFlight of them are on the wire
+    uint8_t ppui8Tx[DMAUART_TX_SLOTS][DMAUART_TX_SIZE];
+    uint32_t pui32TxLen[DMAUART_TX_SLOTS];
+    uint32_t ui32TxHead;
+    volatile uint32_t ui32TxCount;
+    uint32_t ui32TxInFlight;
+    tDMAControlTable psTxTasks[DMAUART_TX_SLOTS];
+
+    tDmaUartStats sStats;
+} tDmaUartPort;
+
+static tDmaUartPort g_psPorts[2];
+
+// one control table for all channels, 1024 byte aligned
+#if defined(ewarm)
+#pragma data_alignment=1024
+static tDMAControlTable g_psControlTable[64];
+#elif defined(ccs)
+#pragma DATA_ALIGN(g_psControlTable, 1024)
+static tDMAControlTable g_psControlTable[64];
+#else
+static tDMAControlTable g_psControlTable[64] __attribute__ ((aligned(1024)));
+#endif
+
+static bool g_bDMAEnabled = false;
+
+// loopback benchmark, shared with its interrupt handler
+static uint8_t g_pui8BenchTx[DMAUART_BENCH_MAX];
+static uint8_t g_pui8BenchRx[DMAUART_BENCH_MAX];
+static tDmaUartPort *g_psBenchPort;
+static bool g_bBenchDma;
+static uint32_t g_ui32BenchBytes, g_ui32BenchSent, g_ui32BenchReceived;
+static uint32_t g_ui32BenchCycles, g_ui32BenchCount;
+static volatile bool g_bBenchDone;
+
+static uint32_t DMAUART_Cycles(void)
+{
+    return HWREG(DMAUART_DWT_CYCCNT);
+}
+
+static tDmaUartPort *DMAUART_Port(uint32_t ui32Base)
+{
+    return ui32Base == UART0_BASE ? &g_psPorts[0] : &g_psPorts[1];
+}
+
+/*
+ * Take a free receive buffer
+ */
+static uint32_t DMAUART_RxAlloc(tDmaUartPort *psPort)
+{
+    uint32_t i;
+
+    for (i = 0; i < DMAUART_RX_BUFS; i++)
+    {
+        if (psPort->ui32RxFree & (1 << i))
+        {
+            psPort->ui32RxFree &= ~(1 << i);
+            return i;
+        }
+    }
+    psPort->sStats.ui32RxStarved++;
+    return DMAUART_NONE;
+}
+
+static void DMAUART_RxArm(tDmaUartPort *psPort, uint32_t ui32Select, uint32_t ui32Buf)
+{
+    uDMAChannelControlSet(psPort->ui32RxChannel | ui32Select,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_8);
+    uDMAChannelTransferSet(psPort->ui32RxChannel | ui32Select, UDMA_MODE_PINGPONG,
+                           (void *)(psPort->ui32Base + UART_O_DR), psPort->ppui8Rx[ui32Buf], DMAUART_RX_SIZE);
+}
+
+/*
+ * Queue a filled buffer for DMAUART_RxGet()
+ */
+static void DMAUART_RxReady(tDmaUartPort *psPort, uint32_t ui32Buf, uint32_t ui32Len)
+{
+    psPort->pui32RxLen[ui32Buf] = ui32Len;
+    psPort->pui32Ready[(psPort->ui32ReadyHead + psPort->ui32ReadyCount) % DMAUART_RX_BUFS] = ui32Buf;
+    psPort->ui32ReadyCount++;
+    psPort->sStats.ui32RxBytes += ui32Len;
+    psPort->sStats.ui32RxBuffers++;
+}
+
+/*
+ * Start the stopped RX channel over, on the primary structure. The buffer of
+ * the structure that was filling must have been handed over already.
+ */
+static void DMAUART_RxRestart(tDmaUartPort *psPort)
+{
+    uint32_t ui32Idle = psPort->bRxAlt ? psPort->ui32RxPri : psPort->ui32RxAlt;
+
+    psPort->ui32RxPri = ui32Idle != DMAUART_NONE ? ui32Idle : DMAUART_RxAlloc(psPort);
+    psPort->ui32RxAlt = DMAUART_RxAlloc(psPort);
+    psPort->bRxAlt = false;
+
+    if (psPort->ui32RxPri == DMAUART_NONE)
+    {
+        // nowhere to put data, the receive timeout would only fire again
+        UARTIntDisable(psPort->ui32Base, UART_INT_RT);
+        return;
+    }
+    DMAUART_RxArm(psPort, UDMA_PRI_SELECT, psPort->ui32RxPri);
+    if (psPort->ui32RxAlt != DMAUART_NONE)
+        DMAUART_RxArm(psPort, UDMA_ALT_SELECT, psPort->ui32RxAlt);
+    uDMAChannelAttributeDisable(psPort->ui32RxChannel, UDMA_ATTR_ALTSELECT);
+    uDMAChannelEnable(psPort->ui32RxChannel);
+    UARTIntEnable(psPort->ui32Base, UART_INT_RT);
+}
+
+/*
+ * Hand over the buffers the DMA filled, in the order they were filled
+ */
+static bool DMAUART_RxComplete(tDmaUartPort *psPort)
+{
+    bool bReady = false;
+
+    for (;;)
+    {
+        uint32_t ui32Select = psPort->bRxAlt ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        uint32_t *pui32Buf = psPort->bRxAlt ? &psPort->ui32RxAlt : &psPort->ui32RxPri;
+
+        if (*pui32Buf == DMAUART_NONE || uDMAChannelModeGet(psPort->ui32RxChannel | ui32Select) != UDMA_MODE_STOP)
+            return bReady;
+
+        DMAUART_RxReady(psPort, *pui32Buf, DMAUART_RX_SIZE);
+        *pui32Buf = DMAUART_RxAlloc(psPort);
+        if (*pui32Buf != DMAUART_NONE)
+            DMAUART_RxArm(psPort, ui32Select, *pui32Buf);
+        psPort->bRxAlt = !psPort->bRxAlt;
+        bReady = true;
+    }
+}
+
+/*
+ * Close the filling buffer after the receive timeout, with the bytes of the
+ * unfinished burst that are still in the FIFO
+ */
+static bool DMAUART_RxTimeout(tDmaUartPort *psPort)
+{
+    uint32_t ui32Select = psPort->bRxAlt ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+    uint32_t *pui32Buf = psPort->bRxAlt ? &psPort->ui32RxAlt : &psPort->ui32RxPri;
+    uint8_t *pui8Data;
+    uint32_t ui32Len;
+
+    uDMAChannelDisable(psPort->ui32RxChannel);
+    if (*pui32Buf == DMAUART_NONE)
+    {
+        DMAUART_RxRestart(psPort);
+        return false;
+    }
+
+    pui8Data = psPort->ppui8Rx[*pui32Buf];
+    ui32Len = DMAUART_RX_SIZE - uDMAChannelSizeGet(psPort->ui32RxChannel | ui32Select);
+    while (ui32Len < DMAUART_RX_SIZE && UARTCharsAvail(psPort->ui32Base))
+        pui8Data[ui32Len++] = (uint8_t)UARTCharGetNonBlocking(psPort->ui32Base);
+    if (!ui32Len)
+    {
+        uDMAChannelEnable(psPort->ui32RxChannel);
+        return false;
+    }
+
+    DMAUART_RxReady(psPort, *pui32Buf, ui32Len);
+    psPort->sStats.ui32RxTimeouts++;
+    *pui32Buf = DMAUART_NONE;
+    DMAUART_RxRestart(psPort);
+    return true;
+}
+
+/*
+ * Put every queued slot on the wire as one scatter-gather transfer, call
+ * with the port's interrupt masked
+ */
+static void DMAUART_TxKick(tDmaUartPort *psPort)
+{
+    uint32_t ui32Count = psPort->ui32TxCount;
+    uint32_t i;
+
+    if (psPort->ui32TxInFlight || !ui32Count)
+        return;
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        uint32_t ui32Slot = (psPort->ui32TxHead + i) % DMAUART_TX_SLOTS;
+
+        psPort->psTxTasks[i] = (tDMAControlTable)uDMATaskStructEntry(
+            psPort->pui32TxLen[ui32Slot], UDMA_SIZE_8, UDMA_SRC_INC_8, psPort->ppui8Tx[ui32Slot],
+            UDMA_DST_INC_NONE, (void *)(psPort->ui32Base + UART_O_DR), UDMA_ARB_4,
+            i == ui32Count - 1 ? UDMA_MODE_BASIC : UDMA_MODE_PER_SCATTER_GATHER);
+    }
+    uDMAChannelScatterGatherSet(psPort->ui32TxChannel, ui32Count, psPort->psTxTasks, 1);
+    uDMAChannelEnable(psPort->ui32TxChannel);
+
+    psPort->ui32TxInFlight = ui32Count;
+    psPort->sStats.ui32TxTransfers++;
+}
+
+/*
+ * Channel setup, RX started, nothing queued for TX
+ */
+static void DMAUART_PortStart(tDmaUartPort *psPort)
+{
+    uint32_t ui32Base = psPort->ui32Base;
+
+    uDMAChannelAssign(psPort->ui32RxChannel);
+    uDMAChannelAssign(psPort->ui32TxChannel);
+    uDMAChannelAttributeDisable(psPort->ui32RxChannel, UDMA_ATTR_ALL);
+    uDMAChannelAttributeDisable(psPort->ui32TxChannel, UDMA_ATTR_ALL);
+    // only whole bursts, the rest waits for the receive timeout
+    uDMAChannelAttributeEnable(psPort->ui32RxChannel, UDMA_ATTR_USEBURST);
+
+    psPort->ui32RxFree = (1 << DMAUART_RX_BUFS) - 1;
+    psPort->ui32RxPri = psPort->ui32RxAlt = DMAUART_NONE;
+    psPort->bRxAlt = false;
+    psPort->ui32ReadyHead = 0;
+    psPort->ui32ReadyCount = 0;
+    psPort->ui32TxHead = 0;
+    psPort->ui32TxCount = 0;
+    psPort->ui32TxInFlight = 0;
+
+    UARTFIFOLevelSet(ui32Base, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+    UARTIntDisable(ui32Base, UART_INT_RX | UART_INT_TX);
+    UARTDMAEnable(ui32Base, UART_DMA_RX | UART_DMA_TX);
+    DMAUART_RxRestart(psPort);
+    psPort->bStarted = true;
+}
+
+/*
+ * Move a UART onto the DMA, call before registering its interrupt handler
+ * @param <uint32_t> $ui32Base UART0_BASE or UART5_BASE, already configured
+ * @return void
+ */
+void DMAUART_Init(uint32_t ui32Base)
+{
+    tDmaUartPort *psPort = DMAUART_Port(ui32Base);
+
+    if (!g_bDMAEnabled)
+    {
+        SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+        uDMAEnable();
+        uDMAControlBaseSet(g_psControlTable);
+        g_bDMAEnabled = true;
+    }
+
+    psPort->ui32Base = ui32Base;
+    if (ui32Base == UART0_BASE)
+    {
+        psPort->ui32Int = INT_UART0;
+        psPort->ui32RxChannel = UDMA_CH8_UART0RX;
+        psPort->ui32TxChannel = UDMA_CH9_UART0TX;
+    }
+    else
+    {
+        psPort->ui32Int = INT_UART5;
+        psPort->ui32RxChannel = UDMA_CH6_UART5RX;
+        psPort->ui32TxChannel = UDMA_CH7_UART5TX;
+    }
+    psPort->sStats = (tDmaUartStats){ 0 };
+    DMAUART_PortStart(psPort);
+}
+
+/*
+ * Work of the port's UART interrupt: DMA completions and the receive timeout
+ * @param <uint32_t> $ui32Base UART of the port
+ * @return <uint32_t> DMAUART_EVENT_RX / DMAUART_EVENT_TX
+ */
+uint32_t DMAUART_IntHandler(uint32_t ui32Base)
+{
+    tDmaUartPort *psPort = DMAUART_Port(ui32Base);
+    uint32_t ui32Status = UARTIntStatus(ui32Base, true);
+    uint32_t ui32Events = 0;
+
+    UARTIntClear(ui32Base, ui32Status);
+
+    if (DMAUART_RxComplete(psPort))
+        ui32Events |= DMAUART_EVENT_RX;
+    if ((ui32Status & UART_INT_RT) && DMAUART_RxTimeout(psPort))
+        ui32Events |= DMAUART_EVENT_RX;
+
+    if (psPort->ui32TxInFlight && !uDMAChannelIsEnabled(psPort->ui32TxChannel))
+    {
+        psPort->ui32TxHead = (psPort->ui32TxHead + psPort->ui32TxInFlight) % DMAUART_TX_SLOTS;
+        psPort->ui32TxCount -= psPort->ui32TxInFlight;
+        psPort->ui32TxInFlight = 0;
+        DMAUART_TxKick(psPort);
+        ui32Events |= DMAUART_EVENT_TX;
+    }
+
+    return ui32Events;
+}
+
+/*
+ * Oldest received buffer, read in place
+ * @param <uint32_t> $ui32Base UART of the port
+ * @param <const uint8_t **> $ppui8Data set to the data
+ * @param <uint32_t *> $pui32Len set to the number of bytes
+ * @return <bool> false if nothing was received
+ */
+bool DMAUART_RxGet(uint32_t ui32Base, const uint8_t **ppui8Data, uint32_t *pui32Len)
+{
+    tDmaUartPort *psPort = DMAUART_Port(ui32Base);
+    uint32_t ui32Buf;
+
+    if (!psPort->ui32ReadyCount)
+        return false;
+
+    ui32Buf = psPort->pui32Ready[psPort->ui32ReadyHead];
+    *ppui8Data = psPort->ppui8Rx[ui32Buf];
+    *pui32Len = psPort->pui32RxLen[ui32Buf];
+    return true;
+}
+
+/*
+ * Give the buffer of the last DMAUART_RxGet() back to the DMA
+ * @param <uint32_t> $ui32Base UART of the port
+ * @return void
+ */
+void DMAUART_RxRelease(uint32_t ui32Base)
+{
+    tDmaUartPort *psPort = DMAUART_Port(ui32Base);
+    uint32_t *pui32Idle;
+
+    IntDisable(psPort->ui32Int);
+    psPort->ui32RxFree |= 1 << psPort->pui32Ready[psPort->ui32ReadyHead];
+    psPort->ui32ReadyHead = (psPort->ui32ReadyHead + 1) % DMAUART_RX_BUFS;
+    psPort->ui32ReadyCount--;
+
+    // a starved channel gets the buffer right away
+    if (!uDMAChannelIsEnabled(psPort->ui32RxChannel))
+        DMAUART_RxRestart(psPort);
+    else
+    {
+        pui32Idle = psPort->bRxAlt ? &psPort->ui32RxPri : &psPort->ui32RxAlt;
+        if (*pui32Idle == DMAUART_NONE)
+        {
+            *pui32Idle = DMAUART_RxAlloc(psPort);
+            if (*pui32Idle != DMAUART_NONE)
+                DMAUART_RxArm(psPort, psPort->bRxAlt ? UDMA_PRI_SELECT : UDMA_ALT_SELECT, *pui32Idle);
+        }
+    }
+    IntEnable(psPort->ui32Int);
+}
+
+/*
+ * Queue bytes for transmission, waits only while the queue is full
+ * @param <uint32_t> $ui32Base UART of the port
+ * @param <const uint8_t *> $pui8Data bytes to send
+ * @param <uint32_t> $ui32Len number of bytes
+ * @return void
+ */
+void DMAUART_Write(uint32_t ui32Base, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    tDmaUartPort *psPort = DMAUART_Port(ui32Base);
+
+    while (ui32Len)
+    {
+        uint32_t ui32Slot = 0, ui32Room = 0, i;
+
+        IntDisable(psPort->ui32Int);
+
+        // merge into the last slot that is not on the wire yet
+        if (psPort->ui32TxCount > psPort->ui32TxInFlight)
+        {
+            ui32Slot = (psPort->ui32TxHead + psPort->ui32TxCount - 1) % DMAUART_TX_SLOTS;
+            ui32Room = DMAUART_TX_SIZE - psPort->pui32TxLen[ui32Slot];
+        }
+        if (!ui32Room)
+        {
+            if (psPort->ui32TxCount == DMAUART_TX_SLOTS)
+            {
+                IntEnable(psPort->ui32Int);
+                psPort->sStats.ui32TxWaits++;
+                while (psPort->ui32TxCount == DMAUART_TX_SLOTS)
+                    ;
+                continue;
+            }
+            ui32Slot = (psPort->ui32TxHead + psPort->ui32TxCount) % DMAUART_TX_SLOTS;
+            psPort->pui32TxLen[ui32Slot] = 0;
+            psPort->ui32TxCount++;
+            ui32Room = DMAUART_TX_SIZE;
+        }
+
+        for (i = 0; i < ui32Room && i < ui32Len; i++)
+            psPort->ppui8Tx[ui32Slot][psPort->pui32TxLen[ui32Slot] + i] = pui8Data[i];
+        psPort->pui32TxLen[ui32Slot] += i;
+        psPort->sStats.ui32TxBytes += i;
+        pui8Data += i;
+        ui32Len -= i;
+
+        DMAUART_TxKick(psPort);
+        IntEnable(psPort->ui32Int);
+    }
+}
+
+/*
+ * @param <uint32_t> $ui32Base UART of the port
+ * @param <tDmaUartStats *> $psStats filled in
+ * @return void
+ */
+void DMAUART_StatsGet(uint32_t ui32Base, tDmaUartStats *psStats)
+{
+    *psStats = DMAUART_Port(ui32Base)->sStats;
+}
+
+static void DMAUART_BenchIntHandler(void)
+{
+    uint32_t ui32Start = DMAUART_Cycles();
+    tDmaUartPort *psPort = g_psBenchPort;
+    uint32_t ui32Base = psPort->ui32Base;
+
+    UARTIntClear(ui32Base, UARTIntStatus(ui32Base, true));
+    if (g_bBenchDma)
+    {
+        // receiving the last byte means everything was sent as well
+        if (!uDMAChannelIsEnabled(psPort->ui32RxChannel))
+            g_bBenchDone = true;
+    }
+    else
+    {
+        while (g_ui32BenchReceived < g_ui32BenchBytes && UARTCharsAvail(ui32Base))
+            g_pui8BenchRx[g_ui32BenchReceived++] = (uint8_t)UARTCharGetNonBlocking(ui32Base);
+        while (g_ui32BenchSent < g_ui32BenchBytes && UARTSpaceAvail(ui32Base))
+            UARTCharPutNonBlocking(ui32Base, g_pui8BenchTx[g_ui32BenchSent++]);
+        if (g_ui32BenchReceived == g_ui32BenchBytes)
+            g_bBenchDone = true;
+    }
+
+    g_ui32BenchCount++;
+    g_ui32BenchCycles += DMAUART_Cycles() - ui32Start + DMAUART_EXC_CYCLES;
+}
+
+/*
+ * CPU cost of moving bytes polled, with FIFO interrupts and with the DMA,
+ * through the UART's internal loopback at its current rate. Pending receive
+ * data is dropped, and the caller registers its own interrupt handler again
+ * afterwards.
+ * @param <uint32_t> $ui32Base UART of a port set up with DMAUART_Init()
+ * @param <uint32_t> $ui32Bytes bytes per mode, at most DMAUART_BENCH_MAX
+ * @param <tDmaUartBench *> $psBench filled in
+ * @return void
+ */
+void DMAUART_Benchmark(uint32_t ui32Base, uint32_t ui32Bytes, tDmaUartBench *psBench)
+{
+    tDmaUartPort *psPort = DMAUART_Port(ui32Base);
+    uint32_t ui32Start, i;
+
+    if (ui32Bytes > DMAUART_BENCH_MAX)
+        ui32Bytes = DMAUART_BENCH_MAX;
+    for (i = 0; i < ui32Bytes; i++)
+        g_pui8BenchTx[i] = (uint8_t)(i * 7);
+
+    // take the port over once everything queued is out
+    while (psPort->ui32TxCount)
+        ;
+    IntDisable(psPort->ui32Int);
+    uDMAChannelDisable(psPort->ui32RxChannel);
+    while (UARTBusy(ui32Base))
+        ;
+    UARTDMADisable(ui32Base, UART_DMA_RX | UART_DMA_TX);
+    UARTIntDisable(ui32Base, 0xFFFFFFFF);
+    UARTIntClear(ui32Base, 0xFFFFFFFF);
+    HWREG(ui32Base + UART_O_CTL) |= UART_CTL_LBE;
+    while (UARTCharsAvail(ui32Base))
+        UARTCharGetNonBlocking(ui32Base);
+
+    g_psBenchPort = psPort;
+    g_ui32BenchBytes = ui32Bytes;
+    psBench->ui32Bytes = ui32Bytes;
+
+    // polled: the CPU is busy for the whole transfer
+    g_ui32BenchSent = g_ui32BenchReceived = 0;
+    ui32Start = DMAUART_Cycles();
+    while (g_ui32BenchReceived < ui32Bytes)
+    {
+        if (g_ui32BenchSent < ui32Bytes && UARTSpaceAvail(ui32Base))
+            UARTCharPutNonBlocking(ui32Base, g_pui8BenchTx[g_ui32BenchSent++]);
+        if (UARTCharsAvail(ui32Base))
+            g_pui8BenchRx[g_ui32BenchReceived++] = (uint8_t)UARTCharGetNonBlocking(ui32Base);
+    }
+    psBench->ui32PolledCycles = DMAUART_Cycles() - ui32Start;
+
+    // FIFO interrupts: setup plus the time spent in the handler
+    UARTIntRegister(ui32Base, DMAUART_BenchIntHandler);
+    g_bBenchDma = false;
+    g_bBenchDone = false;
+    g_ui32BenchSent = g_ui32BenchReceived = 0;
+    g_ui32BenchCycles = g_ui32BenchCount = 0;
+    ui32Start = DMAUART_Cycles();
+    UARTIntEnable(ui32Base, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+    while (g_ui32BenchSent < ui32Bytes && UARTSpaceAvail(ui32Base))
+        UARTCharPutNonBlocking(ui32Base, g_pui8BenchTx[g_ui32BenchSent++]);
+    g_ui32BenchCycles += DMAUART_Cycles() - ui32Start;
+    while (!g_bBenchDone)
+        ;
+    UARTIntDisable(ui32Base, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+    psBench->ui32IntCycles = g_ui32BenchCycles;
+    psBench->ui32IntCount = g_ui32BenchCount;
+
+    // DMA: setup plus the completion interrupt
+    g_bBenchDma = true;
+    g_bBenchDone = false;
+    g_ui32BenchCycles = g_ui32BenchCount = 0;
+    ui32Start = DMAUART_Cycles();
+    uDMAChannelAttributeDisable(psPort->ui32RxChannel, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(psPort->ui32RxChannel | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_4);
+    uDMAChannelTransferSet(psPort->ui32RxChannel | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                           (void *)(ui32Base + UART_O_DR), g_pui8BenchRx, ui32Bytes);
+    uDMAChannelControlSet(psPort->ui32TxChannel | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+    uDMAChannelTransferSet(psPort->ui32TxChannel | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                           g_pui8BenchTx, (void *)(ui32Base + UART_O_DR), ui32Bytes);
+    uDMAChannelEnable(psPort->ui32RxChannel);
+    uDMAChannelEnable(psPort->ui32TxChannel);
+    UARTDMAEnable(ui32Base, UART_DMA_RX | UART_DMA_TX);
+    g_ui32BenchCycles += DMAUART_Cycles() - ui32Start;
+    while (!g_bBenchDone)
+        ;
+    psBench->ui32DmaCycles = g_ui32BenchCycles;
+    psBench->ui32DmaCount = g_ui32BenchCount;
+
+    // give the port back
+    UARTIntUnregister(ui32Base);
+    HWREG(ui32Base + UART_O_CTL) &= ~UART_CTL_LBE;
+    DMAUART_PortStart(psPort);
+}
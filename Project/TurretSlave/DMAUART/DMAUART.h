@@ -0,0 +1,78 @@
+/*
+ * DMAUART.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  UART transport on the uDMA controller for UART0 and UART5, so bytes no
+ *  longer pass through the CPU one at a time.
+ *
+ *  Receive: the RX channel runs in ping-pong mode over two of DMAUART_RX_BUFS
+ *  buffers, in bursts of DMAUART_RX_BURST bytes. A full buffer is handed over
+ *  and the DMA goes on in the other one without a gap. The bytes of a burst
+ *  that did not complete stay in the FIFO until the receive timeout (32 bit
+ *  times of silence, i.e. the end of a frame), which closes the current
+ *  buffer early. DMAUART_RxGet() gives the oldest filled buffer in place, and
+ *  DMAUART_RxRelease() returns it to the DMA.
+ *
+ *  Transmit: DMAUART_Write() copies into a queue of DMAUART_TX_SLOTS slots,
+ *  small writes are merged into the last slot not on the wire yet. Whenever
+ *  the TX channel is idle, all queued slots go out as one scatter-gather
+ *  transfer, one task per slot. A write only waits when the queue is full.
+ *
+ *  The port's UART interrupt handler must call DMAUART_IntHandler(), the DMA
+ *  completions of both channels arrive on that vector. The DWT cycle counter
+ *  (started by SCHED_Init or SYNC_Init) times DMAUART_Benchmark().
+ */
+
+#ifndef DMAUART_DMAUART_H_
+#define DMAUART_DMAUART_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DMAUART_RX_BUFS     4
+#define DMAUART_RX_SIZE     64      // multiple of DMAUART_RX_BURST
+#define DMAUART_RX_BURST    8       // RX FIFO trigger at 1/2
+#define DMAUART_TX_SLOTS    8
+#define DMAUART_TX_SIZE     72      // one addressed LINK frame
+#define DMAUART_BENCH_MAX   1024    // bytes per benchmark run, DMA transfer limit
+
+/*
+ * Events returned by DMAUART_IntHandler()
+ */
+#define DMAUART_EVENT_RX    0x01    // a receive buffer is ready
+#define DMAUART_EVENT_TX    0x02    // transmit queue has room again
+
+typedef struct
+{
+    uint32_t ui32RxBytes;
+    uint32_t ui32RxBuffers;         // buffers handed over
+    uint32_t ui32RxTimeouts;        // buffers closed early by the receive timeout
+    uint32_t ui32RxStarved;         // times the DMA had no free buffer
+    uint32_t ui32TxBytes;
+    uint32_t ui32TxTransfers;       // scatter-gather transfers started
+    uint32_t ui32TxWaits;           // writes that found the queue full
+} tDmaUartStats;
+
+typedef struct
+{
+    uint32_t ui32Bytes;
+    uint32_t ui32PolledCycles;      // CPU cycles spent, busy waiting on the FIFOs
+    uint32_t ui32IntCycles;         // CPU cycles spent, FIFO interrupts
+    uint32_t ui32IntCount;
+    uint32_t ui32DmaCycles;         // CPU cycles spent, DMA setup and completion
+    uint32_t ui32DmaCount;
+} tDmaUartBench;
+
+/*
+ * Function declaration(s)
+ */
+extern void DMAUART_Init(uint32_t ui32Base);
+extern uint32_t DMAUART_IntHandler(uint32_t ui32Base);
+extern bool DMAUART_RxGet(uint32_t ui32Base, const uint8_t **ppui8Data, uint32_t *pui32Len);
+extern void DMAUART_RxRelease(uint32_t ui32Base);
+extern void DMAUART_Write(uint32_t ui32Base, const uint8_t *pui8Data, uint32_t ui32Len);
+extern void DMAUART_StatsGet(uint32_t ui32Base, tDmaUartStats *psStats);
+extern void DMAUART_Benchmark(uint32_t ui32Base, uint32_t ui32Bytes, tDmaUartBench *psBench);
+
+#endif /* DMAUART_DMAUART_H_ */
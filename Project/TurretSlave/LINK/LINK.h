@@ -0,0 +1,121 @@
+/*
+ * LINK.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Binary framing used between TurretMaster and TurretSlave over the HC-05 pair.
+ *
+ *  Frame format:
+ *      SYNC(0xA5) TYPE LEN PAYLOAD[LEN] CRC8
+ *  CRC8 (polynomial 0x07) covers TYPE, LEN and PAYLOAD. A parser that sees a
+ *  bad CRC drops the frame and hunts for the next SYNC, so bytes outside of a
+ *  frame (e.g. ASCII "p90" commands) can share the same UART.
+ *
+ *  Addressed frames, for one master and several slaves on a shared link, have
+ *  LINK_TYPE_ADDRESSED set in TYPE and start their payload with
+ *      DST SRC FLAGS SEQ
+ *  DST is a node (1 - 0xEF), the master (0), a group (LINK_ADDR_GROUP(0 - 7))
+ *  or LINK_ADDR_BROADCAST. The parser strips the header into the frame fields
+ *  and drops frames for other nodes or groups, so handlers see the plain type
+ *  and payload. Frames without a header reach every node, as before.
+ *  A frame with LINK_FLAG_ACK is answered with an ACK carrying its SEQ. Nodes
+ *  only reply to frames addressed to them alone, never to groups or broadcasts.
+ */
+
+#ifndef LINK_LINK_H_
+#define LINK_LINK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LINK_SYNC           0xA5
+#define LINK_MAX_PAYLOAD    64
+#define LINK_OVERHEAD       4       // SYNC, TYPE, LEN, CRC8
+#define LINK_MAX_FRAME      (LINK_MAX_PAYLOAD + LINK_OVERHEAD)
+
+/*
+ * Frame types
+ */
+#define LINK_TYPE_KEYFRAME  'K'     // absolute yaw/pitch, also the heartbeat
+#define LINK_TYPE_DELTA     'D'     // yaw/pitch changes since the last sent frame
+#define LINK_TYPE_PING      'P'     // clock sync request, master -> slave
+#define LINK_TYPE_PONG      'Q'     // clock sync reply, slave -> master
+#define LINK_TYPE_STATUS    'S'     // cpu load of the sender, both ways
+#define LINK_TYPE_SERVO     'M'     // servo bank targets, applied in the same PWM frame
+#define LINK_TYPE_ACK       'A'     // receipt of an addressed frame, payload SEQ
+#define LINK_TYPE_ADDRESSED 0x80    // TYPE bit: payload starts with the address header
+
+/*
+ * LINK_TYPE_SERVO payload: MASK[2] followed by one varint per set bit of MASK,
+ * lowest channel first, each the target angle of that servo channel in 0.01 deg.
+ */
+#define LINK_SERVO_CHANNELS 16
+
+/*
+ * Addresses and flags of addressed frames
+ */
+#define LINK_ADDR_HEADER    4       // DST, SRC, FLAGS, SEQ
+#define LINK_ADDR_MASTER    0x00
+#define LINK_ADDR_MAX_NODE  0xEF
+#define LINK_ADDR_GROUP(n)  (0xF0 + (n))
+#define LINK_ADDR_IS_GROUP(a) (((a) & 0xF8) == 0xF0)
+#define LINK_ADDR_BROADCAST 0xFF
+
+#define LINK_FLAG_ACK       0x01    // receiver answers with LINK_TYPE_ACK
+#define LINK_FLAG_ADDRESSED 0x80    // set by the parser on frames that had a header
+
+/*
+ * Return values of LINK_Parse()
+ */
+#define LINK_BYTE_UNUSED    0       // byte is not part of a frame
+#define LINK_BYTE_USED      1       // byte was consumed, frame not complete yet
+#define LINK_FRAME_READY    2       // a frame with a valid CRC for this node is in sFrame
+
+typedef struct
+{
+    uint8_t ui8Type;
+    uint8_t ui8Len;
+    uint8_t pui8Payload[LINK_MAX_PAYLOAD];
+
+    // address header, LINK_ADDR_BROADCAST and 0 for frames without one
+    uint8_t ui8Dst;
+    uint8_t ui8Src;
+    uint8_t ui8Flags;
+    uint8_t ui8Seq;
+} tLinkFrame;
+
+typedef struct
+{
+    uint8_t ui8State;
+    uint8_t ui8Index;
+    uint8_t ui8Crc;
+    tLinkFrame sFrame;
+
+    // address of this node and the groups (bit n = LINK_ADDR_GROUP(n)) it is in
+    uint8_t ui8Addr;
+    uint8_t ui8Groups;
+
+    // number of frames dropped because of a bad CRC or length
+    uint32_t ui32Errors;
+    // number of valid frames dropped because they were for other nodes
+    uint32_t ui32Filtered;
+} tLinkParser;
+
+/*
+ * Function declaration(s)
+ */
+extern uint8_t LINK_Crc8(uint8_t ui8Crc, const uint8_t *pui8Data, uint32_t ui32Len);
+extern uint32_t LINK_Encode(uint8_t *pui8Buf, uint8_t ui8Type, const uint8_t *pui8Payload, uint8_t ui8Len);
+extern void LINK_Send(uint32_t ui32Base, uint8_t ui8Type, const uint8_t *pui8Payload, uint8_t ui8Len);
+extern uint32_t LINK_SendTo(uint32_t ui32Base, const tLinkFrame *psFrame);
+extern bool LINK_Reply(uint32_t ui32Base, const tLinkFrame *psRequest, uint8_t ui8Type, const uint8_t *pui8Payload,
+                       uint8_t ui8Len);
+extern void LINK_AddressSet(uint8_t ui8Addr);
+extern void LINK_TransportSet(void (*pfnWrite)(uint32_t ui32Base, const uint8_t *pui8Data, uint32_t ui32Len));
+extern void LINK_ParserInit(tLinkParser *psParser);
+extern void LINK_ParserFilterSet(tLinkParser *psParser, uint8_t ui8Addr, uint8_t ui8Groups);
+extern uint32_t LINK_Parse(tLinkParser *psParser, uint8_t ui8Byte);
+extern uint32_t LINK_PutVarint(uint8_t *pui8Buf, int32_t i32Value);
+extern uint32_t LINK_GetVarint(const uint8_t *pui8Buf, uint32_t ui32Len, int32_t *pi32Value);
+
+#endif /* LINK_LINK_H_ */
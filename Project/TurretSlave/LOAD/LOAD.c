@@ -0,0 +1,233 @@
+/*
+ * LOAD.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "LOAD.h"
+#include "../SCHED/SCHED.h"
+#include "../TIME/TIME.h"
+
+static tLoadIsrInfo g_psIsrs[LOAD_MAX_ISRS];
+
+// load of the last windows, 1/1000
+static uint16_t g_pui16Window[LOAD_WINDOWS];
+static uint32_t g_ui32WindowIndex;
+
+static uint32_t g_ui32LastCycles;
+static uint64_t g_ui64LastIdle;
+static tTimeTimer g_sWindowTimer;
+
+// as reported by the other board
+static uint32_t g_ui32RemoteLoad;
+static uint32_t g_ui32RemotePeak;
+
+/*
+ * Close a window, runs from SysTick
+ */
+static void LOAD_WindowEnd(void *pvData)
+{
+    uint32_t ui32Now = SCHED_Cycles();
+    uint64_t ui64Idle = SCHED_IdleCycles();
+    uint32_t ui32Elapsed = ui32Now - g_ui32LastCycles;
+    uint32_t ui32Idle = (uint32_t)(ui64Idle - g_ui64LastIdle);
+    uint32_t i;
+
+    g_ui32LastCycles = ui32Now;
+    g_ui64LastIdle = ui64Idle;
+    if (!ui32Elapsed)
+        return;
+
+    if (ui32Idle > ui32Elapsed)
+        ui32Idle = ui32Elapsed;
+    g_pui16Window[g_ui32WindowIndex] = 1000 - (uint16_t)((uint64_t)ui32Idle * 1000 / ui32Elapsed);
+    g_ui32WindowIndex = (g_ui32WindowIndex + 1) % LOAD_WINDOWS;
+
+    for (i = 0; i < LOAD_MAX_ISRS; i++)
+    {
+        tLoadIsrInfo *psIsr = &g_psIsrs[i];
+
+        psIsr->ui32Permille = (uint32_t)((psIsr->ui64Cycles - psIsr->ui64WindowStart) * 1000 / ui32Elapsed);
+        psIsr->ui64WindowStart = psIsr->ui64Cycles;
+    }
+}
+
+/*
+ * Start measuring, call after TIME_Init() and SCHED_Init()
+ * @param none
+ * @return void
+ */
+void LOAD_Init(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < LOAD_MAX_ISRS; i++)
+        LOAD_IsrAdd(i, 0);
+    for (i = 0; i < LOAD_WINDOWS; i++)
+        g_pui16Window[i] = 0;
+    g_ui32WindowIndex = 0;
+    g_ui32RemoteLoad = 0;
+    g_ui32RemotePeak = 0;
+
+    g_ui32LastCycles = SCHED_Cycles();
+    g_ui64LastIdle = SCHED_IdleCycles();
+    TIME_TimerInit(&g_sWindowTimer, LOAD_WindowEnd, 0);
+    TIME_TimerStart(&g_sWindowTimer, LOAD_WINDOW_MS, LOAD_WINDOW_MS);
+}
+
+/*
+ * Name an interrupt handler that reports its busy time
+ * @param <uint32_t> $ui32Id index below LOAD_MAX_ISRS
+ * @param <const char *> $pcName name shown in statistics
+ * @return void
+ */
+void LOAD_IsrAdd(uint32_t ui32Id, const char *pcName)
+{
+    tLoadIsrInfo *psIsr = &g_psIsrs[ui32Id];
+
+    psIsr->pcName = pcName;
+    psIsr->ui32Count = 0;
+    psIsr->ui32MaxCycles = 0;
+    psIsr->ui64Cycles = 0;
+    psIsr->ui64WindowStart = 0;
+    psIsr->ui32Permille = 0;
+}
+
+/*
+ * @return <uint32_t> start time, to pass to LOAD_IsrEnd() at the end of the handler
+ */
+uint32_t LOAD_IsrBegin(void)
+{
+    return SCHED_Cycles();
+}
+
+/*
+ * @param <uint32_t> $ui32Id index given to LOAD_IsrAdd()
+ * @param <uint32_t> $ui32Start value LOAD_IsrBegin() returned
+ * @return void
+ */
+void LOAD_IsrEnd(uint32_t ui32Id, uint32_t ui32Start)
+{
+    tLoadIsrInfo *psIsr = &g_psIsrs[ui32Id];
+    uint32_t ui32Elapsed = SCHED_Cycles() - ui32Start;
+
+    psIsr->ui32Count++;
+    psIsr->ui64Cycles += ui32Elapsed;
+    if (ui32Elapsed > psIsr->ui32MaxCycles)
+        psIsr->ui32MaxCycles = ui32Elapsed;
+}
+
+/*
+ * @param <uint32_t> $ui32Id index given to LOAD_IsrAdd()
+ * @return <const tLoadIsrInfo *> busy time of the handler
+ */
+const tLoadIsrInfo *LOAD_IsrGet(uint32_t ui32Id)
+{
+    return &g_psIsrs[ui32Id];
+}
+
+/*
+ * @return <uint32_t> mean load of the last LOAD_WINDOWS windows, 1/1000
+ */
+uint32_t LOAD_Permille(void)
+{
+    uint32_t ui32Sum = 0;
+    uint32_t i;
+
+    for (i = 0; i < LOAD_WINDOWS; i++)
+        ui32Sum += g_pui16Window[i];
+    return ui32Sum / LOAD_WINDOWS;
+}
+
+/*
+ * @return <uint32_t> busiest of the last LOAD_WINDOWS windows, 1/1000
+ */
+uint32_t LOAD_PeakPermille(void)
+{
+    uint32_t ui32Peak = 0;
+    uint32_t i;
+
+    for (i = 0; i < LOAD_WINDOWS; i++)
+        if (g_pui16Window[i] > ui32Peak)
+            ui32Peak = g_pui16Window[i];
+    return ui32Peak;
+}
+
+/*
+ * Build the payload of a STATUS frame with the own load
+ * @param <uint8_t *> $pui8Buf output, LOAD_STATUS_MAX bytes
+ * @return <uint32_t> payload length
+ */
+uint32_t LOAD_StatusEncode(uint8_t *pui8Buf)
+{
+    uint32_t ui32Len;
+
+    ui32Len = LINK_PutVarint(pui8Buf, (int32_t)LOAD_Permille());
+    ui32Len += LINK_PutVarint(pui8Buf + ui32Len, (int32_t)LOAD_PeakPermille());
+    return ui32Len;
+}
+
+/*
+ * Read the load out of a STATUS frame
+ * @param <const tLinkFrame *> $psFrame received STATUS frame
+ * @param <uint32_t *> $pui32Load rolling load, 1/1000
+ * @param <uint32_t *> $pui32Peak peak load, 1/1000
+ * @return <bool> false if the payload is malformed
+ */
+bool LOAD_StatusDecode(const tLinkFrame *psFrame, uint32_t *pui32Load, uint32_t *pui32Peak)
+{
+    int32_t i32Load, i32Peak;
+    uint32_t ui32Used;
+
+    ui32Used = LINK_GetVarint(psFrame->pui8Payload, psFrame->ui8Len, &i32Load);
+    if (!ui32Used || !LINK_GetVarint(psFrame->pui8Payload + ui32Used, psFrame->ui8Len - ui32Used, &i32Peak))
+        return false;
+
+    *pui32Load = (uint32_t)i32Load;
+    *pui32Peak = (uint32_t)i32Peak;
+    return true;
+}
+
+/*
+ * Report the own load to the other board, call from the task that owns the link
+ * @param <uint32_t> $ui32Base UART of the link
+ * @return void
+ */
+void LOAD_SendStatus(uint32_t ui32Base)
+{
+    uint8_t pui8Payload[LOAD_STATUS_MAX];
+
+    LINK_Send(ui32Base, LINK_TYPE_STATUS, pui8Payload, (uint8_t)LOAD_StatusEncode(pui8Payload));
+}
+
+/*
+ * Take over the load reported by the other board
+ * @param <const tLinkFrame *> $psFrame received STATUS frame
+ * @return void
+ */
+void LOAD_HandleStatus(const tLinkFrame *psFrame)
+{
+    uint32_t ui32Load, ui32Peak;
+
+    if (!LOAD_StatusDecode(psFrame, &ui32Load, &ui32Peak))
+        return;
+
+    g_ui32RemoteLoad = ui32Load;
+    g_ui32RemotePeak = ui32Peak;
+}
+
+/*
+ * @return <uint32_t> rolling load of the other board, 1/1000
+ */
+uint32_t LOAD_RemotePermille(void)
+{
+    return g_ui32RemoteLoad;
+}
+
+/*
+ * @return <uint32_t> peak load of the other board, 1/1000
+ */
+uint32_t LOAD_RemotePeakPermille(void)
+{
+    return g_ui32RemotePeak;
+}
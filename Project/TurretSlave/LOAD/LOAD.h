@@ -0,0 +1,58 @@
+/*
+ * LOAD.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  CPU load measurement on top of SCHED and TIME.
+ *  Every LOAD_WINDOW_MS the idle cycles SCHED counted in WFI are compared to
+ *  the cycles that passed; the load is the rest. The last LOAD_WINDOWS
+ *  windows give a rolling mean and peak, in 1/1000.
+ *
+ *  Interrupt handlers that call LOAD_IsrBegin()/LOAD_IsrEnd() get their own
+ *  busy time (nested interrupts are counted in the outer one as well).
+ *
+ *  STATUS frame: LOAD PEAK, both varints in 1/1000, so each board can show
+ *  the other's load.
+ */
+
+#ifndef LOAD_LOAD_H_
+#define LOAD_LOAD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../LINK/LINK.h"
+
+#define LOAD_WINDOW_MS      100
+#define LOAD_WINDOWS        10      // rolling over one second
+#define LOAD_MAX_ISRS       8
+#define LOAD_STATUS_MAX     10      // STATUS payload, two varints
+
+typedef struct
+{
+    const char *pcName;
+    uint32_t ui32Count;
+    uint32_t ui32MaxCycles;         // longest single run
+    uint64_t ui64Cycles;            // all runs
+    uint64_t ui64WindowStart;       // ui64Cycles at the start of the window
+    uint32_t ui32Permille;          // share of the last window
+} tLoadIsrInfo;
+
+/*
+ * Function declaration(s)
+ */
+extern void LOAD_Init(void);
+extern void LOAD_IsrAdd(uint32_t ui32Id, const char *pcName);
+extern uint32_t LOAD_IsrBegin(void);
+extern void LOAD_IsrEnd(uint32_t ui32Id, uint32_t ui32Start);
+extern const tLoadIsrInfo *LOAD_IsrGet(uint32_t ui32Id);
+extern uint32_t LOAD_Permille(void);
+extern uint32_t LOAD_PeakPermille(void);
+
+extern uint32_t LOAD_StatusEncode(uint8_t *pui8Buf);
+extern bool LOAD_StatusDecode(const tLinkFrame *psFrame, uint32_t *pui32Load, uint32_t *pui32Peak);
+extern void LOAD_SendStatus(uint32_t ui32Base);
+extern void LOAD_HandleStatus(const tLinkFrame *psFrame);
+extern uint32_t LOAD_RemotePermille(void);
+extern uint32_t LOAD_RemotePeakPermille(void);
+
+#endif /* LOAD_LOAD_H_ */
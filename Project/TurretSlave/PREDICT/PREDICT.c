@@ -0,0 +1,113 @@
+/*
+ * PREDICT.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PREDICT.h"
+
+static int32_t PREDICT_Clamp(const tPredictAxis *psAxis, int32_t i32Value)
+{
+    if (i32Value < psAxis->i32Min)
+        return psAxis->i32Min;
+    if (i32Value > psAxis->i32Max)
+        return psAxis->i32Max;
+    return i32Value;
+}
+
+/*
+ * Where the master is believed to be now, without the blend
+ */
+static int32_t PREDICT_Estimate(const tPredictAxis *psAxis, uint32_t ui32Now)
+{
+    uint32_t ui32Age = ui32Now - psAxis->ui32Arrival + psAxis->ui32LeadMs;
+
+    if (ui32Age > PREDICT_HORIZON_MS)
+        ui32Age = PREDICT_HORIZON_MS;
+
+    return PREDICT_Clamp(psAxis, psAxis->i32Pos + psAxis->i32Rate * (int32_t)ui32Age / 1000);
+}
+
+/*
+ * Set up an axis, holding still at the initial position
+ * @param <tPredictAxis *> $psAxis axis state
+ * @param <int32_t> $i32MinCdeg lower servo limit (0.01 deg)
+ * @param <int32_t> $i32MaxCdeg upper servo limit (0.01 deg)
+ * @param <int32_t> $i32InitCdeg initial position (0.01 deg)
+ * @param <uint32_t> $ui32LeadMs expected link delay the frames are projected over
+ * @return void
+ */
+void PREDICT_Init(tPredictAxis *psAxis, int32_t i32MinCdeg, int32_t i32MaxCdeg, int32_t i32InitCdeg,
+                  uint32_t ui32LeadMs)
+{
+    psAxis->i32Min = i32MinCdeg * 10;
+    psAxis->i32Max = i32MaxCdeg * 10;
+    psAxis->i32Pos = i32InitCdeg * 10;
+    psAxis->i32Rate = 0;
+    psAxis->i32Blend = 0;
+    psAxis->ui32Arrival = 0;
+    psAxis->ui32LeadMs = ui32LeadMs;
+
+    psAxis->ui32Updates = 0;
+    psAxis->ui32ErrorMax = 0;
+    psAxis->ui64ErrorSum = 0;
+}
+
+/*
+ * A new frame arrived for this axis
+ * @param <tPredictAxis *> $psAxis axis state
+ * @param <int32_t> $i32PosCdeg reported position (0.01 deg)
+ * @param <int32_t> $i32RateDeci reported rate (0.1 deg/s)
+ * @param <uint32_t> $ui32Now local time (ms)
+ * @return void
+ */
+void PREDICT_Update(tPredictAxis *psAxis, int32_t i32PosCdeg, int32_t i32RateDeci, uint32_t ui32Now)
+{
+    int32_t i32Output = PREDICT_Output(psAxis, ui32Now);
+    int32_t i32Before = PREDICT_Estimate(psAxis, ui32Now);
+    int32_t i32Error;
+
+    psAxis->i32Pos = i32PosCdeg * 10;
+    psAxis->i32Rate = i32RateDeci * 100;
+    psAxis->ui32Arrival = ui32Now;
+
+    // how far off the extrapolation was
+    i32Error = PREDICT_Estimate(psAxis, ui32Now) - i32Before;
+    if (i32Error < 0)
+        i32Error = -i32Error;
+    psAxis->ui32Updates++;
+    psAxis->ui64ErrorSum += (uint32_t)i32Error;
+    if ((uint32_t)i32Error > psAxis->ui32ErrorMax)
+        psAxis->ui32ErrorMax = (uint32_t)i32Error;
+
+    // start from where the servo is, converge on the new estimate
+    psAxis->i32Blend = i32Output - PREDICT_Estimate(psAxis, ui32Now);
+}
+
+/*
+ * Position to command the servo to
+ * @param <const tPredictAxis *> $psAxis axis state
+ * @param <uint32_t> $ui32Now local time (ms)
+ * @return <int32_t> position in milli-degrees, inside the servo limits
+ */
+int32_t PREDICT_Output(const tPredictAxis *psAxis, uint32_t ui32Now)
+{
+    uint32_t ui32Since = ui32Now - psAxis->ui32Arrival;
+    int32_t i32Blend = 0;
+
+    // linear fade of the arrival offset, a shift instead of a division
+    if (ui32Since < PREDICT_BLEND_MS)
+        i32Blend = (psAxis->i32Blend * (int32_t)(PREDICT_BLEND_MS - ui32Since)) >> PREDICT_BLEND_SHIFT;
+
+    return PREDICT_Clamp(psAxis, PREDICT_Estimate(psAxis, ui32Now) + i32Blend);
+}
+
+/*
+ * @return <uint32_t> mean absolute prediction error in milli-degrees
+ */
+uint32_t PREDICT_ErrorMean(const tPredictAxis *psAxis)
+{
+    if (!psAxis->ui32Updates)
+        return 0;
+    return (uint32_t)(psAxis->ui64ErrorSum / psAxis->ui32Updates);
+}
@@ -0,0 +1,51 @@
+/*
+ * PREDICT.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Dead reckoning for one servo axis on the slave.
+ *  Between telemetry frames the output keeps moving with the last reported
+ *  rate, projected ahead by the expected link delay. When a frame arrives the
+ *  jump to the new estimate is spread over PREDICT_BLEND_MS instead of being
+ *  applied as a step. Extrapolation stops PREDICT_HORIZON_MS after the last
+ *  frame, so a lost link holds the turret rather than running it into a stop.
+ *
+ *  All math is integer, positions are kept in milli-degrees. Frames and
+ *  limits give positions in 0.01 deg, so binary SERVO targets and calibrated
+ *  limits keep their resolution.
+ */
+
+#ifndef PREDICT_PREDICT_H_
+#define PREDICT_PREDICT_H_
+
+#include <stdint.h>
+
+#define PREDICT_BLEND_SHIFT     6                           // blend over 64 ms
+#define PREDICT_BLEND_MS        (1 << PREDICT_BLEND_SHIFT)
+#define PREDICT_HORIZON_MS      150
+
+typedef struct
+{
+    int32_t i32Pos;             // last reported position, milli-degrees
+    int32_t i32Rate;            // last reported rate, milli-degrees per second
+    int32_t i32Blend;           // output - estimate right after the last frame
+    uint32_t ui32Arrival;       // local time of the last frame, ms
+    uint32_t ui32LeadMs;        // expected age of a frame on arrival, ms
+    int32_t i32Min, i32Max;     // servo limits, milli-degrees
+
+    // prediction error statistics: estimate just before a frame vs. the frame
+    uint32_t ui32Updates;
+    uint32_t ui32ErrorMax;      // milli-degrees
+    uint64_t ui64ErrorSum;      // milli-degrees
+} tPredictAxis;
+
+/*
+ * Function declaration(s)
+ */
+extern void PREDICT_Init(tPredictAxis *psAxis, int32_t i32MinCdeg, int32_t i32MaxCdeg, int32_t i32InitCdeg,
+                         uint32_t ui32LeadMs);
+extern void PREDICT_Update(tPredictAxis *psAxis, int32_t i32PosCdeg, int32_t i32RateDeci, uint32_t ui32Now);
+extern int32_t PREDICT_Output(const tPredictAxis *psAxis, uint32_t ui32Now);
+extern uint32_t PREDICT_ErrorMean(const tPredictAxis *psAxis);
+
+#endif /* PREDICT_PREDICT_H_ */
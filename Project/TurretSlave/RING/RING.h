@@ -0,0 +1,219 @@
+/*
+ * RING.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Lock-free single producer / single consumer byte ring, header only.
+ *  The size is a power of 2, so an index wraps with a mask instead of a
+ *  division. Head and tail run freely over 32 bits and their difference is
+ *  the fill level; there is no shared count. Only the producer writes the
+ *  head and only the consumer writes the tail, so an interrupt handler can
+ *  fill a ring that main() empties (or the other way round) without
+ *  disabling interrupts. RING_BARRIER() orders the data against the index
+ *  that publishes it.
+ *
+ *  Besides single bytes, RING_PushN() / RING_PopN() copy blocks, and the span
+ *  functions give the contiguous part of the data (or free space) in place:
+ *  RING_ReadSpan() then RING_ReadCommit(), RING_WriteSpan() then
+ *  RING_WriteCommit(). Project/HostTools/RingBench stress tests the ring
+ *  from two threads and measures its throughput.
+ */
+
+#ifndef RING_RING_H_
+#define RING_RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__)
+#define RING_BARRIER()      __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#elif defined(ccs) || defined(__TI_ARM__)
+#define RING_BARRIER()      __asm("    dmb")
+#else
+#define RING_BARRIER()      __asm("dmb")
+#endif
+
+typedef struct
+{
+    uint8_t *pui8Buffer;
+    uint32_t ui32Mask;              // size - 1
+    volatile uint32_t ui32Head;     // next write, producer only
+    volatile uint32_t ui32Tail;     // next read, consumer only
+} tRing;
+
+/*
+ * @param <tRing *> $psRing the ring to set up, empty
+ * @param <uint8_t *> $pui8Buffer storage of the ring
+ * @param <uint32_t> $ui32Size size of the storage, a power of 2
+ * @return <bool> false if the size is not a power of 2
+ */
+static inline bool RING_Init(tRing *psRing, uint8_t *pui8Buffer, uint32_t ui32Size)
+{
+    if (!ui32Size || (ui32Size & (ui32Size - 1)))
+        return false;
+    psRing->pui8Buffer = pui8Buffer;
+    psRing->ui32Mask = ui32Size - 1;
+    psRing->ui32Head = 0;
+    psRing->ui32Tail = 0;
+    return true;
+}
+
+/*
+ * @return <uint32_t> bytes to read, exact for the consumer, a lower bound for the producer
+ */
+static inline uint32_t RING_Count(const tRing *psRing)
+{
+    return psRing->ui32Head - psRing->ui32Tail;
+}
+
+/*
+ * @return <uint32_t> free bytes, exact for the producer, a lower bound for the consumer
+ */
+static inline uint32_t RING_Free(const tRing *psRing)
+{
+    return psRing->ui32Mask + 1 - (psRing->ui32Head - psRing->ui32Tail);
+}
+
+static inline bool RING_Empty(const tRing *psRing)
+{
+    return psRing->ui32Head == psRing->ui32Tail;
+}
+
+/*
+ * Producer: add one byte
+ * @return <bool> false if the ring is full, the byte is dropped
+ */
+static inline bool RING_Push(tRing *psRing, uint8_t ui8Byte)
+{
+    uint32_t ui32Head = psRing->ui32Head;
+
+    if (ui32Head - psRing->ui32Tail > psRing->ui32Mask)
+        return false;
+    RING_BARRIER();     // the consumer has read the slot before we overwrite it
+    psRing->pui8Buffer[ui32Head & psRing->ui32Mask] = ui8Byte;
+    RING_BARRIER();     // the byte is stored before the head shows it
+    psRing->ui32Head = ui32Head + 1;
+    return true;
+}
+
+/*
+ * Consumer: take one byte
+ * @return <bool> false if the ring is empty
+ */
+static inline bool RING_Pop(tRing *psRing, uint8_t *pui8Byte)
+{
+    uint32_t ui32Tail = psRing->ui32Tail;
+
+    if (psRing->ui32Head == ui32Tail)
+        return false;
+    RING_BARRIER();     // the head is read before the byte it covers
+    *pui8Byte = psRing->pui8Buffer[ui32Tail & psRing->ui32Mask];
+    RING_BARRIER();     // the byte is read before the slot is handed back
+    psRing->ui32Tail = ui32Tail + 1;
+    return true;
+}
+
+/*
+ * Producer: the contiguous free space from the head on
+ * @param <uint8_t **> $ppui8Span set to the first free byte
+ * @return <uint32_t> bytes that may be written there, 0 if the ring is full
+ */
+static inline uint32_t RING_WriteSpan(tRing *psRing, uint8_t **ppui8Span)
+{
+    uint32_t ui32Index = psRing->ui32Head & psRing->ui32Mask;
+    uint32_t ui32Free = RING_Free(psRing);
+    uint32_t ui32Edge = psRing->ui32Mask + 1 - ui32Index;
+
+    RING_BARRIER();
+    *ppui8Span = &psRing->pui8Buffer[ui32Index];
+    return ui32Free < ui32Edge ? ui32Free : ui32Edge;
+}
+
+/*
+ * Producer: publish bytes written into the span of RING_WriteSpan()
+ * @param <uint32_t> $ui32Count at most the length of the span
+ * @return void
+ */
+static inline void RING_WriteCommit(tRing *psRing, uint32_t ui32Count)
+{
+    RING_BARRIER();
+    psRing->ui32Head += ui32Count;
+}
+
+/*
+ * Consumer: the contiguous data from the tail on
+ * @param <const uint8_t **> $ppui8Span set to the oldest byte
+ * @return <uint32_t> bytes that may be read there, 0 if the ring is empty
+ */
+static inline uint32_t RING_ReadSpan(tRing *psRing, const uint8_t **ppui8Span)
+{
+    uint32_t ui32Index = psRing->ui32Tail & psRing->ui32Mask;
+    uint32_t ui32Count = RING_Count(psRing);
+    uint32_t ui32Edge = psRing->ui32Mask + 1 - ui32Index;
+
+    RING_BARRIER();
+    *ppui8Span = &psRing->pui8Buffer[ui32Index];
+    return ui32Count < ui32Edge ? ui32Count : ui32Edge;
+}
+
+/*
+ * Consumer: hand back bytes read from the span of RING_ReadSpan()
+ * @param <uint32_t> $ui32Count at most the length of the span
+ * @return void
+ */
+static inline void RING_ReadCommit(tRing *psRing, uint32_t ui32Count)
+{
+    RING_BARRIER();
+    psRing->ui32Tail += ui32Count;
+}
+
+/*
+ * Producer: copy in as many bytes as fit, at most two copies
+ * @return <uint32_t> bytes added
+ */
+static inline uint32_t RING_PushN(tRing *psRing, const uint8_t *pui8Data, uint32_t ui32Count)
+{
+    uint32_t ui32Head = psRing->ui32Head;
+    uint32_t ui32Index = ui32Head & psRing->ui32Mask;
+    uint32_t ui32Free = RING_Free(psRing);
+    uint32_t ui32First = psRing->ui32Mask + 1 - ui32Index;
+
+    if (ui32Count > ui32Free)
+        ui32Count = ui32Free;
+    if (ui32First > ui32Count)
+        ui32First = ui32Count;
+
+    RING_BARRIER();
+    memcpy(&psRing->pui8Buffer[ui32Index], pui8Data, ui32First);
+    memcpy(psRing->pui8Buffer, pui8Data + ui32First, ui32Count - ui32First);
+    RING_BARRIER();
+    psRing->ui32Head = ui32Head + ui32Count;
+    return ui32Count;
+}
+
+/*
+ * Consumer: copy out as many bytes as there are, at most two copies
+ * @return <uint32_t> bytes taken
+ */
+static inline uint32_t RING_PopN(tRing *psRing, uint8_t *pui8Data, uint32_t ui32Count)
+{
+    uint32_t ui32Tail = psRing->ui32Tail;
+    uint32_t ui32Index = ui32Tail & psRing->ui32Mask;
+    uint32_t ui32Avail = RING_Count(psRing);
+    uint32_t ui32First = psRing->ui32Mask + 1 - ui32Index;
+
+    if (ui32Count > ui32Avail)
+        ui32Count = ui32Avail;
+    if (ui32First > ui32Count)
+        ui32First = ui32Count;
+
+    RING_BARRIER();
+    memcpy(pui8Data, &psRing->pui8Buffer[ui32Index], ui32First);
+    memcpy(pui8Data + ui32First, psRing->pui8Buffer, ui32Count - ui32First);
+    RING_BARRIER();
+    psRing->ui32Tail = ui32Tail + ui32Count;
+    return ui32Count;
+}
+
+#endif /* RING_RING_H_ */
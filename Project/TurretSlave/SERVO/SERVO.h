@@ -0,0 +1,65 @@
+/*
+ * SERVO.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Servo bank on the 16 outputs of PWM0 and PWM1.
+ *  The frame rate can be set from 50 Hz (analog servos) up to 333 Hz
+ *  (digital servos). The PWM clock divider is the smallest one that still
+ *  fits a frame into the 16 bit counter, which gives 0.02 - 0.32 us per count
+ *  instead of the 0.1% of a period that "value * load / 1000" allows.
+ *
+ *  Channel n is output n % 8 of module n / 8, on these pins:
+ *      0 PB6   1 PB7   2 PB4   3 PB5   4 PE4   5 PE5   6 PC4   7 PC5
+ *      8 PD0   9 PD1  10 PA6  11 PA7  12 PF0  13 PF1  14 PF2  15 PF3
+ *  (4/5 share PE4/PE5 with UART5, 12 needs PF0 unlocked and is a button on
+ *  the LaunchPad, whose R9/R10 also tie PB6/PB7 to PD0/PD1, so 0/1 and 8/9
+ *  cannot both be used unless those resistors are removed; only configure
+ *  channels whose pins are free.)
+ *
+ *  All generators run in global sync mode: SERVO_SetCdeg()/SERVO_SetUs()
+ *  only stage a pulse, SERVO_Commit() makes every staged pulse take effect
+ *  together at the start of the next frame, so a multi-axis move never
+ *  shows half old, half new positions. Generators of one module are also
+ *  phase aligned.
+ *
+ *  Each servo maps centi-degrees to a pulse width in us through its own
+ *  calibration table (CALIB), which also gives its travel limits.
+ */
+
+#ifndef SERVO_SERVO_H_
+#define SERVO_SERVO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_memmap.h"
+#include "../CALIB/CALIB.h"
+
+#define SERVO_MIN_FRAME_HZ  50
+#define SERVO_MAX_FRAME_HZ  333
+#define SERVO_CHANNELS      16
+
+// channel of output ui32Out (0 - 7) of PWM module ui32Module (0 - 1)
+#define SERVO_CHANNEL(ui32Module, ui32Out) ((ui32Module) * 8 + (ui32Out))
+
+typedef struct
+{
+    uint32_t ui32Channel;           // 0 - SERVO_CHANNELS - 1
+    const tCalibTable *psCalib;     // angle to pulse, travel limits
+    uint32_t ui32Pulse;             // last pulse staged, PWM counts
+} tServo;
+
+/*
+ * Function declaration(s)
+ */
+extern uint32_t SERVO_Init(uint32_t ui32FrameHz);
+extern void SERVO_Config(tServo *psServo, uint32_t ui32Channel, const tCalibTable *psCalib);
+extern bool SERVO_SetCdeg(tServo *psServo, int32_t i32Cdeg);
+extern void SERVO_SetUs(tServo *psServo, uint32_t ui32Us);
+extern void SERVO_Commit(void);
+
+#endif /* SERVO_SERVO_H_ */
@@ -0,0 +1,265 @@
+/*
+ * TELEMETRY.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "TELEMETRY.h"
+
+// Sender configuration
+static uint32_t g_ui32Base;
+static int32_t g_i32Deadband;
+static int32_t g_i32RateDeadband;
+static uint32_t g_ui32KeyframePeriod;
+
+// Sender state: values the slave currently holds
+static int32_t g_i32SentYaw, g_i32SentPitch;
+static int32_t g_i32SentYawRate, g_i32SentPitchRate;
+static uint32_t g_ui32SinceKeyframe;
+static uint8_t g_ui8Seq;
+static bool g_bStarted;
+
+static tTelemetryStats g_sStats;
+
+static int32_t TELEMETRY_Abs(int32_t i32Value)
+{
+    return i32Value < 0 ? -i32Value : i32Value;
+}
+
+static void TELEMETRY_Send(uint8_t ui8Type, const uint8_t *pui8Payload, uint8_t ui8Len)
+{
+    LINK_Send(g_ui32Base, ui8Type, pui8Payload, ui8Len);
+
+    g_sStats.ui32Frames++;
+    g_sStats.ui32Bytes += ui8Len + LINK_OVERHEAD;
+}
+
+/*
+ * Configure the sender
+ * @param <uint32_t> $ui32Base UART the frames are written to
+ * @param <int32_t> $i32Deadband an axis is sent once its angle moved by more than this
+ * @param <int32_t> $i32RateDeadband ... or its rate changed by more than this (0.1 deg/s)
+ * @param <uint32_t> $ui32KeyframePeriod samples between two keyframes
+ * @return void
+ */
+void TELEMETRY_Init(uint32_t ui32Base, int32_t i32Deadband, int32_t i32RateDeadband,
+                    uint32_t ui32KeyframePeriod)
+{
+    g_ui32Base = ui32Base;
+    g_i32Deadband = i32Deadband;
+    g_i32RateDeadband = i32RateDeadband;
+    g_ui32KeyframePeriod = ui32KeyframePeriod;
+
+    g_ui32SinceKeyframe = 0;
+    g_ui8Seq = 0;
+    g_bStarted = false;
+
+    g_sStats.ui32Samples = 0;
+    g_sStats.ui32Suppressed = 0;
+    g_sStats.ui32Frames = 0;
+    g_sStats.ui32Keyframes = 0;
+    g_sStats.ui32Bytes = 0;
+}
+
+/*
+ * Offer a new sample, a frame is sent only if needed
+ * @param <int32_t> $i32Yaw current yaw
+ * @param <int32_t> $i32Pitch current pitch
+ * @param <int32_t> $i32YawRate yaw rate (0.1 deg/s)
+ * @param <int32_t> $i32PitchRate pitch rate (0.1 deg/s)
+ * @param <uint16_t> $ui16Timestamp time the sample was taken (ms)
+ * @return void
+ */
+void TELEMETRY_Update(int32_t i32Yaw, int32_t i32Pitch, int32_t i32YawRate, int32_t i32PitchRate,
+                      uint16_t ui16Timestamp)
+{
+    uint8_t pui8Payload[24];
+    uint8_t ui8Len = 0;
+    uint8_t ui8Mask = 0;
+
+    g_sStats.ui32Samples++;
+
+    if (!g_bStarted || ++g_ui32SinceKeyframe >= g_ui32KeyframePeriod)
+    {
+        pui8Payload[ui8Len++] = ++g_ui8Seq;
+        pui8Payload[ui8Len++] = (uint8_t)ui16Timestamp;
+        pui8Payload[ui8Len++] = (uint8_t)(ui16Timestamp >> 8);
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32Yaw);
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32Pitch);
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32YawRate);
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32PitchRate);
+        TELEMETRY_Send(LINK_TYPE_KEYFRAME, pui8Payload, ui8Len);
+
+        g_sStats.ui32Keyframes++;
+        g_i32SentYaw = i32Yaw;
+        g_i32SentPitch = i32Pitch;
+        g_i32SentYawRate = i32YawRate;
+        g_i32SentPitchRate = i32PitchRate;
+        g_ui32SinceKeyframe = 0;
+        g_bStarted = true;
+        return;
+    }
+
+    if (TELEMETRY_Abs(i32Yaw - g_i32SentYaw) > g_i32Deadband ||
+        TELEMETRY_Abs(i32YawRate - g_i32SentYawRate) > g_i32RateDeadband)
+        ui8Mask |= TELEMETRY_AXIS_YAW;
+    if (TELEMETRY_Abs(i32Pitch - g_i32SentPitch) > g_i32Deadband ||
+        TELEMETRY_Abs(i32PitchRate - g_i32SentPitchRate) > g_i32RateDeadband)
+        ui8Mask |= TELEMETRY_AXIS_PITCH;
+
+    if (!ui8Mask)
+    {
+        g_sStats.ui32Suppressed++;
+        return;
+    }
+
+    pui8Payload[ui8Len++] = ++g_ui8Seq;
+    pui8Payload[ui8Len++] = (uint8_t)ui16Timestamp;
+    pui8Payload[ui8Len++] = (uint8_t)(ui16Timestamp >> 8);
+    pui8Payload[ui8Len++] = ui8Mask;
+    if (ui8Mask & TELEMETRY_AXIS_YAW)
+    {
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32Yaw - g_i32SentYaw);
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32YawRate);
+        g_i32SentYaw = i32Yaw;
+        g_i32SentYawRate = i32YawRate;
+    }
+    if (ui8Mask & TELEMETRY_AXIS_PITCH)
+    {
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32Pitch - g_i32SentPitch);
+        ui8Len += LINK_PutVarint(pui8Payload + ui8Len, i32PitchRate);
+        g_i32SentPitch = i32Pitch;
+        g_i32SentPitchRate = i32PitchRate;
+    }
+    TELEMETRY_Send(LINK_TYPE_DELTA, pui8Payload, ui8Len);
+}
+
+void TELEMETRY_StatsGet(tTelemetryStats *psStats)
+{
+    *psStats = g_sStats;
+}
+
+/*
+ * Share of the link spent on telemetry
+ * @param <uint32_t> $ui32Baud UART rate of the link
+ * @param <uint32_t> $ui32ElapsedMs time since TELEMETRY_Init()
+ * @return <uint32_t> utilization in 1/1000 (10 bits on the wire per byte)
+ */
+uint32_t TELEMETRY_UtilizationGet(uint32_t ui32Baud, uint32_t ui32ElapsedMs)
+{
+    uint64_t ui64Capacity = (uint64_t)ui32Baud * ui32ElapsedMs;
+
+    if (ui64Capacity == 0)
+        return 0;
+
+    return (uint32_t)((uint64_t)g_sStats.ui32Bytes * 10 * 1000 * 1000 / ui64Capacity);
+}
+
+void TELEMETRY_ReceiverInit(tTelemetryReceiver *psRx)
+{
+    psRx->i32Yaw = 0;
+    psRx->i32Pitch = 0;
+    psRx->i32YawRate = 0;
+    psRx->i32PitchRate = 0;
+    psRx->ui16Timestamp = 0;
+    psRx->ui8Seq = 0;
+    psRx->bSynced = false;
+    psRx->ui32Frames = 0;
+    psRx->ui32Lost = 0;
+}
+
+/*
+ * Read the varints of a frame
+ * @return <bool> false if the payload is truncated
+ */
+static bool TELEMETRY_GetVarints(const uint8_t *pui8Data, uint32_t ui32Left, int32_t *pi32Values,
+                                 uint32_t ui32Count)
+{
+    uint32_t ui32Used;
+
+    while (ui32Count--)
+    {
+        ui32Used = LINK_GetVarint(pui8Data, ui32Left, pi32Values++);
+        if (!ui32Used)
+            return false;
+        pui8Data += ui32Used;
+        ui32Left -= ui32Used;
+    }
+    return true;
+}
+
+/*
+ * Apply a telemetry frame on the slave
+ * @param <tTelemetryReceiver *> $psRx receiver state, holds the decoded values
+ * @param <const tLinkFrame *> $psFrame frame from LINK_Parse()
+ * @return <uint32_t> TELEMETRY_AXIS_* mask of the axes that were updated
+ */
+uint32_t TELEMETRY_Receive(tTelemetryReceiver *psRx, const tLinkFrame *psFrame)
+{
+    const uint8_t *pui8Data = psFrame->pui8Payload;
+    uint32_t ui32Left = psFrame->ui8Len;
+    int32_t pi32Values[4];
+    uint32_t ui32Count;
+    uint16_t ui16Timestamp;
+    uint8_t ui8Seq, ui8Mask;
+
+    if (ui32Left < 4)
+        return 0;
+
+    ui8Seq = pui8Data[0];
+    ui16Timestamp = pui8Data[1] | ((uint16_t)pui8Data[2] << 8);
+    pui8Data += 3;
+    ui32Left -= 3;
+
+    if (psFrame->ui8Type == LINK_TYPE_KEYFRAME)
+    {
+        if (!TELEMETRY_GetVarints(pui8Data, ui32Left, pi32Values, 4))
+            return 0;
+
+        if (psRx->bSynced && ui8Seq != (uint8_t)(psRx->ui8Seq + 1))
+            psRx->ui32Lost++;
+
+        psRx->i32Yaw = pi32Values[0];
+        psRx->i32Pitch = pi32Values[1];
+        psRx->i32YawRate = pi32Values[2];
+        psRx->i32PitchRate = pi32Values[3];
+        psRx->ui16Timestamp = ui16Timestamp;
+        psRx->ui8Seq = ui8Seq;
+        psRx->bSynced = true;
+        psRx->ui32Frames++;
+        return TELEMETRY_AXIS_YAW | TELEMETRY_AXIS_PITCH;
+    }
+
+    if (psFrame->ui8Type != LINK_TYPE_DELTA)
+        return 0;
+
+    if (psRx->bSynced && ui8Seq != (uint8_t)(psRx->ui8Seq + 1))
+    {
+        // a delta went missing, the values are wrong until the next keyframe
+        psRx->ui32Lost++;
+        psRx->bSynced = false;
+    }
+    psRx->ui8Seq = ui8Seq;
+    if (!psRx->bSynced)
+        return 0;
+
+    ui8Mask = *pui8Data++ & (TELEMETRY_AXIS_YAW | TELEMETRY_AXIS_PITCH);
+    ui32Left--;
+    ui32Count = (ui8Mask == (TELEMETRY_AXIS_YAW | TELEMETRY_AXIS_PITCH)) ? 4 : 2;
+    if (!ui8Mask || !TELEMETRY_GetVarints(pui8Data, ui32Left, pi32Values, ui32Count))
+        return 0;
+
+    if (ui8Mask & TELEMETRY_AXIS_YAW)
+    {
+        psRx->i32Yaw += pi32Values[0];
+        psRx->i32YawRate = pi32Values[1];
+    }
+    if (ui8Mask & TELEMETRY_AXIS_PITCH)
+    {
+        psRx->i32Pitch += pi32Values[ui32Count - 2];
+        psRx->i32PitchRate = pi32Values[ui32Count - 1];
+    }
+    psRx->ui16Timestamp = ui16Timestamp;
+    psRx->ui32Frames++;
+    return ui8Mask;
+}
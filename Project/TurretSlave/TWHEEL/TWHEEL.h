@@ -0,0 +1,64 @@
+/*
+ * TWHEEL.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Software timers on one hardware timer.
+ *  TIMER0 counts up at the system clock and never stops; the time is kept in
+ *  microseconds. Timers sit in a hierarchical wheel of TWHEEL_LEVELS levels
+ *  of TWHEEL_SLOTS slots: level 0 holds the timers due in the next 32 us, one
+ *  slot per microsecond, each level above covers 32 times the range of the
+ *  one below. A timer is linked into one slot list, so starting and stopping
+ *  are O(1). When the wheel reaches a slot of an upper level, its timers
+ *  move down to where their time now falls.
+ *
+ *  The wheel is tickless: the match interrupt is set to the next slot that
+ *  has to be looked at and the time in between is skipped in one step, so an
+ *  idle wheel does not interrupt at all (at most every TWHEEL_MAX_SLEEP).
+ *  Callbacks run in the timer interrupt and must be short.
+ */
+
+#ifndef TWHEEL_TWHEEL_H_
+#define TWHEEL_TWHEEL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TWHEEL_SLOT_BITS    5
+#define TWHEEL_SLOTS        (1 << TWHEEL_SLOT_BITS)
+#define TWHEEL_LEVELS       5                               // 2^25 us, longer timers are moved down again
+#define TWHEEL_RANGE        (1UL << (TWHEEL_SLOT_BITS * TWHEEL_LEVELS))
+#define TWHEEL_MAX_SLEEP    (1UL << 24)                     // us, the counter difference has to fit 31 bits
+
+typedef void (*tTWheelCallback)(void *pvData);
+
+typedef struct tTWheelTimer
+{
+    struct tTWheelTimer *psNext;
+    struct tTWheelTimer **ppsPrev;  // link pointing here, 0 while stopped
+    uint32_t ui32Expires;           // TWHEEL_Now() of the next call
+    uint32_t ui32Period;            // us, 0 for a one shot
+    uint8_t ui8Level, ui8Slot;
+    tTWheelCallback pfnCallback;
+    void *pvData;
+} tTWheelTimer;
+
+typedef struct
+{
+    uint32_t ui32Wakeups;           // timer interrupts
+    uint32_t ui32Fired;             // callbacks
+    uint32_t ui32Cascaded;          // timers moved down a level
+} tTWheelStats;
+
+/*
+ * Function declaration(s)
+ */
+extern void TWHEEL_Init(void);
+extern uint32_t TWHEEL_Now(void);
+extern void TWHEEL_TimerInit(tTWheelTimer *psTimer, tTWheelCallback pfnCallback, void *pvData);
+extern void TWHEEL_TimerStart(tTWheelTimer *psTimer, uint32_t ui32DelayUs, uint32_t ui32PeriodUs);
+extern void TWHEEL_TimerStop(tTWheelTimer *psTimer);
+extern bool TWHEEL_TimerActive(const tTWheelTimer *psTimer);
+extern void TWHEEL_StatsGet(tTWheelStats *psStats);
+
+#endif /* TWHEEL_TWHEEL_H_ */
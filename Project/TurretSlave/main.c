@@ -1,6 +1,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "driverlib/debug.h"
 #include "driverlib/gpio.h"
 #include "driverlib/interrupt.h"
@@ -8,26 +9,91 @@
 #include "driverlib/pwm.h"
 #include "driverlib/rom.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
 #include "driverlib/uart.h"
 #include "inc/hw_gpio.h"
 #include "inc/hw_ints.h"
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
 #include "utils/uartstdio.h"
+#include "FORMAT/FORMAT.h"
+#include "HC05/HC05.h"
+#include "LINK/LINK.h"
+#include "TELEMETRY/TELEMETRY.h"
+#include "PREDICT/PREDICT.h"
+#include "CALIB/CALIB.h"
+#include "SERVO/SERVO.h"
+#include "SYNC/SYNC.h"
+#include "TIME/TIME.h"
+#include "SCHED/SCHED.h"
+#include "LOAD/LOAD.h"
+#include "DMAUART/DMAUART.h"
+#include "TWHEEL/TWHEEL.h"
+#include "RING/RING.h"
+#include "BUTTON/BUTTON.h"
 /*
  * Motor functions
  */
-#define PWM_FREQUENCY 55
-#define SERVO_MIN_PITCH 45
+// Frame rate of the servo PWM, digital servos take up to 333 Hz (use 50 for analog ones)
+#define SERVO_FRAME_HZ 333
 #define SERVO_INIT_PITCH 100
-#define SERVO_MAX_PITCH 110
-#define SERVO_MIN_YAW 20
 #define SERVO_INIT_YAW 90
-#define SERVO_MAX_YAW 160
 
-// Store the pwm clock
-volatile uint32_t ui32Load;
-volatile uint32_t ui32PWMClock;
+// Bank channels of the turret servos, M1PWM0 on PD0 and M1PWM1 on PD1
+#define SERVO_CHANNEL_YAW SERVO_CHANNEL(1, 0)
+#define SERVO_CHANNEL_PITCH SERVO_CHANNEL(1, 1)
+// Further channels whose pins are free on this board: PB4 PB5 PC4 PC5 PA6 PA7
+// (PE4/PE5 carry UART5, PF0 and PF1-PF3 the buttons and LEDs, and R9/R10 short
+// PB6/PB7 to the yaw/pitch pins PD0/PD1, so channels 0/1 need those removed first)
+#define SERVO_AUX_MASK 0x0CCC
+
+// EEPROM slots of the calibration tables, one per bank channel
+#define CALIB_CHANNEL_YAW SERVO_CHANNEL_YAW
+#define CALIB_CHANNEL_PITCH SERVO_CHANNEL_PITCH
+
+// Calibration used until one is stored: the travel limits (0.01 deg) with the
+// pulse (us) of the old 55 Hz mapping, where a degree was 0.1% of the period
+static const tCalibPoint CALIB_DEFAULT_YAW[] = { { 2000, 364 }, { 14000, 2545 } };
+static const tCalibPoint CALIB_DEFAULT_PITCH[] = { { 4500, 818 }, { 11000, 2000 } };
+// Auxiliary servos without a stored table: 0 - 180 deg over 500 - 2500 us
+static const tCalibPoint CALIB_DEFAULT_AUX[] = { { 0, 500 }, { 18000, 2500 } };
+
+// Servo positions are recomputed from the predictor once per PWM frame
+#define SERVO_UPDATE_HZ SERVO_FRAME_HZ
+// Expected age of a telemetry frame when it arrives
+#define LINK_LEAD_MS 20
+// Address of this turret on the link, and the groups (bit n = group n) it is in
+#define LINK_NODE_ADDR 1
+#define LINK_NODE_GROUPS 0x01
+
+/*
+ * Tasks, the id is also the priority (0 runs first)
+ */
+#define TASK_LINK 0         // urgent, hands the UART5 DMA buffers back before they run out
+#define TASK_SERVO 1
+#define TASK_BUTTON 2
+#define TASK_CONSOLE 3
+#define TASK_LINK_TEXT 4    // text lines the link task found between frames
+#define TASK_COUNT 5
+
+/*
+ * Interrupt handlers with their own busy time
+ */
+#define ISR_CONSOLE 0
+#define ISR_LINK 1
+#define ISR_BUTTON 2
+#define ISR_SERVO 3
+#define ISR_COUNT 4
+
+// The two servos on PWM1 and their calibration
+tServo servoYaw;
+tServo servoPitch;
+tCalibTable calibYaw;
+tCalibTable calibPitch;
+
+// Auxiliary servos, indexed by bank channel, only those in SERVO_AUX_MASK are used
+tServo servoAux[SERVO_CHANNELS];
+tCalibTable calibAux[SERVO_CHANNELS];
 
 // Store the value of the servo
 volatile uint32_t ui32ServoYawValue;
@@ -37,64 +103,178 @@ volatile uint32_t ui32ServoPitchValue;
 char uartReceive[100];
 int uartReceiveCount = 0;
 
+// Text bytes from UART5 between frames, from LinkTask to LinkTextTask,
+// which assembles them into its own line
+#define LINK_TEXT_RING_SIZE 128
+uint8_t linkTextBuffer[LINK_TEXT_RING_SIZE];
+tRing linkText;
+volatile uint32_t linkTextDropped = 0;
+char linkReceive[100];
+int linkReceiveCount = 0;
+
+// UART0 bytes from the interrupt to ConsoleTask
+#define CONSOLE_RING_SIZE 256
+uint8_t consoleRxBuffer[CONSOLE_RING_SIZE];
+tRing consoleRx;
+volatile uint32_t consoleRxDropped = 0;
+
+// Machine mode, for a program on the PC: no echo on UART0,
+// every line is answered with "k\n" or "e\n" once it has been applied
+bool machineMode = false;
+
 // Bonus
-bool doingMove = false;
+volatile bool doingMove = false;
+
+// Binary telemetry frames from the master
+tLinkParser linkParser;
+tTelemetryReceiver telemetry;
+
+// Extrapolation between telemetry frames
+tPredictAxis predictYaw;
+tPredictAxis predictPitch;
+
+// Set the left/right rotation of the servo
+void SetServoYaw(int value)
+{
+    SERVO_SetCdeg(&servoYaw, value * 100);
+    SERVO_Commit();
+}
+
+// Set the up/down rotation of the servo
+void SetServoPitch(int value)
+{
+    SERVO_SetCdeg(&servoPitch, value * 100);
+    SERVO_Commit();
+}
+
+void InitializePWM()
+{
+    uint32_t i;
+
+    // Stored calibration, or the defaults
+    CALIB_Init();
+    if (!CALIB_Load(CALIB_CHANNEL_YAW, &calibYaw))
+        CALIB_Set(&calibYaw, CALIB_DEFAULT_YAW, sizeof(CALIB_DEFAULT_YAW) / sizeof(CALIB_DEFAULT_YAW[0]));
+    if (!CALIB_Load(CALIB_CHANNEL_PITCH, &calibPitch))
+        CALIB_Set(&calibPitch, CALIB_DEFAULT_PITCH, sizeof(CALIB_DEFAULT_PITCH) / sizeof(CALIB_DEFAULT_PITCH[0]));
+
+    SERVO_Init(SERVO_FRAME_HZ);
+    SERVO_Config(&servoYaw, SERVO_CHANNEL_YAW, &calibYaw);
+    SERVO_Config(&servoPitch, SERVO_CHANNEL_PITCH, &calibPitch);
+
+    for (i = 0; i < SERVO_CHANNELS; i++)
+    {
+        if (!(SERVO_AUX_MASK & (1 << i)))
+            continue;
+        if (!CALIB_Load(i, &calibAux[i]))
+            CALIB_Set(&calibAux[i], CALIB_DEFAULT_AUX, sizeof(CALIB_DEFAULT_AUX) / sizeof(CALIB_DEFAULT_AUX[0]));
+        SERVO_Config(&servoAux[i], i, &calibAux[i]);
+    }
+}
 
 /*
- * Generic Utilities
+ * The urgent LinkTask updates the predictors and preempts the thread mode
+ * tasks, so every access to them is made with interrupts masked
  */
-void delayMS(int ms)
+void PredictUpdate(tPredictAxis *psAxis, int32_t i32PosCdeg, int32_t i32RateDeci)
 {
-    SysCtlDelay((SysCtlClockGet() / (3 * 1000)) * ms); // less accurate
+    bool bMasked = IntMasterDisable();
+
+    PREDICT_Update(psAxis, i32PosCdeg, i32RateDeci, TIME_Ms());
+    if (!bMasked)
+        IntMasterEnable();
 }
 
-// Set the left/right rotation of the servo
-void SetServoYaw(int value)
+// Move the servos to the predicted position
+void ServoTask(void)
 {
-    if (value > SERVO_MAX_YAW || value < SERVO_MIN_YAW)
-    {
+    uint32_t ui32Now = TIME_Ms();
+    int32_t i32Yaw, i32Pitch;
+    bool bMasked;
+
+    if (doingMove)
         return;
-    }
-    PWMPulseWidthSet(PWM1_BASE, PWM_OUT_0, value * ui32Load / 1000);
 
-    delayMS(1);       // delay some time
+    bMasked = IntMasterDisable();
+    i32Yaw = PREDICT_Output(&predictYaw, ui32Now);
+    i32Pitch = PREDICT_Output(&predictPitch, ui32Now);
+    if (!bMasked)
+        IntMasterEnable();
+
+    // 0.01 degree steps instead of whole degrees, both axes in the same frame
+    SERVO_SetCdeg(&servoYaw, (i32Yaw + 5) / 10);
+    SERVO_SetCdeg(&servoPitch, (i32Pitch + 5) / 10);
+    SERVO_Commit();
 }
 
-// Set the up/down rotation of the servo
-void SetServoPitch(int value)
+/*
+ * Multi-axis frame from the link. The whole frame is decoded before anything
+ * moves, the turret axes go through the predictor, every other channel is
+ * staged directly, and all of them start in the same PWM frame.
+ */
+void ProcessServoFrame(const tLinkFrame *psFrame)
 {
-    if (value > SERVO_MAX_PITCH || value < SERVO_MIN_PITCH)
-    {
+    int32_t pi32Cdeg[SERVO_CHANNELS];
+    uint32_t ui32Mask, ui32Pos, ui32Used;
+    uint32_t i;
+
+    if (psFrame->ui8Len < 2)
         return;
+    ui32Mask = psFrame->pui8Payload[0] | ((uint32_t)psFrame->pui8Payload[1] << 8);
+    ui32Pos = 2;
+    for (i = 0; i < SERVO_CHANNELS; i++)
+    {
+        if (!(ui32Mask & (1 << i)))
+            continue;
+        ui32Used = LINK_GetVarint(psFrame->pui8Payload + ui32Pos, psFrame->ui8Len - ui32Pos, &pi32Cdeg[i]);
+        if (!ui32Used)
+            return;
+        ui32Pos += ui32Used;
+    }
+
+    for (i = 0; i < SERVO_CHANNELS; i++)
+    {
+        if (!(ui32Mask & (1 << i)))
+            continue;
+        if (i == SERVO_CHANNEL_YAW)
+        {
+            ui32ServoYawValue = pi32Cdeg[i] / 100;
+            PredictUpdate(&predictYaw, pi32Cdeg[i], 0);
+        }
+        else if (i == SERVO_CHANNEL_PITCH)
+        {
+            ui32ServoPitchValue = pi32Cdeg[i] / 100;
+            PredictUpdate(&predictPitch, pi32Cdeg[i], 0);
+        }
+        else if (SERVO_AUX_MASK & (1 << i))
+            SERVO_SetCdeg(&servoAux[i], pi32Cdeg[i]);
     }
-    PWMPulseWidthSet(PWM1_BASE, PWM_OUT_1, value * ui32Load / 1000);
 
-    delayMS(1);       // delay some time
+    // the turret axes join the frame unless a gesture owns them
+    ServoTask();
+    SERVO_Commit();
 }
 
-void InitializePWM()
+tTWheelTimer servoTimer;
+
+// Runs in the timer wheel interrupt
+void ServoUpdateTick(void *pvData)
 {
-    SysCtlPWMClockSet(SYSCTL_PWMDIV_64);
-
-    // Enable GPIOD to output signals to servo
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD);
-    // Enable PWM0 and PWM1 to generate PWM signals
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0 | SYSCTL_PERIPH_PWM1);
-
-    // Set PD0 and PD1 as PWM pin
-    GPIOPinTypePWM(GPIO_PORTD_BASE, GPIO_PIN_0 | GPIO_PIN_1);
-    GPIOPinConfigure(GPIO_PD0_M1PWM0);
-    GPIOPinConfigure(GPIO_PD1_M1PWM1);
-
-    // Get the frequency of the pwm control clock
-    ui32PWMClock = SysCtlClockGet() / 64;
-    ui32Load = (ui32PWMClock / PWM_FREQUENCY) - 1;
-    PWMGenConfigure(PWM1_BASE, PWM_GEN_0, PWM_GEN_MODE_DOWN);
-    PWMGenPeriodSet(PWM1_BASE, PWM_GEN_0, ui32Load);
-
-    // Enable PWM
-    PWMOutputState(PWM1_BASE, PWM_OUT_0_BIT | PWM_OUT_1_BIT, true);
-    PWMGenEnable(PWM1_BASE, PWM_GEN_0);
+    uint32_t ui32Start = LOAD_IsrBegin();
+
+    SCHED_Post(TASK_SERVO);
+    LOAD_IsrEnd(ISR_SERVO, ui32Start);
+}
+
+void InitializeServoTimer(void)
+{
+    PREDICT_Init(&predictYaw, CALIB_MinCdeg(&calibYaw), CALIB_MaxCdeg(&calibYaw), SERVO_INIT_YAW * 100,
+                 LINK_LEAD_MS);
+    PREDICT_Init(&predictPitch, CALIB_MinCdeg(&calibPitch), CALIB_MaxCdeg(&calibPitch), SERVO_INIT_PITCH * 100,
+                 LINK_LEAD_MS);
+
+    TWHEEL_TimerInit(&servoTimer, ServoUpdateTick, 0);
+    TWHEEL_TimerStart(&servoTimer, 1000000 / SERVO_UPDATE_HZ, 1000000 / SERVO_UPDATE_HZ);
 }
 
 /*
@@ -113,41 +293,15 @@ void UARTStringPut(uint32_t ui32Base, char *str)
 
 void UARTIntPut(uint32_t ui32Base, int value)
 {
-    char temp[10];
-    char result[10];
-    int tempCount = 0;
-    int resultCount = 0;
-
-    if (value == 0)
-    {
-        result[0] = '0';
-        result[1] = '\0';
-        UARTCharPut(ui32Base, '0');
-    }
-
-    if (value < 0)
-    {
-        result[resultCount++] = '-';
-        value *= -1;
-    }
-
-    // Covert to char from LSB
-    while (value > 0)
-    {
-        temp[tempCount++] = (value % 10) + '0';
-        value /= 10;
-    }
-
-    // Put back the result from MSB
-    while (--tempCount >= 0)
-    {
-        result[resultCount++] = temp[tempCount];
-    }
-    result[resultCount] = '\0';
+    char result[FORMAT_INT_MAX_LEN];
 
+    FORMAT_Int(result, value);
     UARTStringPut(ui32Base, result);
 }
 
+// UART5 rates tried with the HC-05 at boot, fastest first
+static const uint32_t HC05_RATES[] = { 460800, 230400, 115200 };
+
 void InitializeUART(void)
 {
     // enable UART0 and GPIOA.
@@ -166,197 +320,567 @@ void InitializeUART(void)
     UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 115200,
                         (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
 
-    // enable UART5 and GPIOE
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART5);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-
-    // Configure board PE4 for RX
-    // configure board PE5 for TX
-    GPIOPinConfigure(GPIO_PE4_U5RX);
-    GPIOPinConfigure(GPIO_PE5_U5TX);
-    // set PORTE pin4 and pin5 as UART type
-    GPIOPinTypeUART(GPIO_PORTE_BASE, GPIO_PIN_4 | GPIO_PIN_5);
-
-    // set UART base addr., system clock, baud rate
-    // used to communicate with HC-05
-    UARTConfigSetExpClk(UART5_BASE, SysCtlClockGet(), 38400,
-                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+    // UART5 is used to communicate with HC-05,
+    // raise its rate from the 38400 baud default as far as the module allows
+    HC05_Init();
+    HC05_Configure(HC05_RATES, sizeof(HC05_RATES) / sizeof(HC05_RATES[0]));
 
-    GPIOPinTypeGPIOOutput(GPIO_PORTE_BASE, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
-    GPIOPinWrite(GPIO_PORTE_BASE, GPIO_PIN_2 | GPIO_PIN_1 | GPIO_PIN_3, 2);
+    UARTStringPut(UART0_BASE, "HC-05 baud: ");
+    UARTIntPut(UART0_BASE, HC05_BaudGet());
+    UARTStringPut(UART0_BASE, "\n\r");
 
     // set interrupt for receiving and showing values
+    RING_Init(&consoleRx, consoleRxBuffer, CONSOLE_RING_SIZE);
+    RING_Init(&linkText, linkTextBuffer, LINK_TEXT_RING_SIZE);
     IntMasterEnable();
     IntEnable(INT_UART0);
     UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    // the link runs on the DMA, UART5IntHandler only sees its completions
+    DMAUART_Init(UART5_BASE);
+    LINK_TransportSet(DMAUART_Write);
     IntEnable(INT_UART5);
-    UARTIntEnable(UART5_BASE, UART_INT_RX | UART_INT_RT);
 }
 
-void ButtonIntHandler(void)
+void ShowPredictStats(char *name, tPredictAxis *psAxis)
+{
+    UARTStringPut(UART0_BASE, name);
+    UARTStringPut(UART0_BASE, " err mean/max (mdeg): ");
+    UARTIntPut(UART0_BASE, PREDICT_ErrorMean(psAxis));
+    UARTStringPut(UART0_BASE, "/");
+    UARTIntPut(UART0_BASE, psAxis->ui32ErrorMax);
+    UARTStringPut(UART0_BASE, " updates: ");
+    UARTIntPut(UART0_BASE, psAxis->ui32Updates);
+    UARTStringPut(UART0_BASE, "\n\r");
+}
+
+// Runs, mean and longest run of every task
+void ShowTaskStats(void)
 {
-    GPIOIntClear(GPIO_PORTF_BASE, GPIO_INT_PIN_4 | GPIO_INT_PIN_5);
+    uint32_t ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    uint32_t i;
 
-    // Check whether the button is pressed
-    if(GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_4)==0x00)
+    for (i = 0; i < TASK_COUNT; i++)
     {
-        doingMove = true;
-        // Nodding
-        SetServoPitch(50);
-        delayMS(200);
-        SetServoPitch(80);
-        delayMS(200);
-        SetServoPitch(50);
-        delayMS(200);
-        SetServoPitch(80);
-        delayMS(200);
-        SetServoPitch(50);
-        doingMove = false;
+        const tSchedTaskInfo *psTask = SCHED_TaskGet(i);
+
+        UARTStringPut(UART0_BASE, (char *)psTask->pcName);
+        UARTStringPut(UART0_BASE, " runs: ");
+        UARTIntPut(UART0_BASE, psTask->ui32Runs);
+        UARTStringPut(UART0_BASE, " mean/max (us): ");
+        UARTIntPut(UART0_BASE, psTask->ui32Runs ? psTask->ui64Cycles / psTask->ui32Runs / ui32CyclesPerUs : 0);
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, psTask->ui32MaxCycles / ui32CyclesPerUs);
+        UARTStringPut(UART0_BASE, "\n\r");
     }
+}
+
+// Calls, share of the last load window and longest run of every instrumented handler
+void ShowIsrStats(void)
+{
+    uint32_t ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    uint32_t i;
 
-    // Check whether the button is pressed
-    if(GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_0)==0x00)
+    for (i = 0; i < ISR_COUNT; i++)
     {
-        doingMove = true;
-        // Shaking
-        SetServoYaw(60);
-        delayMS(200);
-        SetServoYaw(120);
-        delayMS(200);
-        SetServoYaw(60);
-        delayMS(200);
-        SetServoYaw(120);
-        delayMS(200);
-        SetServoYaw(120);
-        doingMove = false;
+        const tLoadIsrInfo *psIsr = LOAD_IsrGet(i);
+
+        UARTStringPut(UART0_BASE, (char *)psIsr->pcName);
+        UARTStringPut(UART0_BASE, " isr calls: ");
+        UARTIntPut(UART0_BASE, psIsr->ui32Count);
+        UARTStringPut(UART0_BASE, " load (1/1000): ");
+        UARTIntPut(UART0_BASE, psIsr->ui32Permille);
+        UARTStringPut(UART0_BASE, " max (us): ");
+        UARTIntPut(UART0_BASE, psIsr->ui32MaxCycles / ui32CyclesPerUs);
+        UARTStringPut(UART0_BASE, "\n\r");
     }
 }
 
-void InitializeButton(void)
+void ShowCalib(char *name, tCalibTable *psTable)
 {
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
-    HWREG(GPIO_PORTF_BASE + GPIO_O_CR)  |= 0x01;
-    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = 0;
-    GPIODirModeSet(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0, GPIO_DIR_MODE_IN);
-    GPIOPadConfigSet(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
-    GPIOIntEnable(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0);                 // interrupt enable
-    GPIOIntTypeSet(GPIO_PORTF_BASE, GPIO_PIN_4|GPIO_PIN_0, GPIO_FALLING_EDGE); // only interrupt at falling edge (pressed)
-    GPIOIntRegister(GPIO_PORTF_BASE, ButtonIntHandler);           // dynamic isr registering
+    uint32_t i;
+
+    UARTStringPut(UART0_BASE, name);
+    UARTStringPut(UART0_BASE, " (0.01 deg:us):");
+    for (i = 0; i < psTable->ui32Count; i++)
+    {
+        UARTStringPut(UART0_BASE, " ");
+        UARTIntPut(UART0_BASE, psTable->psPoint[i].i16Cdeg);
+        UARTStringPut(UART0_BASE, ":");
+        UARTIntPut(UART0_BASE, psTable->psPoint[i].ui16Us);
+    }
+    UARTStringPut(UART0_BASE, "\n\r");
 }
 
-void Initialize(void)
+/*
+ * Calibration commands, after the leading 'c':
+ *      y / p                   show the yaw / pitch table
+ *      y<0.01 deg> <us>        add a breakpoint, or move the one at that angle
+ *      yd<0.01 deg>            remove a breakpoint
+ *      yr                      back to the defaults
+ *      w                       store both tables in the EEPROM
+ */
+void ProcessCalibCommand(char *args)
 {
-    // set clock
-    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    tCalibTable *psTable;
+    const tCalibPoint *psDefault;
+    uint32_t ui32DefaultCount;
+    char *end;
+    long cdeg, us;
+    bool ok = true;
+    bool bMasked;
+
+    if (args[0] == 'w' || args[0] == 'W')
+    {
+        ok = CALIB_Save(CALIB_CHANNEL_YAW, &calibYaw) && CALIB_Save(CALIB_CHANNEL_PITCH, &calibPitch);
+        UARTStringPut(UART0_BASE, ok ? "saved\n\r" : "EEPROM error\n\r");
+        return;
+    }
+    if (args[0] == 'y' || args[0] == 'Y')
+    {
+        psTable = &calibYaw;
+        psDefault = CALIB_DEFAULT_YAW;
+        ui32DefaultCount = sizeof(CALIB_DEFAULT_YAW) / sizeof(CALIB_DEFAULT_YAW[0]);
+    }
+    else if (args[0] == 'p' || args[0] == 'P')
+    {
+        psTable = &calibPitch;
+        psDefault = CALIB_DEFAULT_PITCH;
+        ui32DefaultCount = sizeof(CALIB_DEFAULT_PITCH) / sizeof(CALIB_DEFAULT_PITCH[0]);
+    }
+    else
+        return;
 
-    InitializeButton();
+    if (args[1] == 'r' || args[1] == 'R')
+        CALIB_Set(psTable, psDefault, ui32DefaultCount);
+    else if (args[1] == 'd' || args[1] == 'D')
+        ok = CALIB_PointRemove(psTable, strtol(args + 2, 0, 10));
+    else if (args[1] != '\0')
+    {
+        cdeg = strtol(args + 1, &end, 10);
+        us = strtol(end, 0, 10);
+        ok = CALIB_PointSet(psTable, cdeg, us);
+    }
 
-    // Initialize UART
-    InitializeUART();
+    // the predictor keeps the servos inside the new limits
+    bMasked = IntMasterDisable();
+    predictYaw.i32Min = CALIB_MinCdeg(&calibYaw) * 10;
+    predictYaw.i32Max = CALIB_MaxCdeg(&calibYaw) * 10;
+    predictPitch.i32Min = CALIB_MinCdeg(&calibPitch) * 10;
+    predictPitch.i32Max = CALIB_MaxCdeg(&calibPitch) * 10;
+    if (!bMasked)
+        IntMasterEnable();
+
+    if (!ok)
+        UARTStringPut(UART0_BASE, "rejected\n\r");
+    ShowCalib(psTable == &calibYaw ? "yaw" : "pitch", psTable);
+}
 
-    InitializePWM();
+// Handle a line entered on UART0 or received as text on UART5, false if it was rejected
+bool ProcessCommand(char *line)
+{
+    // whole degrees, checked against the travel limits before scaling so a long number cannot overflow
+    int32_t value = atoi(line + 1);
+    tDmaUartStats sDma;
 
-    // set the servo's initial position
-    SetServoPitch(SERVO_INIT_PITCH);
-    SetServoYaw(SERVO_INIT_YAW);
+    if (line[0] == 'p' || line[0] == 'P')
+    {
+        // Set pitch value
+        if (value < CALIB_MinCdeg(&calibPitch) / 100 || value > CALIB_MaxCdeg(&calibPitch) / 100 ||
+            value * 100 < CALIB_MinCdeg(&calibPitch) || value * 100 > CALIB_MaxCdeg(&calibPitch))
+            return false;
+        ui32ServoPitchValue = value;
+        PredictUpdate(&predictPitch, value * 100, 0);
+    }
+    else if (line[0] == 'y' || line[0] == 'Y')
+    {
+        // Set yaw value
+        if (value < CALIB_MinCdeg(&calibYaw) / 100 || value > CALIB_MaxCdeg(&calibYaw) / 100 ||
+            value * 100 < CALIB_MinCdeg(&calibYaw) || value * 100 > CALIB_MaxCdeg(&calibYaw))
+            return false;
+        ui32ServoYawValue = value;
+        PredictUpdate(&predictYaw, value * 100, 0);
+    }
+    else if (line[0] == 'c' || line[0] == 'C')
+    {
+        // Calibration
+        ProcessCalibCommand(line + 1);
+    }
+    else if (line[0] == 's' || line[0] == 'S')
+    {
+        // Show link and prediction statistics
+        UARTStringPut(UART0_BASE, "frames: ");
+        UARTIntPut(UART0_BASE, telemetry.ui32Frames);
+        UARTStringPut(UART0_BASE, " lost: ");
+        UARTIntPut(UART0_BASE, telemetry.ui32Lost);
+        UARTStringPut(UART0_BASE, " crc errors: ");
+        UARTIntPut(UART0_BASE, linkParser.ui32Errors);
+        UARTStringPut(UART0_BASE, " other nodes: ");
+        UARTIntPut(UART0_BASE, linkParser.ui32Filtered);
+        UARTStringPut(UART0_BASE, " rtt (us): ");
+        UARTIntPut(UART0_BASE, SYNC_RttGet());
+        UARTStringPut(UART0_BASE, " lead (ms): ");
+        UARTIntPut(UART0_BASE, predictYaw.ui32LeadMs);
+        UARTStringPut(UART0_BASE, "\n\r");
+        ShowPredictStats("yaw", &predictYaw);
+        ShowPredictStats("pitch", &predictPitch);
+        UARTStringPut(UART0_BASE, "cpu load mean/peak (1/1000): ");
+        UARTIntPut(UART0_BASE, LOAD_Permille());
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, LOAD_PeakPermille());
+        UARTStringPut(UART0_BASE, " master: ");
+        UARTIntPut(UART0_BASE, LOAD_RemotePermille());
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, LOAD_RemotePeakPermille());
+        UARTStringPut(UART0_BASE, "\n\r");
+        DMAUART_StatsGet(UART5_BASE, &sDma);
+        UARTStringPut(UART0_BASE, "dma rx bytes/buffers/timeouts/starved: ");
+        UARTIntPut(UART0_BASE, sDma.ui32RxBytes);
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, sDma.ui32RxBuffers);
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, sDma.ui32RxTimeouts);
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, sDma.ui32RxStarved);
+        UARTStringPut(UART0_BASE, " tx bytes/transfers: ");
+        UARTIntPut(UART0_BASE, sDma.ui32TxBytes);
+        UARTStringPut(UART0_BASE, "/");
+        UARTIntPut(UART0_BASE, sDma.ui32TxTransfers);
+        UARTStringPut(UART0_BASE, " console dropped: ");
+        UARTIntPut(UART0_BASE, consoleRxDropped);
+        UARTStringPut(UART0_BASE, " link text dropped: ");
+        UARTIntPut(UART0_BASE, linkTextDropped);
+        UARTStringPut(UART0_BASE, "\n\r");
+        ShowTaskStats();
+        ShowIsrStats();
+    }
+    else
+        return false;
+    return true;
 }
 
-int main(void)
+/*
+ * Handle a line entered on UART0. "m1" enters machine mode, "m0" goes back to
+ * the terminal, and several commands can be batched with ';' (e.g. "y90;p45").
+ */
+bool ProcessConsoleLine(char *line)
 {
-    Initialize();
+    char *cmd = line;
+    char *next;
+    bool ok = true;
 
-    while (1)
+    if (line[0] == 'm' || line[0] == 'M')
     {
+        machineMode = line[1] == '1';
+        return true;
     }
+    while (cmd)
+    {
+        next = strchr(cmd, ';');
+        if (next)
+            *next++ = '\0';
+        ok &= ProcessCommand(cmd);
+        cmd = next;
+    }
+    return ok;
 }
 
-void UART0IntHandler(void)
+// Nodding and shaking, one position every GESTURE_STEP_MS
+#define GESTURE_STEP_MS 200
+static const int NOD_STEPS[] = { 50, 80, 50, 80, 50 };
+static const int SHAKE_STEPS[] = { 60, 120, 60, 120, 120 };
+
+tTimeTimer gestureTimer;
+void (*gestureSet)(int);
+const int *gestureSteps;
+uint32_t gestureCount, gestureStep;
+
+// Continues the gesture from the SysTick interrupt instead of spinning in the button handler
+void GestureStep(void *pvData)
 {
-    uint32_t ui32Status;
+    gestureSet(gestureSteps[gestureStep++]);
 
-    ui32Status = UARTIntStatus(UART0_BASE, true); // get interrupt status
+    if (gestureStep < gestureCount)
+        TIME_TimerStart(&gestureTimer, GESTURE_STEP_MS, 0);
+    else
+        doingMove = false;
+}
 
-    UARTIntClear(UART0_BASE, ui32Status); // clear the asserted interrupts
+void StartGesture(void (*set)(int), const int *steps, uint32_t count)
+{
+    if (doingMove)
+        return;
 
-    while (UARTCharsAvail(UART0_BASE)){
-        char c = UARTCharGet(UART0_BASE);
-        // If it is an enter key, process the data entered
-        if (c == 10 || c == 13)
+    doingMove = true;
+    gestureSet = set;
+    gestureSteps = steps;
+    gestureCount = count;
+    gestureStep = 0;
+    GestureStep(0);
+}
+
+void ButtonTask(void)
+{
+    tButtonEvent event;
+
+    while (BUTTON_EventGet(&event))
+    {
+        if (event.ui8Type != BUTTON_EVENT_PRESS)
+            continue;
+
+        if (event.ui8Pin == GPIO_PIN_4)
         {
-            // Show character on terminal
-            UARTStringPut(UART0_BASE, "\n\r");
-            uartReceive[uartReceiveCount] = '\0';
-            uartReceiveCount = 0;
+            // Nodding
+            StartGesture(SetServoPitch, NOD_STEPS, sizeof(NOD_STEPS) / sizeof(NOD_STEPS[0]));
+        }
+        else
+        {
+            // Shaking
+            StartGesture(SetServoYaw, SHAKE_STEPS, sizeof(SHAKE_STEPS) / sizeof(SHAKE_STEPS[0]));
+        }
+    }
+}
 
-            // Process the received value and send it to the servo
-            if(uartReceive[0] == 'p' || uartReceive[0] == 'P')
+// Debounced button events are queued from the SysTick interrupt
+void ButtonNotify(void)
+{
+    SCHED_Post(TASK_BUTTON);
+}
+
+// Only wakes the debounce, the edge stays masked while it samples
+void ButtonIntHandler(void)
+{
+    uint32_t ui32Start = LOAD_IsrBegin();
+
+    BUTTON_IntHandler();
+    LOAD_IsrEnd(ISR_BUTTON, ui32Start);
+}
+
+void InitializeButton(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+    BUTTON_Init(GPIO_PORTF_BASE, GPIO_PIN_4 | GPIO_PIN_0, ButtonNotify);
+    GPIOIntRegister(GPIO_PORTF_BASE, ButtonIntHandler);           // dynamic isr registering
+}
+
+void ConsoleTask(void)
+{
+    const uint8_t *span;
+    uint32_t len, i;
+    bool wasMachine, ok;
+
+    while ((len = RING_ReadSpan(&consoleRx, &span)) != 0)
+    {
+        for (i = 0; i < len; i++)
+        {
+            char c = span[i];
+            // If it is an enter key, process the data entered
+            if (c == 10 || c == 13)
             {
-                ui32ServoPitchValue = atoi(uartReceive + 1);
-                // Set pitch value
-                SetServoPitch(ui32ServoPitchValue);
+                wasMachine = machineMode;
+                // Show character on terminal
+                if (!wasMachine)
+                    UARTStringPut(UART0_BASE, "\n\r");
+                else if (uartReceiveCount == 0)
+                    continue; // second half of a CR LF, nothing to answer
+                uartReceive[uartReceiveCount] = '\0';
+                uartReceiveCount = 0;
+
+                // Process the received value and send it to the servo
+                ok = ProcessConsoleLine(uartReceive);
+                if (wasMachine || machineMode)
+                    UARTStringPut(UART0_BASE, ok ? "k\n" : "e\n");
             }
-            else if(uartReceive[0] == 'y' || uartReceive[0] == 'Y')
+            else
             {
-                ui32ServoYawValue = atoi(uartReceive + 1);
-                // Set yaw value
-                SetServoYaw(ui32ServoYawValue);
+                // Store the character
+                if (uartReceiveCount < sizeof(uartReceive) - 1)
+                    uartReceive[uartReceiveCount++] = c;
+                if (!machineMode)
+                    UARTCharPut(UART0_BASE, c); // Display the character
             }
         }
-        else
-        {
-            // Store the character
-            uartReceive[uartReceiveCount++] = c;
-            UARTCharPut(UART0_BASE, c); // Display the character
-        }
+        RING_ReadCommit(&consoleRx, len);
     }
 }
 
-// check whether there are any items in the FIFO of UART5.
-// get characters from UART5 that communicates with bluetooth.
-// send received characters to UART0 that communicates with PC.
-void UART5IntHandler(void)
+// take the buffers the DMA filled from UART5, which communicates with bluetooth.
+// frames are parsed in place, text goes on to LinkTextTask, which shows it on UART0 (the PC).
+void LinkTask(void)
 {
-    if(doingMove)
-        return;
+    const uint8_t *pui8Data;
+    uint32_t ui32Len, i;
 
-    uint32_t ui32Status;
+    while (DMAUART_RxGet(UART5_BASE, &pui8Data, &ui32Len))
+    {
+        for (i = 0; i < ui32Len; i++)
+        {
+            char c = pui8Data[i];
+            uint32_t ui32Result = LINK_Parse(&linkParser, c);
 
-    ui32Status = UARTIntStatus(UART5_BASE, true); // get interrupt status
+            // The master asked for a receipt, frames for other nodes never get here
+            if (ui32Result == LINK_FRAME_READY && (linkParser.sFrame.ui8Flags & LINK_FLAG_ACK))
+                LINK_Reply(UART5_BASE, &linkParser.sFrame, LINK_TYPE_ACK, &linkParser.sFrame.ui8Seq, 1);
 
-    UARTIntClear(UART5_BASE, ui32Status); // clear the asserted interrupts
+            // Telemetry frame from the master
+            if (ui32Result == LINK_FRAME_READY && linkParser.sFrame.ui8Type == LINK_TYPE_PING)
+            {
+                SYNC_HandlePing(UART5_BASE, &linkParser.sFrame, SYNC_Cycles());
 
-    while (UARTCharsAvail(UART5_BASE)) // loop while there are chars
-    {
-        char c = UARTCharGet(UART5_BASE);
+                // project frames over the measured one way delay instead of the guess
+                if (SYNC_RttGet())
+                    predictYaw.ui32LeadMs = predictPitch.ui32LeadMs = (SYNC_RttGet() + 1000) / 2000;
+                continue;
+            }
+            // Load report from the master, answered with the own one
+            if (ui32Result == LINK_FRAME_READY && linkParser.sFrame.ui8Type == LINK_TYPE_STATUS)
+            {
+                uint8_t pui8Status[LOAD_STATUS_MAX];
 
+                LOAD_HandleStatus(&linkParser.sFrame);
+                LINK_Reply(UART5_BASE, &linkParser.sFrame, LINK_TYPE_STATUS, pui8Status,
+                           (uint8_t)LOAD_StatusEncode(pui8Status));
+                continue;
+            }
+            // Targets for several servo channels at once
+            if (ui32Result == LINK_FRAME_READY && linkParser.sFrame.ui8Type == LINK_TYPE_SERVO)
+            {
+                ProcessServoFrame(&linkParser.sFrame);
+                continue;
+            }
+            if (ui32Result == LINK_FRAME_READY)
+            {
+                uint32_t ui32Axes = TELEMETRY_Receive(&telemetry, &linkParser.sFrame);
+
+                // The servo timer moves towards the new values
+                if (ui32Axes & TELEMETRY_AXIS_YAW)
+                {
+                    ui32ServoYawValue = telemetry.i32Yaw;
+                    PredictUpdate(&predictYaw, telemetry.i32Yaw * 100, telemetry.i32YawRate);
+                }
+                if (ui32Axes & TELEMETRY_AXIS_PITCH)
+                {
+                    ui32ServoPitchValue = telemetry.i32Pitch;
+                    PredictUpdate(&predictPitch, telemetry.i32Pitch * 100, telemetry.i32PitchRate);
+                }
+                continue;
+            }
+            if (ui32Result == LINK_BYTE_USED)
+                continue;
+
+            // text is shown and handled by LinkTextTask, outside the urgent task
+            if (RING_Push(&linkText, (uint8_t)c))
+                SCHED_Post(TASK_LINK_TEXT);
+            else
+                linkTextDropped++;
+        }
+        DMAUART_RxRelease(UART5_BASE);
+    }
+}
+
+// Text lines received on UART5, in their own line buffer so they never mix with the console's
+void LinkTextTask(void)
+{
+    uint8_t c;
+
+    while (RING_Pop(&linkText, &c))
+    {
         // If it is an enter key, process the data entered
         if (c == 10 || c == 13)
         {
             // Show character on terminal
             UARTStringPut(UART0_BASE, "\n\r");
-            uartReceive[uartReceiveCount] = '\0';
-            uartReceiveCount = 0;
+            linkReceive[linkReceiveCount] = '\0';
+            linkReceiveCount = 0;
 
             // Process the received value and send it to the servo
-            if(uartReceive[0] == 'p' || uartReceive[0] == 'P')
-            {
-                ui32ServoPitchValue = atoi(uartReceive + 1);
-                // Set pitch value
-                SetServoPitch(ui32ServoPitchValue);
-            }
-            else if(uartReceive[0] == 'y' || uartReceive[0] == 'Y')
-            {
-                ui32ServoYawValue = atoi(uartReceive + 1);
-                // Set yaw value
-                SetServoYaw(ui32ServoYawValue);
-            }
+            ProcessCommand(linkReceive);
         }
         else
         {
             // Store the character
-            uartReceive[uartReceiveCount++] = c;
+            if (linkReceiveCount < sizeof(linkReceive) - 1)
+                linkReceive[linkReceiveCount++] = c;
             UARTCharPut(UART0_BASE, c); // Display the character
         }
     }
 }
+
+void Initialize(void)
+{
+    // set clock
+    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+
+    // Millisecond timebase
+    TIME_Init();
+    TIME_TimerInit(&gestureTimer, GestureStep, 0);
+
+    // Periodic activities share TIMER0
+    TWHEEL_Init();
+
+    // Everything but acknowledging interrupts runs as a task
+    SCHED_Init();
+    SCHED_TaskAdd(TASK_LINK, "link", LinkTask, true);
+    SCHED_TaskAdd(TASK_SERVO, "servo", ServoTask, false);
+    SCHED_TaskAdd(TASK_BUTTON, "button", ButtonTask, false);
+    SCHED_TaskAdd(TASK_CONSOLE, "console", ConsoleTask, false);
+    SCHED_TaskAdd(TASK_LINK_TEXT, "link text", LinkTextTask, false);
+
+    // Idle and interrupt time
+    LOAD_Init();
+    LOAD_IsrAdd(ISR_CONSOLE, "console");
+    LOAD_IsrAdd(ISR_LINK, "link");
+    LOAD_IsrAdd(ISR_BUTTON, "button");
+    LOAD_IsrAdd(ISR_SERVO, "servo");
+
+    InitializeButton();
+
+    LINK_AddressSet(LINK_NODE_ADDR);
+    LINK_ParserInit(&linkParser);
+    LINK_ParserFilterSet(&linkParser, LINK_NODE_ADDR, LINK_NODE_GROUPS);
+    TELEMETRY_ReceiverInit(&telemetry);
+    SYNC_Init();
+
+    // Initialize UART
+    InitializeUART();
+
+    InitializePWM();
+
+    // set the servo's initial position
+    SetServoPitch(SERVO_INIT_PITCH);
+    SetServoYaw(SERVO_INIT_YAW);
+
+    InitializeServoTimer();
+}
+
+int main(void)
+{
+    Initialize();
+
+    // Never returns, sleeps whenever no task is pending
+    SCHED_Run();
+}
+
+// Empties the FIFO into the console ring, a full ring drops the bytes
+void UART0IntHandler(void)
+{
+    uint32_t ui32Start = LOAD_IsrBegin();
+
+    UARTIntClear(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    while (UARTCharsAvail(UART0_BASE))
+    {
+        if (!RING_Push(&consoleRx, (uint8_t)UARTCharGetNonBlocking(UART0_BASE)))
+            consoleRxDropped++;
+    }
+    SCHED_Post(TASK_CONSOLE);
+    LOAD_IsrEnd(ISR_CONSOLE, ui32Start);
+}
+
+// DMA completions and the receive timeout of the link
+void UART5IntHandler(void)
+{
+    uint32_t ui32Start = LOAD_IsrBegin();
+
+    if (DMAUART_IntHandler(UART5_BASE) & DMAUART_EVENT_RX)
+        SCHED_Post(TASK_LINK);
+    LOAD_IsrEnd(ISR_LINK, ui32Start);
+}
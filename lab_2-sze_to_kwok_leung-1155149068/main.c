@@ -5,16 +5,24 @@
 #include "inc/hw_gpio.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "TIME/TIME.h"
+#include "BUTTON/BUTTON.h"
+
+// Color periods (ms) while SW2 or only SW1 is held
+#define FAST_MS 75
+#define SLOW_MS 150
 
 uint8_t ui8PinData=2;
-int32_t SW1 = 0;
-int32_t SW2 = 0;
+bool SW1 = false;
+bool SW2 = false;
+uint32_t period = 0;    // 0 while red
+
+tTimeTimer rgbTimer;
 
-void OnRGB(uint32_t delay){
+void OnRGB(void *pvData){
     // Write RGB color
                 GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3, ui8PinData);
-                // Delay
-                SysCtlDelay(delay);
 
                 // Change color
                 if(ui8PinData == 0x0E)
@@ -23,43 +31,68 @@ void OnRGB(uint32_t delay){
                     ui8PinData += 2;
 }
 
+// Edges only wake the debounce, the events come from the SysTick interrupt
+void ButtonIntHandler(void)
+{
+    BUTTON_IntHandler();
+}
+
+// Pick the color period from the held switches, the timer only restarts when it changes
+void UpdateRGB(void)
+{
+    uint32_t newPeriod = SW2 ? FAST_MS : SW1 ? SLOW_MS : 0;
+
+    if (newPeriod == period)
+        return;
+    period = newPeriod;
+
+    if (period == 0) {
+        // SW1 is not pressed
+        // Set data to red (010)
+        TIME_TimerStop(&rgbTimer);
+        ui8PinData = 2;
+        GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3, ui8PinData);
+    }
+    else {
+        OnRGB(0);
+        TIME_TimerStart(&rgbTimer, period, period);
+    }
+}
+
 int main(void)
 {
+    tButtonEvent event;
+
     SysCtlClockSet(SYSCTL_SYSDIV_5|SYSCTL_USE_PLL|SYSCTL_XTAL_16MHZ|SYSCTL_OSC_MAIN);
 
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
     GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3);
+    GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3, ui8PinData);
+
+    TIME_Init();
+    TIME_TimerInit(&rgbTimer, OnRGB, 0);
 
-    // Unlock PF0
-    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
-    HWREG(GPIO_PORTF_BASE + GPIO_O_CR) |= 0X01;
-    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = 0;
-    // Use PF4 and PF0 for switch state 
-    GPIOPinTypeGPIOInput(GPIO_PORTF_BASE, GPIO_PIN_4 | GPIO_PIN_0);
-    GPIOPadConfigSet(GPIO_PORTF_BASE, GPIO_PIN_4 | GPIO_PIN_0, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+    // Use PF4 (SW1) and PF0 (SW2), PF0 is unlocked by BUTTON_Init
+    BUTTON_Init(GPIO_PORTF_BASE, GPIO_PIN_4 | GPIO_PIN_0, 0);
+    GPIOIntRegister(GPIO_PORTF_BASE, ButtonIntHandler);           // dynamic isr registering
+    IntMasterEnable();
 
     while(1)
     {
-        SW1 = GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_4);
-        SW2 = GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_0);
-
-        if (SW2 == 0){
-            // Pin1 is low => SW2 is pressed
-            // Shorter Delay
-            OnRGB(1000000);
-        }else{
-            if (SW1 == GPIO_PIN_4) {
-                // Pin4 is high => SW1 is not pressed
-                // Set data to red (010)
-                ui8PinData = 2;
-                // Write to PIN
-                GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3, ui8PinData);
-                SysCtlDelay(2000000);
-            }
-            else {
-                // Pin4 is low => SW1 is pressed
-                OnRGB(2000000);
-            }
+        while (BUTTON_EventGet(&event)) {
+            if (event.ui8Type != BUTTON_EVENT_PRESS && event.ui8Type != BUTTON_EVENT_RELEASE)
+                continue;
+            if (event.ui8Pin == GPIO_PIN_4)
+                SW1 = event.ui8Type == BUTTON_EVENT_PRESS;
+            else
+                SW2 = event.ui8Type == BUTTON_EVENT_PRESS;
         }
+        UpdateRGB();
+
+        // SysTick wakes up every millisecond, the colors change in its interrupt
+        IntMasterDisable();
+        if (!BUTTON_Pending())
+            SysCtlSleep();
+        IntMasterEnable();
     }
 }
@@ -0,0 +1,225 @@
+/*
+ * FSM.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "FSM.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+static void FSM_TimeoutCallback(void *pvData)
+{
+    tFsm *psFsm = (tFsm *)pvData;
+
+    FSM_Post(psFsm, FSM_EVENT_TIMEOUT, psFsm->ui8Generation);
+}
+
+static uint32_t FSM_Depth(const tFsmState *psState)
+{
+    uint32_t ui32Depth = 0;
+
+    for (; psState; psState = psState->psParent)
+        ui32Depth++;
+    return ui32Depth;
+}
+
+/*
+ * Enter psState and its ancestors below psFrom, outermost first
+ */
+static void FSM_Enter(tFsm *psFsm, const tFsmState *psFrom, const tFsmState *psState)
+{
+    const tFsmState *ppsPath[FSM_MAX_DEPTH];
+    uint32_t ui32Count = 0;
+
+    for (; psState != psFrom && ui32Count < FSM_MAX_DEPTH; psState = psState->psParent)
+        ppsPath[ui32Count++] = psState;
+
+    while (ui32Count--)
+    {
+        psState = ppsPath[ui32Count];
+        if (psState->pfnEntry)
+            psState->pfnEntry();
+        if (psState->ui32TimeoutMs)
+            TIME_TimerStart(&psFsm->sTimeout, psState->ui32TimeoutMs, 0);
+    }
+}
+
+/*
+ * Leave the current state for psTarget
+ */
+static void FSM_Transit(tFsm *psFsm, const tFsmState *psTarget, const tFsmTransition *psTransition,
+                        const tFsmEvent *psEvent)
+{
+    const tFsmState *psSource = psFsm->psCurrent;
+    const tFsmState *psTargetUp = psTarget;
+    uint32_t ui32Source = FSM_Depth(psSource);
+    uint32_t ui32Target = FSM_Depth(psTarget);
+
+    // lowest common ancestor; a transition to the state itself leaves and re-enters it
+    while (ui32Source > ui32Target)
+    {
+        psSource = psSource->psParent;
+        ui32Source--;
+    }
+    while (ui32Target > ui32Source)
+    {
+        psTargetUp = psTargetUp->psParent;
+        ui32Target--;
+    }
+    while (psSource != psTargetUp)
+    {
+        psSource = psSource->psParent;
+        psTargetUp = psTargetUp->psParent;
+    }
+    if (psSource == psTarget)
+        psSource = psSource->psParent;
+
+    // a timeout belongs to the state it was started in
+    TIME_TimerStop(&psFsm->sTimeout);
+    psFsm->ui8Generation++;
+    for (; psFsm->psCurrent != psSource; psFsm->psCurrent = psFsm->psCurrent->psParent)
+    {
+        if (psFsm->psCurrent->pfnExit)
+            psFsm->psCurrent->pfnExit();
+    }
+
+    if (psTransition->pfnAction)
+        psTransition->pfnAction(psEvent);
+
+    FSM_Enter(psFsm, psSource, psTarget);
+    psFsm->psCurrent = psTarget;
+}
+
+/*
+ * Start a machine in its initial state, the entry actions run now
+ * @param <tFsm *> $psFsm machine
+ * @param <const tFsmState *> $psInitial first state
+ * @param <void (*)(void)> $pfnPoll moves events in from other sources before sleeping, may be 0
+ * @return void
+ */
+void FSM_Init(tFsm *psFsm, const tFsmState *psInitial, void (*pfnPoll)(void))
+{
+    psFsm->ui32Head = psFsm->ui32Tail = 0;
+    psFsm->pfnPoll = pfnPoll;
+    psFsm->ui8Generation = 0;
+    psFsm->sStats = (tFsmStats){ 0 };
+    TIME_TimerInit(&psFsm->sTimeout, FSM_TimeoutCallback, psFsm);
+
+    psFsm->psCurrent = 0;
+    FSM_Enter(psFsm, 0, psInitial);
+    psFsm->psCurrent = psInitial;
+}
+
+/*
+ * Queue an event, from the main loop or an interrupt
+ * @param <tFsm *> $psFsm machine
+ * @param <uint8_t> $ui8Type FSM_EVENT_TIMEOUT or an application event
+ * @param <uint8_t> $ui8Param passed along with the event
+ * @return void
+ */
+void FSM_Post(tFsm *psFsm, uint8_t ui8Type, uint8_t ui8Param)
+{
+    bool bMasked = IntMasterDisable();
+    uint32_t ui32Head = psFsm->ui32Head;
+
+    if (ui32Head - psFsm->ui32Tail < FSM_QUEUE)
+    {
+        psFsm->psQueue[ui32Head % FSM_QUEUE].ui8Type = ui8Type;
+        psFsm->psQueue[ui32Head % FSM_QUEUE].ui8Param = ui8Param;
+        psFsm->ui32Head = ui32Head + 1;
+    }
+    else
+        psFsm->sStats.ui32Dropped++;
+
+    if (!bMasked)
+        IntMasterEnable();
+}
+
+/*
+ * Handle the oldest queued event
+ * @param <tFsm *> $psFsm machine
+ * @return <bool> false if the queue was empty
+ */
+bool FSM_Dispatch(tFsm *psFsm)
+{
+    const tFsmState *psState;
+    const tFsmTransition *psTransition;
+    tFsmEvent sEvent;
+    uint64_t ui64Start;
+    uint32_t i;
+
+    if (psFsm->ui32Tail == psFsm->ui32Head)
+        return false;
+    sEvent = psFsm->psQueue[psFsm->ui32Tail % FSM_QUEUE];
+    psFsm->ui32Tail++;
+    if (sEvent.ui8Type == FSM_EVENT_TIMEOUT && sEvent.ui8Param != psFsm->ui8Generation)
+        return true;
+
+    ui64Start = TIME_Us();
+    psFsm->sStats.ui32Events++;
+
+    for (psState = psFsm->psCurrent; psState; psState = psState->psParent)
+    {
+        for (i = 0; i < psState->ui32TransitionCount; i++)
+        {
+            psTransition = &psState->psTransitions[i];
+            if (psTransition->ui8Event != sEvent.ui8Type)
+                continue;
+            if (psTransition->pfnGuard && !psTransition->pfnGuard(&sEvent))
+                continue;
+
+            if (psTransition->psTarget)
+                FSM_Transit(psFsm, psTransition->psTarget, psTransition, &sEvent);
+            else if (psTransition->pfnAction)
+                psTransition->pfnAction(&sEvent);
+            goto done;
+        }
+    }
+    psFsm->sStats.ui32Unhandled++;
+
+done:
+    psFsm->sStats.ui32LastUs = (uint32_t)(TIME_Us() - ui64Start);
+    if (psFsm->sStats.ui32LastUs > psFsm->sStats.ui32MaxUs)
+        psFsm->sStats.ui32MaxUs = psFsm->sStats.ui32LastUs;
+    return true;
+}
+
+/*
+ * Run the machine forever, the CPU sleeps whenever no event is queued
+ * @param <tFsm *> $psFsm machine
+ * @return void
+ */
+void FSM_Run(tFsm *psFsm)
+{
+    while (1)
+    {
+        if (psFsm->pfnPoll)
+            psFsm->pfnPoll();
+        if (FSM_Dispatch(psFsm))
+            continue;
+
+        // an interrupt between the check and WFI still ends the sleep
+        IntMasterDisable();
+        if (psFsm->ui32Tail == psFsm->ui32Head)
+            SysCtlSleep();
+        IntMasterEnable();
+    }
+}
+
+/*
+ * @param <const tFsm *> $psFsm machine
+ * @param <const tFsmState *> $psState state
+ * @return <bool> true if the machine is in psState or one of its sub states
+ */
+bool FSM_In(const tFsm *psFsm, const tFsmState *psState)
+{
+    const tFsmState *psCurrent;
+
+    for (psCurrent = psFsm->psCurrent; psCurrent; psCurrent = psCurrent->psParent)
+    {
+        if (psCurrent == psState)
+            return true;
+    }
+    return false;
+}
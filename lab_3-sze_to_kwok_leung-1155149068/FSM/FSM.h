@@ -0,0 +1,98 @@
+/*
+ * FSM.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Event driven hierarchical state machine.
+ *  States are constant table entries with an optional parent, entry and exit
+ *  actions, a timeout and a list of transitions. An event is offered to the
+ *  current state's transitions in order, then to its parent's and so on; the
+ *  first one with a matching event and a passing guard runs. A transition
+ *  without target stays in the state (no exit / entry), otherwise the exit
+ *  actions run from the current state up to the common ancestor, then the
+ *  entry actions down to the target.
+ *
+ *  A state with ui32TimeoutMs starts a TIME timer on entry that posts
+ *  FSM_EVENT_TIMEOUT, leaving the state stops it and drops a timeout that was
+ *  already queued. Nothing in the machine
+ *  waits: FSM_Run() handles the queued events and puts the CPU to sleep until
+ *  the next interrupt once there are none.
+ */
+
+#ifndef FSM_FSM_H_
+#define FSM_FSM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../TIME/TIME.h"
+
+#define FSM_QUEUE           16      // power of 2
+#define FSM_MAX_DEPTH       4       // levels of nesting
+
+/*
+ * Events, applications number their own from FSM_EVENT_USER
+ */
+#define FSM_EVENT_TIMEOUT   0
+#define FSM_EVENT_USER      1
+
+typedef struct
+{
+    uint8_t ui8Type;
+    uint8_t ui8Param;
+} tFsmEvent;
+
+struct tFsmState;
+
+typedef struct
+{
+    uint8_t ui8Event;
+    bool (*pfnGuard)(const tFsmEvent *psEvent);         // 0 for always
+    void (*pfnAction)(const tFsmEvent *psEvent);        // 0 for none, runs before entering the target
+    const struct tFsmState *psTarget;                   // 0 for an internal transition
+} tFsmTransition;
+
+typedef struct tFsmState
+{
+    const char *pcName;
+    const struct tFsmState *psParent;
+    void (*pfnEntry)(void);
+    void (*pfnExit)(void);
+    uint32_t ui32TimeoutMs;                             // 0 for none
+    const tFsmTransition *psTransitions;
+    uint32_t ui32TransitionCount;
+} tFsmState;
+
+typedef struct
+{
+    uint32_t ui32Events;
+    uint32_t ui32Unhandled;         // events no state had a transition for
+    uint32_t ui32Dropped;           // events lost because the queue was full
+    uint32_t ui32LastUs;            // time spent on the last event
+    uint32_t ui32MaxUs;             // longest time spent on one event
+} tFsmStats;
+
+typedef struct
+{
+    const tFsmState *psCurrent;
+    tTimeTimer sTimeout;
+    uint8_t ui8Generation;          // bumped on every transition, stale timeouts carry an old one
+
+    tFsmEvent psQueue[FSM_QUEUE];
+    volatile uint32_t ui32Head, ui32Tail;
+
+    // called by FSM_Run() before it sleeps, to move events in from other queues
+    void (*pfnPoll)(void);
+
+    tFsmStats sStats;
+} tFsm;
+
+/*
+ * Function declaration(s)
+ */
+extern void FSM_Init(tFsm *psFsm, const tFsmState *psInitial, void (*pfnPoll)(void));
+extern void FSM_Post(tFsm *psFsm, uint8_t ui8Type, uint8_t ui8Param);
+extern bool FSM_Dispatch(tFsm *psFsm);
+extern void FSM_Run(tFsm *psFsm);
+extern bool FSM_In(const tFsm *psFsm, const tFsmState *psState);
+
+#endif /* FSM_FSM_H_ */
@@ -0,0 +1,234 @@
+/*
+ * KEYPAD.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "KEYPAD.h"
+#include "../TIME/TIME.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_memmap.h"
+
+#define KEYPAD_ROW_PINS     (GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4)
+#define KEYPAD_COL_PINS     (GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6)
+
+/*
+ * Debounce states of a key
+ */
+#define KEYPAD_UP           0
+#define KEYPAD_GOING_DOWN   1
+#define KEYPAD_DOWN         2
+#define KEYPAD_GOING_UP     3
+
+// row patterns, one row low at a time
+static const uint8_t KEYPAD_ROW_DRIVE[KEYPAD_ROWS] = { 0x1C, 0x1A, 0x16, 0x0E };
+static const uint8_t KEYPAD_COL_PIN[KEYPAD_COLS] = { GPIO_PIN_4, GPIO_PIN_5, GPIO_PIN_6 };
+static const uint8_t KEYPAD_CODE[KEYPAD_ROWS][KEYPAD_COLS] = {
+    { KEYPAD_KEY_1, KEYPAD_KEY_2, KEYPAD_KEY_3 },
+    { KEYPAD_KEY_4, KEYPAD_KEY_5, KEYPAD_KEY_6 },
+    { KEYPAD_KEY_7, KEYPAD_KEY_8, KEYPAD_KEY_9 },
+    { KEYPAD_KEY_STAR, KEYPAD_KEY_0, KEYPAD_KEY_HASH },
+};
+
+typedef struct
+{
+    uint8_t ui8State;
+    uint8_t ui8Count;               // samples the new level has held
+    uint32_t ui32Repeat;            // TIME_Ms() of the next repeat
+} tKeypadKey;
+
+static tKeypadKey g_psKeys[KEYPAD_ROWS][KEYPAD_COLS];
+static uint32_t g_ui32Row;
+static uint32_t g_ui32KeysDown;     // keys not in KEYPAD_UP
+static uint32_t g_ui32IdleScans;
+static bool g_bWake;
+static tTimeTimer g_sScanTimer;
+
+// event queue, the head is written by the scan only, the tail by the reader only
+static tKeypadEvent g_psQueue[KEYPAD_QUEUE];
+static volatile uint32_t g_ui32Head, g_ui32Tail;
+static volatile uint32_t g_ui32Dropped;
+
+static void KEYPAD_Post(uint8_t ui8Type, uint8_t ui8Key, uint32_t ui32Now)
+{
+    uint32_t ui32Head = g_ui32Head;
+
+    if (ui32Head - g_ui32Tail >= KEYPAD_QUEUE)
+    {
+        g_ui32Dropped++;
+        return;
+    }
+    g_psQueue[ui32Head % KEYPAD_QUEUE].ui8Type = ui8Type;
+    g_psQueue[ui32Head % KEYPAD_QUEUE].ui8Key = ui8Key;
+    g_psQueue[ui32Head % KEYPAD_QUEUE].ui16Time = (uint16_t)ui32Now;
+    // publish after the entry is complete
+    g_ui32Head = ui32Head + 1;
+}
+
+/*
+ * One sample of a key through its debounce state machine
+ */
+static void KEYPAD_Sample(tKeypadKey *psKey, uint8_t ui8Code, bool bPressed, uint32_t ui32Now)
+{
+    switch (psKey->ui8State)
+    {
+    case KEYPAD_UP:
+        if (!bPressed)
+            break;
+        psKey->ui8State = KEYPAD_GOING_DOWN;
+        psKey->ui8Count = 1;
+        g_ui32KeysDown++;
+        break;
+
+    case KEYPAD_GOING_DOWN:
+        if (!bPressed)
+        {
+            psKey->ui8State = KEYPAD_UP;
+            g_ui32KeysDown--;
+        }
+        else if (++psKey->ui8Count >= KEYPAD_DEBOUNCE)
+        {
+            psKey->ui8State = KEYPAD_DOWN;
+            psKey->ui32Repeat = ui32Now + KEYPAD_REPEAT_DELAY;
+            KEYPAD_Post(KEYPAD_EVENT_PRESS, ui8Code, ui32Now);
+        }
+        break;
+
+    case KEYPAD_DOWN:
+        if (!bPressed)
+        {
+            psKey->ui8State = KEYPAD_GOING_UP;
+            psKey->ui8Count = 1;
+        }
+        else if (!TIME_After(psKey->ui32Repeat, ui32Now))
+        {
+            psKey->ui32Repeat += KEYPAD_REPEAT_MS;
+            KEYPAD_Post(KEYPAD_EVENT_REPEAT, ui8Code, ui32Now);
+        }
+        break;
+
+    case KEYPAD_GOING_UP:
+        if (bPressed)
+            psKey->ui8State = KEYPAD_DOWN;
+        else if (++psKey->ui8Count >= KEYPAD_DEBOUNCE)
+        {
+            psKey->ui8State = KEYPAD_UP;
+            g_ui32KeysDown--;
+            KEYPAD_Post(KEYPAD_EVENT_RELEASE, ui8Code, ui32Now);
+        }
+        break;
+    }
+}
+
+static void KEYPAD_EdgeIntHandler(void)
+{
+    GPIOIntDisable(GPIO_PORTC_BASE, KEYPAD_COL_PINS);
+    GPIOIntClear(GPIO_PORTC_BASE, KEYPAD_COL_PINS);
+
+    g_ui32IdleScans = 0;
+    g_ui32Row = 0;
+    GPIOPinWrite(GPIO_PORTE_BASE, KEYPAD_ROW_PINS, KEYPAD_ROW_DRIVE[0]);
+    TIME_TimerStart(&g_sScanTimer, 1, 1);
+}
+
+/*
+ * Wait for a key with all rows low, the scan resumes on a column edge
+ */
+static void KEYPAD_Sleep(void)
+{
+    TIME_TimerStop(&g_sScanTimer);
+    GPIOPinWrite(GPIO_PORTE_BASE, KEYPAD_ROW_PINS, 0);
+    GPIOIntClear(GPIO_PORTC_BASE, KEYPAD_COL_PINS);
+    GPIOIntEnable(GPIO_PORTC_BASE, KEYPAD_COL_PINS);
+
+    // pressed between the last scan and enabling the edge
+    if (GPIOPinRead(GPIO_PORTC_BASE, KEYPAD_COL_PINS) != KEYPAD_COL_PINS)
+        KEYPAD_EdgeIntHandler();
+}
+
+/*
+ * Tick: sample the row driven since the last tick, then drive the next one
+ */
+static void KEYPAD_Scan(void *pvData)
+{
+    uint32_t ui32Now = TIME_Ms();
+    uint32_t ui32Cols = GPIOPinRead(GPIO_PORTC_BASE, KEYPAD_COL_PINS);
+    uint32_t i;
+
+    for (i = 0; i < KEYPAD_COLS; i++)
+        KEYPAD_Sample(&g_psKeys[g_ui32Row][i], KEYPAD_CODE[g_ui32Row][i], !(ui32Cols & KEYPAD_COL_PIN[i]), ui32Now);
+
+    if (++g_ui32Row == KEYPAD_ROWS)
+    {
+        g_ui32Row = 0;
+        g_ui32IdleScans = g_ui32KeysDown ? 0 : g_ui32IdleScans + 1;
+        if (g_bWake && g_ui32IdleScans >= KEYPAD_IDLE_SCANS)
+        {
+            KEYPAD_Sleep();
+            return;
+        }
+    }
+    GPIOPinWrite(GPIO_PORTE_BASE, KEYPAD_ROW_PINS, KEYPAD_ROW_DRIVE[g_ui32Row]);
+}
+
+/*
+ * Set up the matrix pins and start scanning, call after TIME_Init()
+ * @param <bool> $bWake stop scanning while no key is down, a column edge restarts it
+ * @return void
+ */
+void KEYPAD_Init(bool bWake)
+{
+    uint32_t ui32Row, ui32Col;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
+    GPIOPinTypeGPIOOutput(GPIO_PORTE_BASE, KEYPAD_ROW_PINS);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOC);
+    GPIOPinTypeGPIOInput(GPIO_PORTC_BASE, KEYPAD_COL_PINS);
+    GPIOPadConfigSet(GPIO_PORTC_BASE, KEYPAD_COL_PINS, GPIO_STRENGTH_4MA, GPIO_PIN_TYPE_STD_WPU);
+
+    for (ui32Row = 0; ui32Row < KEYPAD_ROWS; ui32Row++)
+        for (ui32Col = 0; ui32Col < KEYPAD_COLS; ui32Col++)
+            g_psKeys[ui32Row][ui32Col].ui8State = KEYPAD_UP;
+    g_ui32KeysDown = 0;
+    g_ui32IdleScans = 0;
+    g_ui32Head = g_ui32Tail = 0;
+    g_ui32Dropped = 0;
+    g_bWake = bWake;
+
+    if (bWake)
+    {
+        GPIOIntTypeSet(GPIO_PORTC_BASE, KEYPAD_COL_PINS, GPIO_FALLING_EDGE);
+        GPIOIntRegister(GPIO_PORTC_BASE, KEYPAD_EdgeIntHandler);    // dynamic isr registering
+    }
+
+    g_ui32Row = 0;
+    GPIOPinWrite(GPIO_PORTE_BASE, KEYPAD_ROW_PINS, KEYPAD_ROW_DRIVE[0]);
+    TIME_TimerInit(&g_sScanTimer, KEYPAD_Scan, 0);
+    TIME_TimerStart(&g_sScanTimer, 1, 1);
+}
+
+/*
+ * Take the oldest event
+ * @param <tKeypadEvent *> $psEvent filled in
+ * @return <bool> false if the queue is empty
+ */
+bool KEYPAD_EventGet(tKeypadEvent *psEvent)
+{
+    uint32_t ui32Tail = g_ui32Tail;
+
+    if (ui32Tail == g_ui32Head)
+        return false;
+    *psEvent = g_psQueue[ui32Tail % KEYPAD_QUEUE];
+    // free the entry after it is copied
+    g_ui32Tail = ui32Tail + 1;
+    return true;
+}
+
+/*
+ * @return <uint32_t> events lost because the queue was full
+ */
+uint32_t KEYPAD_Dropped(void)
+{
+    return g_ui32Dropped;
+}
@@ -0,0 +1,76 @@
+/*
+ * KEYPAD.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  4x3 keypad matrix, rows on PE1-PE4 (outputs, active low), columns on
+ *  PC4-PC6 (inputs with pull-ups).
+ *
+ *  A TIME timer drives one row per millisecond and reads the columns of the
+ *  row driven in the tick before, so every key is sampled each KEYPAD_ROWS ms
+ *  without waiting for the lines to settle. Each key runs its own debounce:
+ *  a change of level has to hold for KEYPAD_DEBOUNCE samples before it counts.
+ *  Press, release and auto repeat events go into a single producer / single
+ *  consumer queue, the tick writes the head and KEYPAD_EventGet() the tail, so
+ *  neither side disables interrupts.
+ *
+ *  With wake enabled, scanning stops after KEYPAD_IDLE_SCANS scans with every
+ *  key up: all rows are driven low and a falling edge on a column restarts
+ *  the scan.
+ */
+
+#ifndef KEYPAD_KEYPAD_H_
+#define KEYPAD_KEYPAD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define KEYPAD_ROWS         4
+#define KEYPAD_COLS         3
+#define KEYPAD_KEYS         (KEYPAD_ROWS * KEYPAD_COLS)
+
+#define KEYPAD_DEBOUNCE     5       // samples, 20 ms
+#define KEYPAD_REPEAT_DELAY 500     // ms held before the first repeat
+#define KEYPAD_REPEAT_MS    100     // ms between repeats
+#define KEYPAD_IDLE_SCANS   50      // scans with all keys up before waiting for an edge
+#define KEYPAD_QUEUE        16      // power of 2
+
+/*
+ * Key codes
+ */
+#define KEYPAD_KEY_0        0x0
+#define KEYPAD_KEY_1        0x1
+#define KEYPAD_KEY_2        0x2
+#define KEYPAD_KEY_3        0x3
+#define KEYPAD_KEY_4        0x4
+#define KEYPAD_KEY_5        0x5
+#define KEYPAD_KEY_6        0x6
+#define KEYPAD_KEY_7        0x7
+#define KEYPAD_KEY_8        0x8
+#define KEYPAD_KEY_9        0x9
+#define KEYPAD_KEY_STAR     0xA
+#define KEYPAD_KEY_HASH     0xB
+#define KEYPAD_KEY_NONE     0xF
+
+/*
+ * Event types
+ */
+#define KEYPAD_EVENT_PRESS      1
+#define KEYPAD_EVENT_RELEASE    2
+#define KEYPAD_EVENT_REPEAT     3
+
+typedef struct
+{
+    uint8_t ui8Type;                // KEYPAD_EVENT_*
+    uint8_t ui8Key;                 // KEYPAD_KEY_*
+    uint16_t ui16Time;              // TIME_Ms() of the event, low 16 bits
+} tKeypadEvent;
+
+/*
+ * Function declaration(s)
+ */
+extern void KEYPAD_Init(bool bWake);
+extern bool KEYPAD_EventGet(tKeypadEvent *psEvent);
+extern uint32_t KEYPAD_Dropped(void);
+
+#endif /* KEYPAD_KEYPAD_H_ */
@@ -0,0 +1,315 @@
+/*
+ * LCD.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "LCD.h"
+#include "../TIME/TIME.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+
+#define LCD_DATA_PINS       0xFF
+#define LCD_RS              GPIO_PIN_5
+#define LCD_RW              GPIO_PIN_6
+#define LCD_EN              GPIO_PIN_7
+
+#define LCD_CMD_SET_DDRAM   0x80
+#define LCD_ADDR_NONE       0xFF
+
+// DDRAM address of the first cell of each row
+static const uint8_t LCD_ROW_ADDR[LCD_ROWS] = { 0x00, 0x40, 0x14, 0x54 };
+
+// what the display should show, and the cells it does not show yet (bit per column)
+static char g_ppcFrame[LCD_ROWS][LCD_COLS];
+static volatile uint32_t g_pui32Dirty[LCD_ROWS];
+
+// drawing position, where the blinking cursor ends up
+static uint32_t g_ui32Row, g_ui32Col;
+static volatile uint8_t g_ui8CursorAddr;
+
+// flush state: the display's address counter, and the cell to write after the address command
+static uint8_t g_ui8Addr;
+static uint32_t g_ui32PendingRow, g_ui32PendingCol;
+static bool g_bPending;
+static volatile bool g_bRunning;
+
+static tLcdStats g_sStats;
+
+static void LCD_Write(bool bData, uint8_t ui8Byte)
+{
+    GPIOPinWrite(GPIO_PORTA_BASE, LCD_RS | LCD_RW, bData ? LCD_RS : 0);
+    GPIOPinWrite(GPIO_PORTB_BASE, LCD_DATA_PINS, ui8Byte);
+    GPIOPinWrite(GPIO_PORTA_BASE, LCD_EN, LCD_EN);
+    TIME_DelayUs(1); /* EN pulse width >= 450 ns */
+    GPIOPinWrite(GPIO_PORTA_BASE, LCD_EN, 0);
+}
+
+static bool LCD_Busy(void)
+{
+#if LCD_BUSY_FLAG
+    bool bBusy;
+
+    GPIOPinTypeGPIOInput(GPIO_PORTB_BASE, LCD_DATA_PINS);
+    GPIOPinWrite(GPIO_PORTA_BASE, LCD_RS | LCD_RW, LCD_RW);
+    GPIOPinWrite(GPIO_PORTA_BASE, LCD_EN, LCD_EN);
+    TIME_DelayUs(1); /* data valid 360 ns after EN */
+    bBusy = GPIOPinRead(GPIO_PORTB_BASE, GPIO_PIN_7) != 0;
+    GPIOPinWrite(GPIO_PORTA_BASE, LCD_EN, 0);
+    GPIOPinWrite(GPIO_PORTA_BASE, LCD_RW, 0);
+    GPIOPinTypeGPIOOutput(GPIO_PORTB_BASE, LCD_DATA_PINS);
+
+    return bBusy;
+#else
+    return false;
+#endif
+}
+
+static uint32_t LCD_Lowest(uint32_t ui32Bits)
+{
+    uint32_t ui32Bit = 0;
+
+    while (!(ui32Bits & (1 << ui32Bit)))
+        ui32Bit++;
+    return ui32Bit;
+}
+
+/*
+ * One step of the flush: at most one byte to the display
+ */
+static void LCD_IntHandler(void)
+{
+    uint32_t ui32Row, ui32Col;
+    uint8_t ui8Addr;
+
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+
+    if (LCD_Busy())
+    {
+        g_sStats.ui32Busy++;
+        return;
+    }
+
+    // the address command went out in the last step, now the character
+    if (g_bPending)
+    {
+        g_bPending = false;
+        ui32Row = g_ui32PendingRow;
+        ui32Col = g_ui32PendingCol;
+        g_pui32Dirty[ui32Row] &= ~(1 << ui32Col);
+        LCD_Write(true, (uint8_t)g_ppcFrame[ui32Row][ui32Col]);
+        g_ui8Addr++;
+        g_sStats.ui32Data++;
+        return;
+    }
+
+    // a dirty cell on the address counter first, then in screen order
+    for (ui32Row = 0; ui32Row < LCD_ROWS; ui32Row++)
+    {
+        if (g_ui8Addr >= LCD_ROW_ADDR[ui32Row] && g_ui8Addr < LCD_ROW_ADDR[ui32Row] + LCD_COLS &&
+            (g_pui32Dirty[ui32Row] & (1 << (g_ui8Addr - LCD_ROW_ADDR[ui32Row]))))
+        {
+            ui32Col = g_ui8Addr - LCD_ROW_ADDR[ui32Row];
+            g_pui32Dirty[ui32Row] &= ~(1 << ui32Col);
+            LCD_Write(true, (uint8_t)g_ppcFrame[ui32Row][ui32Col]);
+            g_ui8Addr++;
+            g_sStats.ui32Data++;
+            return;
+        }
+    }
+    for (ui32Row = 0; ui32Row < LCD_ROWS; ui32Row++)
+    {
+        if (!g_pui32Dirty[ui32Row])
+            continue;
+        ui32Col = LCD_Lowest(g_pui32Dirty[ui32Row]);
+        ui8Addr = LCD_ROW_ADDR[ui32Row] + ui32Col;
+        LCD_Write(false, LCD_CMD_SET_DDRAM | ui8Addr);
+        g_ui8Addr = ui8Addr;
+        g_ui32PendingRow = ui32Row;
+        g_ui32PendingCol = ui32Col;
+        g_bPending = true;
+        g_sStats.ui32Commands++;
+        return;
+    }
+
+    // all cells shown, park the cursor and stop
+    if (g_ui8Addr != g_ui8CursorAddr)
+    {
+        g_ui8Addr = g_ui8CursorAddr;
+        LCD_Write(false, LCD_CMD_SET_DDRAM | g_ui8Addr);
+        g_sStats.ui32Commands++;
+        return;
+    }
+    TimerDisable(TIMER1_BASE, TIMER_A);
+    g_bRunning = false;
+}
+
+/*
+ * Start the flush if it is not running, after the framebuffer changed
+ */
+static void LCD_Kick(void)
+{
+    if (g_bRunning)
+        return;
+    g_bRunning = true;
+    TimerEnable(TIMER1_BASE, TIMER_A);
+}
+
+static void LCD_Set(uint32_t ui32Row, uint32_t ui32Col, char cChar)
+{
+    if (g_ppcFrame[ui32Row][ui32Col] == cChar)
+        return;
+
+    // character first, the flush clears the bit before reading it
+    g_ppcFrame[ui32Row][ui32Col] = cChar;
+    IntMasterDisable();
+    g_pui32Dirty[ui32Row] |= 1 << ui32Col;
+    IntMasterEnable();
+}
+
+/*
+ * Set up the pins, run the HD44780 initialization (blocking, ~30 ms) and the flush timer
+ * @param none
+ * @return void
+ */
+void LCD_Init(void)
+{
+    uint32_t ui32Row, ui32Col;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
+    GPIOPinTypeGPIOOutput(GPIO_PORTB_BASE, LCD_DATA_PINS);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    GPIOPinTypeGPIOOutput(GPIO_PORTA_BASE, LCD_RS | LCD_RW | LCD_EN);
+
+    // the busy flag is not valid before the function set
+    TIME_DelayUs(20000);
+    LCD_Write(false, 0x30);
+    TIME_DelayUs(5000);
+    LCD_Write(false, 0x30);
+    TIME_DelayUs(200);
+    LCD_Write(false, 0x30);
+    TIME_DelayUs(50);
+
+    LCD_Write(false, 0x38); // set 8-bit data, 2-line, 5x7 font
+    TIME_DelayUs(50);
+    LCD_Write(false, 0x06); // cursor move direction: increase
+    TIME_DelayUs(50);
+    LCD_Write(false, 0x01); // display clear
+    TIME_DelayUs(2000);
+    LCD_Write(false, 0x0F); // turn on display, cursor blinking
+    TIME_DelayUs(50);
+
+    for (ui32Row = 0; ui32Row < LCD_ROWS; ui32Row++)
+    {
+        for (ui32Col = 0; ui32Col < LCD_COLS; ui32Col++)
+            g_ppcFrame[ui32Row][ui32Col] = ' ';
+        g_pui32Dirty[ui32Row] = 0;
+    }
+    g_ui32Row = g_ui32Col = 0;
+    g_ui8Addr = g_ui8CursorAddr = 0;
+    g_bPending = false;
+    g_bRunning = false;
+    g_sStats = (tLcdStats){ 0 };
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(TIMER1_BASE, TIMER_A, SysCtlClockGet() / 1000000 * LCD_STEP_US - 1);
+    TimerIntRegister(TIMER1_BASE, TIMER_A, LCD_IntHandler);     // dynamic isr registering
+    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+    IntEnable(INT_TIMER1A);
+}
+
+/*
+ * Blank the whole screen and move to the first cell
+ * @param none
+ * @return void
+ */
+void LCD_Clear(void)
+{
+    uint32_t ui32Row;
+
+    for (ui32Row = 0; ui32Row < LCD_ROWS; ui32Row++)
+        LCD_ClearRow(ui32Row);
+    LCD_SetCursor(0, 0);
+}
+
+/*
+ * Blank one row, only the cells that are not blank yet are sent
+ * @param <uint32_t> $ui32Row 0 - LCD_ROWS-1
+ * @return void
+ */
+void LCD_ClearRow(uint32_t ui32Row)
+{
+    uint32_t ui32Col;
+
+    if (ui32Row >= LCD_ROWS)
+        return;
+    for (ui32Col = 0; ui32Col < LCD_COLS; ui32Col++)
+        LCD_Set(ui32Row, ui32Col, ' ');
+    LCD_Kick();
+}
+
+/*
+ * Move the drawing position, the blinking cursor follows it
+ * @param <uint32_t> $ui32Col 0 - LCD_COLS-1
+ * @param <uint32_t> $ui32Row 0 - LCD_ROWS-1
+ * @return void
+ */
+void LCD_SetCursor(uint32_t ui32Col, uint32_t ui32Row)
+{
+    if (ui32Col >= LCD_COLS || ui32Row >= LCD_ROWS)
+        return;
+    g_ui32Col = ui32Col;
+    g_ui32Row = ui32Row;
+    g_ui8CursorAddr = LCD_ROW_ADDR[ui32Row] + ui32Col;
+    LCD_Kick();
+}
+
+/*
+ * Draw a character at the drawing position and move right, wrapping to the next row
+ * @param <char> $cChar character
+ * @return void
+ */
+void LCD_PutChar(char cChar)
+{
+    LCD_Set(g_ui32Row, g_ui32Col, cChar);
+    if (++g_ui32Col == LCD_COLS)
+    {
+        g_ui32Col = 0;
+        g_ui32Row = (g_ui32Row + 1) % LCD_ROWS;
+    }
+    g_ui8CursorAddr = LCD_ROW_ADDR[g_ui32Row] + g_ui32Col;
+    LCD_Kick();
+}
+
+/*
+ * Draw a string from the drawing position
+ * @param <const char *> $pcString zero terminated
+ * @return void
+ */
+void LCD_PutString(const char *pcString)
+{
+    while (*pcString)
+        LCD_PutChar(*pcString++);
+}
+
+/*
+ * @return <bool> true if the display shows the framebuffer
+ */
+bool LCD_Idle(void)
+{
+    return !g_bRunning;
+}
+
+/*
+ * @param <tLcdStats *> $psStats filled in
+ * @return void
+ */
+void LCD_StatsGet(tLcdStats *psStats)
+{
+    *psStats = g_sStats;
+}
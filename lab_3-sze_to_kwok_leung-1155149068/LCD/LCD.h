@@ -0,0 +1,53 @@
+/*
+ * LCD.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  HD44780 4x20 character LCD behind a RAM framebuffer.
+ *  Data D0-D7 on PB0-PB7, RS on PA5, RW on PA6, EN on PA7.
+ *
+ *  Drawing only changes the framebuffer and marks the cells that changed, it
+ *  never waits on the display. A state machine on Timer1A then sends one byte
+ *  per step: the next dirty cell, preceded by a set DDRAM address command
+ *  only where the display's address counter is not already on that cell, so
+ *  a run of changed cells costs one command. When nothing is dirty the
+ *  blinking cursor is moved to the LCD_SetCursor() position and the timer stops.
+ *
+ *  A step first reads the busy flag (RW high, DB7) and tries again on the next
+ *  step while the controller is busy. Reading drives 5 V onto PB0-PB7 if the
+ *  module runs on 5 V, and PB0/PB1 are not 5 V tolerant: set LCD_BUSY_FLAG to
+ *  0 for such a module, every step then just waits LCD_STEP_US.
+ */
+
+#ifndef LCD_LCD_H_
+#define LCD_LCD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LCD_ROWS            4
+#define LCD_COLS            20
+
+#define LCD_BUSY_FLAG       1       // poll the busy flag, 0 for timed steps only
+#define LCD_STEP_US         50      // > 37 us per command or data byte
+
+typedef struct
+{
+    uint32_t ui32Data;              // characters written to the display
+    uint32_t ui32Commands;          // address commands
+    uint32_t ui32Busy;              // steps that found the controller busy
+} tLcdStats;
+
+/*
+ * Function declaration(s)
+ */
+extern void LCD_Init(void);
+extern void LCD_Clear(void);
+extern void LCD_ClearRow(uint32_t ui32Row);
+extern void LCD_SetCursor(uint32_t ui32Col, uint32_t ui32Row);
+extern void LCD_PutChar(char cChar);
+extern void LCD_PutString(const char *pcString);
+extern bool LCD_Idle(void);
+extern void LCD_StatsGet(tLcdStats *psStats);
+
+#endif /* LCD_LCD_H_ */
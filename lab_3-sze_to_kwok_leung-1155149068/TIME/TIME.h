@@ -0,0 +1,54 @@
+/*
+ * TIME.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Monotonic timebase on SysTick.
+ *  SysTick interrupts once per millisecond and extends the count to 64 bits;
+ *  TIME_Us() adds the sub-millisecond part from the SysTick counter, so the
+ *  clock never wraps and costs no SysCtlClockGet() per call.
+ *
+ *  Instead of spinning, code that has to wait starts a tTimeTimer and
+ *  continues in its callback. Callbacks run in the SysTick interrupt and must
+ *  be short. TIME_DelayUs() is kept for start-up sequences only.
+ */
+
+#ifndef TIME_TIME_H_
+#define TIME_TIME_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TIME_TICK_HZ        1000
+
+typedef void (*tTimeCallback)(void *pvData);
+
+typedef struct tTimeTimer
+{
+    tTimeCallback pfnCallback;
+    void *pvData;
+    uint32_t ui32Period;            // ms, 0 for a one shot
+    uint32_t ui32Due;               // TIME_Ms() of the next call
+    volatile bool bActive;
+    bool bLinked;
+    struct tTimeTimer *psNext;
+} tTimeTimer;
+
+/*
+ * true if time a is later than time b, valid across a wrap of 32 bit values
+ */
+#define TIME_After(a, b)    ((int32_t)((uint32_t)(b) - (uint32_t)(a)) < 0)
+
+/*
+ * Function declaration(s)
+ */
+extern void TIME_Init(void);
+extern uint64_t TIME_Us(void);
+extern uint32_t TIME_Ms(void);
+extern bool TIME_Expired(uint64_t ui64Deadline);
+extern void TIME_DelayUs(uint32_t ui32Us);
+extern void TIME_TimerInit(tTimeTimer *psTimer, tTimeCallback pfnCallback, void *pvData);
+extern void TIME_TimerStart(tTimeTimer *psTimer, uint32_t ui32DelayMs, uint32_t ui32PeriodMs);
+extern void TIME_TimerStop(tTimeTimer *psTimer);
+
+#endif /* TIME_TIME_H_ */
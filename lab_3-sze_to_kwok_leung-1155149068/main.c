@@ -16,351 +16,208 @@
 #include "driverlib/interrupt.h"
 #include "driverlib/gpio.h"
 #include "driverlib/timer.h"
+#include "TIME/TIME.h"
+#include "LCD/LCD.h"
+#include "KEYPAD/KEYPAD.h"
 
-#define datapins GPIO_PIN_0|GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3|GPIO_PIN_4|GPIO_PIN_5|GPIO_PIN_6|GPIO_PIN_7
-#define RS GPIO_PIN_5
-#define RW GPIO_PIN_6
-#define EN GPIO_PIN_7
-#define ROW GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3|GPIO_PIN_4
-#define COL GPIO_PIN_4|GPIO_PIN_5|GPIO_PIN_6
+#include "FSM/FSM.h"
 
-#define NUMPAD_KEY_NONE 0xF
-#define NUMPAD_KEY_0 0x0
-#define NUMPAD_KEY_1 0x1
-#define NUMPAD_KEY_2 0x2
-#define NUMPAD_KEY_3 0X3
-#define NUMPAD_KEY_4 0x4
-#define NUMPAD_KEY_5 0x5
-#define NUMPAD_KEY_6 0x6
-#define NUMPAD_KEY_7 0x7
-#define NUMPAD_KEY_8 0x8
-#define NUMPAD_KEY_9 0x9
-#define NUMPAD_KEY_STAR 0xA
-#define NUMPAD_KEY_HASHTAG 0xB
 #define MAX_PWD_LENGTH 16
+#define MESSAGE_MS 1500
 
-enum State { set_pwd, read_pwd, verify_pwd, correct_pwd, incorrect_pwd, };
+// a key press, the key code is the event parameter
+#define EVENT_KEY FSM_EVENT_USER
 
-int numpad_read();
+void poll_keypad(void);
 void display_input(int input);
-void clear_row(int row);
-void flushInput(uint32_t ui32Port, uint8_t ui8Pins);
-void delayMs(int n);
-void delayUs(int n);
-void LCD_command(unsigned char command);
-void LCD_data(unsigned char data);
-void LCD_init(void);
-void LCD_position(int hor_x, int ver_y);
-void LCD_display_message(char *message_str);
+
+bool is_digit(const tFsmEvent *event);
+bool is_enter(const tFsmEvent *event);
+bool is_set(const tFsmEvent *event);
+bool is_correct(const tFsmEvent *event);
+bool is_wrong(const tFsmEvent *event);
+void append_input(const tFsmEvent *event);
+void save_pwd(const tFsmEvent *event);
+
+void reset_input(void);
+void enter_set_pwd(void);
+void enter_read_pwd(void);
+void enter_message(void);
+void enter_correct(void);
+void enter_incorrect(void);
+
+extern const tFsmState input_state, set_pwd_state, read_pwd_state;
+extern const tFsmState message_state, correct_state, incorrect_state;
+
+// Taking digits: both password states share the typing, enter decides where to go
+const tFsmTransition input_transitions[] = {
+    { EVENT_KEY, is_digit, append_input, 0 },
+};
+const tFsmTransition set_pwd_transitions[] = {
+    { EVENT_KEY, is_set, save_pwd, &read_pwd_state },
+};
+const tFsmTransition read_pwd_transitions[] = {
+    { EVENT_KEY, is_correct, 0, &correct_state },
+    { EVENT_KEY, is_wrong, 0, &incorrect_state },
+};
+// Showing a result: keys are ignored until the timeout
+const tFsmTransition message_transitions[] = {
+    { FSM_EVENT_TIMEOUT, 0, 0, &read_pwd_state },
+};
+
+const tFsmState input_state = { "input", 0, 0, 0, 0,
+    input_transitions, sizeof(input_transitions) / sizeof(input_transitions[0]) };
+const tFsmState set_pwd_state = { "set_pwd", &input_state, enter_set_pwd, 0, 0,
+    set_pwd_transitions, sizeof(set_pwd_transitions) / sizeof(set_pwd_transitions[0]) };
+const tFsmState read_pwd_state = { "read_pwd", &input_state, enter_read_pwd, 0, 0,
+    read_pwd_transitions, sizeof(read_pwd_transitions) / sizeof(read_pwd_transitions[0]) };
+const tFsmState message_state = { "message", 0, enter_message, 0, MESSAGE_MS,
+    message_transitions, sizeof(message_transitions) / sizeof(message_transitions[0]) };
+const tFsmState correct_state = { "correct", &message_state, enter_correct, 0, 0, 0, 0 };
+const tFsmState incorrect_state = { "incorrect", &message_state, enter_incorrect, 0, 0, 0, 0 };
+
+tFsm terminal;
+int input_length = 0;
+uint64_t input_pwd = 0;
+int pwd_length = 0;
+uint64_t pwd = 0;
 
 int main(void)
 {
     SysCtlClockSet(SYSCTL_SYSDIV_5|SYSCTL_USE_PLL|SYSCTL_XTAL_16MHZ|SYSCTL_OSC_MAIN);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
-    GPIOPinTypeGPIOOutput(GPIO_PORTB_BASE, datapins);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
-    GPIOPinTypeGPIOOutput(GPIO_PORTA_BASE, RS|RW|EN);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-    GPIOPinTypeGPIOOutput(GPIO_PORTE_BASE, ROW);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOC);
-    GPIOPinTypeGPIOInput(GPIO_PORTC_BASE, COL);
-    GPIOPadConfigSet(GPIO_PORTC_BASE, COL,GPIO_STRENGTH_4MA, GPIO_PIN_TYPE_STD_WPU);
+    TIME_Init();
+    // the LCD is drawn from a framebuffer in the background
+    LCD_Init();
+    // the keypad is scanned in the background, keys arrive as events
+    KEYPAD_Init(true);
+
+    // keys and timeouts drive the terminal, the CPU sleeps in between
+    FSM_Init(&terminal, &set_pwd_state, poll_keypad);
+    FSM_Run(&terminal);
+}
 
-    enum State next_state = set_pwd;
-    int input_length = 0;
-    uint64_t pwd = 0;
-    int pwd_length = 0;
-    uint64_t input_pwd = 0;
-    short pwd_entered = 0;
+// Turns key presses into events for the terminal
+void poll_keypad(void)
+{
+    tKeypadEvent event;
 
-    while(1)
+    while (KEYPAD_EventGet(&event))
     {
-        switch(next_state)
-        {
-        case set_pwd:
-            // Display the message
-            LCD_init();
-            LCD_position(0,1);
-            LCD_display_message("Please set PWD:");
-            LCD_position(0,2);
-
-            // Read numpad input
-            while(!pwd_entered)
-            {
-                int ipt = numpad_read();
-                if(ipt != NUMPAD_KEY_NONE)
-                {
-                    if(ipt == NUMPAD_KEY_HASHTAG)
-                    {
-                        // Enter is pressed
-                        if(input_length)
-                        {
-                            // Move to next state if the pwd is set
-                            pwd_entered = 1;
-                            pwd_length = input_length;
-                            next_state = read_pwd;
-                        }
-                    }
-                    else if(input_length < MAX_PWD_LENGTH)
-                    {
-                        // Keep reading and displaying the pwd if it have not reach the maximum length
-                        display_input(ipt);
-                        input_length++;
-                        pwd = pwd << 4;
-                        pwd += ipt;
-                    }
-                }
-            }
-            break;
-
-        case read_pwd:
-                clear_row(1);
-                clear_row(2);
-               LCD_position(0,1);
-               LCD_display_message("Plz enter PWD:");
-               LCD_position(0,2);
-
-               pwd_entered = 0;
-               input_pwd = 0;
-               input_length = 0;
-
-               // Read numpad input
-               while(!pwd_entered)
-               {
-                   int ipt = numpad_read();
-                   if(ipt != NUMPAD_KEY_NONE)
-                   {
-                       if(ipt == NUMPAD_KEY_HASHTAG)
-                       {
-                           // Move to next state if the pwd is entered
-                           pwd_entered = 1;
-                           next_state = verify_pwd;
-                       }
-                       else if(input_length < MAX_PWD_LENGTH)
-                       {
-                           // Keep reading and displaying the pwd if it have not reach the maximum length
-                           display_input(ipt);
-                           input_length++;
-                           input_pwd = input_pwd << 4;
-                           input_pwd += ipt;
-                       }
-                   }
-               }
-            break;
-
-        case verify_pwd:
-            if(input_pwd == pwd)
-                next_state = correct_pwd;
-            else
-                next_state = incorrect_pwd;
-            break;
-
-        case correct_pwd:
-            clear_row(1);
-            clear_row(2);
-            LCD_position(0, 1);
-            LCD_display_message("Correct!");
-
-            delayMs(1500);
-            next_state = read_pwd;
-            break;
-
-        case incorrect_pwd:
-            clear_row(1);
-            clear_row(2);
-            LCD_position(0, 1);
-
-            // Check password length
-            if(input_length < pwd_length)
-            {
-                LCD_display_message("Wrong[too short]");
-            }else if(input_length > pwd_length)
-            {
-                LCD_display_message("Wrong[too long]");
-            }
-            else
-            {
-                LCD_display_message("Wrong! try again");
-            }
-
-            // Back to read password state
-            delayMs(1500);
-            next_state = read_pwd;
-            break;
-        }
-
+        if (event.ui8Type == KEYPAD_EVENT_PRESS)
+            FSM_Post(&terminal, EVENT_KEY, event.ui8Key);
     }
 }
 
-int numpad_read(){
-    int val = NUMPAD_KEY_NONE;
-    GPIOPinWrite(GPIO_PORTE_BASE,ROW,0x1C); // first row
-    if (!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_4)) {
-        val = NUMPAD_KEY_1;
-         flushInput(GPIO_PORTC_BASE,GPIO_PIN_4);
-    }
-    else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_5)) {
-        val = NUMPAD_KEY_2;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_5);
-    }
-    else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_6)) {
-        val = NUMPAD_KEY_3;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_6);
-    }
-
-    GPIOPinWrite(GPIO_PORTE_BASE,ROW,0x1A); // second row
-    if (!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_4)) {
-        val = NUMPAD_KEY_4;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_4);
-     }
-     else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_5)) {
-         val = NUMPAD_KEY_5;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_5);
-     }
-     else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_6)) {
-         val = NUMPAD_KEY_6;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_6);
-     }
-
-    GPIOPinWrite(GPIO_PORTE_BASE,ROW,0x16); // third row
-    if (!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_4)) {
-        val = NUMPAD_KEY_7;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_4);
-    }
-    else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_5)) {
-        val = NUMPAD_KEY_8;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_5);
-    }
-    else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_6)) {
-        val = NUMPAD_KEY_9;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_6);
-
-    }
-
-    GPIOPinWrite(GPIO_PORTE_BASE,ROW,0x0E); // forth row
-    if (!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_4)) {
-        val = NUMPAD_KEY_STAR;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_4);
-    }
-    else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_5)) {
-        val = NUMPAD_KEY_0;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_5);
-    }
-    else if(!GPIOPinRead(GPIO_PORTC_BASE,GPIO_PIN_6)) {
-        val = NUMPAD_KEY_HASHTAG;
-        flushInput(GPIO_PORTC_BASE,GPIO_PIN_6);
-    }
+void display_input(int input)
+{
+    if(input == KEYPAD_KEY_HASH)
+        return;
 
-    return val;
+    if(input == KEYPAD_KEY_STAR)
+        LCD_PutChar('*');
+    else
+        LCD_PutChar(input + 48);
 }
 
-void clear_row(int row)
+/*
+ * Guards
+ */
+bool is_digit(const tFsmEvent *event)
 {
-    LCD_position(0,row);
-    LCD_display_message("                    ");
+    // keep reading the pwd if it have not reach the maximum length
+    return event->ui8Param != KEYPAD_KEY_HASH && input_length < MAX_PWD_LENGTH;
 }
 
-void flushInput(uint32_t ui32Port, uint8_t ui8Pins){
-    /* wait until the key is release to avoid redundant inputs. */
-    while(!GPIOPinRead(ui32Port, ui8Pins)) {
-        delayMs(100);
-    }
+bool is_enter(const tFsmEvent *event)
+{
+    return event->ui8Param == KEYPAD_KEY_HASH;
 }
 
-void display_input(int input)
+bool is_set(const tFsmEvent *event)
 {
-    if(input == NUMPAD_KEY_HASHTAG)
-        return;
+    // the pwd cannot be empty
+    return is_enter(event) && input_length;
+}
 
-    if(input == NUMPAD_KEY_STAR)
-        LCD_data('*');
-    else
-        LCD_data(input + 48);
+bool is_correct(const tFsmEvent *event)
+{
+    return is_enter(event) && input_length == pwd_length && input_pwd == pwd;
 }
 
-void delayMs(int n)
+bool is_wrong(const tFsmEvent *event)
 {
-    int i,j;
-    for(i = 0;i < n;i++)
-        for(j = 0;j < 3180; j++)
-            {}
+    return is_enter(event) && !is_correct(event);
 }
 
-void delayUs( int n)
+/*
+ * Actions
+ */
+void append_input(const tFsmEvent *event)
 {
-    int i,j;
-    for(i = 0;i < n;i++)
-        for(j = 0;j < 3; j++)
-            {}
+    display_input(event->ui8Param);
+    input_length++;
+    input_pwd = input_pwd << 4;
+    input_pwd += event->ui8Param;
 }
 
-void LCD_init(void)
+void save_pwd(const tFsmEvent *event)
 {
-    delayMs(20); /* initialization sequence */
-    LCD_command(0x30);
-    delayMs(50);
-    LCD_command(0x30);
-    delayUs(500);
-    LCD_command(0x30);
+    pwd = input_pwd;
+    pwd_length = input_length;
+}
 
-    LCD_command(0x38); // set 8-bit data, 2-line, 5x7 font
-    LCD_command(0x06); // cursor move direction: increase
-    LCD_command(0x01); // display clear
-    LCD_command(0x02); // cursor move to first digit
-    LCD_command(0x0F); //turn on display, cursor blinking
+void reset_input(void)
+{
+    input_pwd = 0;
+    input_length = 0;
 }
 
-void LCD_command(unsigned char command)
+/*
+ * Entry actions
+ */
+void enter_set_pwd(void)
 {
-    GPIOPinWrite(GPIO_PORTA_BASE, RS, 0x00); //RS = 0->command mode
-    GPIOPinWrite(GPIO_PORTA_BASE, RW, 0x00); //RW = 0->writing mode
-    GPIOPinWrite(GPIO_PORTB_BASE, datapins, command); // Write the command to data pins
-    GPIOPinWrite(GPIO_PORTA_BASE, EN, 0x80); // Set EN to high
-    delayUs(500);
-    GPIOPinWrite(GPIO_PORTA_BASE, EN, 0x00); // Set EN to low, a high-to-low pulse
-    if (command < 4)
-        delayMs(20); /* command 1 and 2 needs up to 1.64ms */
-    else
-        delayUs(400); /* all others 40 us */
+    reset_input();
+    LCD_Clear();
+    LCD_SetCursor(0,0);
+    LCD_PutString("Please set PWD:");
+    LCD_SetCursor(0,1);
 }
 
-void LCD_data(unsigned char data)
+void enter_read_pwd(void)
 {
-    GPIOPinWrite(GPIO_PORTA_BASE, RS, 0x20); //RS = 0->command mode
-    GPIOPinWrite(GPIO_PORTA_BASE, RW, 0x00); //RW = 0->writing mode
-    GPIOPinWrite(GPIO_PORTB_BASE, datapins, data); // Write the command to data pins
-    GPIOPinWrite(GPIO_PORTA_BASE, EN, 0x80); // Set EN to high
-    delayUs(500);
-    GPIOPinWrite(GPIO_PORTA_BASE, EN, 0x00); // Set EN to low, a high-to-low pulse
+    reset_input();
+    LCD_ClearRow(0);
+    LCD_ClearRow(1);
+    LCD_SetCursor(0,0);
+    LCD_PutString("Plz enter PWD:");
+    LCD_SetCursor(0,1);
 }
 
-void LCD_position(int hor_x, int ver_y) {
-        switch(ver_y) {
-    case 1:
-                LCD_command(0x80+hor_x);
-                delayMs(50);
-        break;
-    case 2:
-                LCD_command(0xc0+hor_x);
-                delayMs(50);
-        break;
-    case 3:
-                LCD_command(0x94+hor_x);
-                delayMs(50);
-        break;
-    case 4:
-                LCD_command(0xd4+hor_x);
-                delayMs(50);
-        break;
-        }
+void enter_message(void)
+{
+    LCD_ClearRow(0);
+    LCD_ClearRow(1);
+    LCD_SetCursor(0,0);
 }
 
-void LCD_display_message(char *message_str) {
-    int n;
+void enter_correct(void)
+{
+    LCD_PutString("Correct!");
+}
 
-    n=0;
-    while (message_str[n]!='\0') {
-        LCD_data(message_str[n]);
-        n++;
+void enter_incorrect(void)
+{
+    // Check password length
+    if(input_length < pwd_length)
+    {
+        LCD_PutString("Wrong[too short]");
+    }else if(input_length > pwd_length)
+    {
+        LCD_PutString("Wrong[too long]");
+    }
+    else
+    {
+        LCD_PutString("Wrong! try again");
     }
 }
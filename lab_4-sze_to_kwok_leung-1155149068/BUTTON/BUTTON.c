@@ -0,0 +1,255 @@
+/*
+ * BUTTON.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "BUTTON.h"
+#include "../RING/RING.h"
+#include "../TWHEEL/TWHEEL.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_gpio.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+
+#define BUTTON_MAX          8
+
+/*
+ * Debounce states of a button
+ */
+#define BUTTON_UP           0
+#define BUTTON_GOING_DOWN   1
+#define BUTTON_DOWN         2
+#define BUTTON_GOING_UP     3
+
+typedef struct
+{
+    uint8_t ui8Pin;
+    uint8_t ui8State;
+    uint8_t ui8Count;               // samples the new level has held
+    bool bLongSent;
+    bool bClicked;                  // released recently, the next press may be a double
+    uint32_t ui32Long;              // TWHEEL_Now() of the long press
+    uint32_t ui32Released;          // TWHEEL_Now() of the last release
+} tButton;
+
+static tButton g_psButtons[BUTTON_MAX];
+static uint32_t g_ui32Count;
+static uint32_t g_ui32Port;
+static uint8_t g_ui8Pins;
+static uint32_t g_ui32ButtonsDown; // buttons not in BUTTON_UP
+static uint32_t g_ui32IdleSamples;
+static bool g_bPosted;              // events queued in this sample
+static tButtonNotify g_pfnNotify;
+static tTWheelTimer g_sSampleTimer;
+
+// event queue, written by the sample tick only, read by BUTTON_EventGet() only
+static uint8_t g_pui8Queue[BUTTON_QUEUE * sizeof(tButtonEvent)];
+static tRing g_sQueue;
+static volatile uint32_t g_ui32Dropped;
+
+static void BUTTON_Post(uint8_t ui8Type, uint8_t ui8Pin, uint32_t ui32Now)
+{
+    tButtonEvent sEvent;
+
+    if (RING_Free(&g_sQueue) < sizeof(sEvent))
+    {
+        g_ui32Dropped++;
+        return;
+    }
+    sEvent.ui8Type = ui8Type;
+    sEvent.ui8Pin = ui8Pin;
+    sEvent.ui16Time = (uint16_t)(ui32Now / 1000);
+    RING_PushN(&g_sQueue, (const uint8_t *)&sEvent, sizeof(sEvent));
+    g_bPosted = true;
+}
+
+/*
+ * One sample of a button through its debounce state machine
+ */
+static void BUTTON_Sample(tButton *psButton, bool bPressed, uint32_t ui32Now)
+{
+    switch (psButton->ui8State)
+    {
+    case BUTTON_UP:
+        if (!bPressed)
+            break;
+        psButton->ui8State = BUTTON_GOING_DOWN;
+        psButton->ui8Count = 1;
+        g_ui32ButtonsDown++;
+        break;
+
+    case BUTTON_GOING_DOWN:
+        if (!bPressed)
+        {
+            psButton->ui8State = BUTTON_UP;
+            g_ui32ButtonsDown--;
+        }
+        else if (++psButton->ui8Count >= BUTTON_DEBOUNCE)
+        {
+            psButton->ui8State = BUTTON_DOWN;
+            psButton->bLongSent = false;
+            psButton->ui32Long = ui32Now + BUTTON_LONG_MS * 1000;
+            BUTTON_Post(BUTTON_EVENT_PRESS, psButton->ui8Pin, ui32Now);
+
+            // a third click starts a new pair
+            if (psButton->bClicked && ui32Now - psButton->ui32Released < BUTTON_DOUBLE_MS * 1000)
+            {
+                BUTTON_Post(BUTTON_EVENT_DOUBLE, psButton->ui8Pin, ui32Now);
+                psButton->bClicked = false;
+            }
+            else
+                psButton->bClicked = true;
+        }
+        break;
+
+    case BUTTON_DOWN:
+        if (!bPressed)
+        {
+            psButton->ui8State = BUTTON_GOING_UP;
+            psButton->ui8Count = 1;
+        }
+        else if (!psButton->bLongSent && (int32_t)(ui32Now - psButton->ui32Long) >= 0)
+        {
+            psButton->bLongSent = true;
+            psButton->bClicked = false;     // a long press is no click
+            BUTTON_Post(BUTTON_EVENT_LONG, psButton->ui8Pin, ui32Now);
+        }
+        break;
+
+    case BUTTON_GOING_UP:
+        if (bPressed)
+            psButton->ui8State = BUTTON_DOWN;
+        else if (++psButton->ui8Count >= BUTTON_DEBOUNCE)
+        {
+            psButton->ui8State = BUTTON_UP;
+            psButton->ui32Released = ui32Now;
+            g_ui32ButtonsDown--;
+            BUTTON_Post(BUTTON_EVENT_RELEASE, psButton->ui8Pin, ui32Now);
+        }
+        break;
+    }
+}
+
+/*
+ * Wait for a falling edge with the timer stopped
+ */
+static void BUTTON_Sleep(void)
+{
+    TWHEEL_TimerStop(&g_sSampleTimer);
+    GPIOIntClear(g_ui32Port, g_ui8Pins);
+    GPIOIntEnable(g_ui32Port, g_ui8Pins);
+
+    // pressed between the last sample and enabling the edge
+    if (GPIOPinRead(g_ui32Port, g_ui8Pins) != g_ui8Pins)
+        BUTTON_IntHandler();
+}
+
+/*
+ * Tick: sample every button, the pins are read once, times are in us
+ */
+static void BUTTON_Tick(void *pvData)
+{
+    uint32_t ui32Now = TWHEEL_Now();
+    uint32_t ui32Pins = GPIOPinRead(g_ui32Port, g_ui8Pins);
+    uint32_t i;
+
+    g_bPosted = false;
+    for (i = 0; i < g_ui32Count; i++)
+        BUTTON_Sample(&g_psButtons[i], !(ui32Pins & g_psButtons[i].ui8Pin), ui32Now);
+
+    if (g_bPosted && g_pfnNotify)
+        g_pfnNotify();
+
+    g_ui32IdleSamples = g_ui32ButtonsDown ? 0 : g_ui32IdleSamples + 1;
+    if (g_ui32IdleSamples >= BUTTON_IDLE_SAMPLES)
+        BUTTON_Sleep();
+}
+
+/*
+ * Set up the pins as inputs with pull-ups and start sampling, call after TWHEEL_Init().
+ * The port's GPIO interrupt must be registered to a handler that calls BUTTON_IntHandler().
+ * @param <uint32_t> $ui32Port GPIO port base, e.g. GPIO_PORTF_BASE
+ * @param <uint8_t> $ui8Pins GPIO_PIN_* of the buttons, locked pins (PF0, PD7) are unlocked
+ * @param <tButtonNotify> $pfnNotify called in the TIMER0 interrupt when events were queued, may be 0
+ * @return void
+ */
+void BUTTON_Init(uint32_t ui32Port, uint8_t ui8Pins, tButtonNotify pfnNotify)
+{
+    uint32_t i;
+
+    g_ui32Port = ui32Port;
+    g_ui8Pins = ui8Pins;
+    g_pfnNotify = pfnNotify;
+    g_ui32Count = 0;
+    for (i = 0; i < BUTTON_MAX; i++)
+    {
+        if (!(ui8Pins & (1 << i)))
+            continue;
+        g_psButtons[g_ui32Count] = (tButton){ 0 };
+        g_psButtons[g_ui32Count].ui8Pin = 1 << i;
+        g_psButtons[g_ui32Count].ui8State = BUTTON_UP;
+        g_ui32Count++;
+    }
+    g_ui32ButtonsDown = 0;
+    g_ui32IdleSamples = 0;
+    RING_Init(&g_sQueue, g_pui8Queue, sizeof(g_pui8Queue));
+    g_ui32Dropped = 0;
+
+    // the commit register only matters for the locked NMI / JTAG pins
+    HWREG(ui32Port + GPIO_O_LOCK) = GPIO_LOCK_KEY;
+    HWREG(ui32Port + GPIO_O_CR) |= ui8Pins;
+    HWREG(ui32Port + GPIO_O_LOCK) = 0;
+    GPIOPinTypeGPIOInput(ui32Port, ui8Pins);
+    GPIOPadConfigSet(ui32Port, ui8Pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+    GPIOIntTypeSet(ui32Port, ui8Pins, GPIO_FALLING_EDGE);
+
+    TWHEEL_TimerInit(&g_sSampleTimer, BUTTON_Tick, 0);
+    TWHEEL_TimerStart(&g_sSampleTimer, BUTTON_SAMPLE_MS * 1000, BUTTON_SAMPLE_MS * 1000);
+}
+
+/*
+ * Falling edge while asleep: mask the edge and sample again, the debounce does the rest
+ * @param none
+ * @return void
+ */
+void BUTTON_IntHandler(void)
+{
+    GPIOIntDisable(g_ui32Port, g_ui8Pins);
+    GPIOIntClear(g_ui32Port, g_ui8Pins);
+
+    g_ui32IdleSamples = 0;
+    TWHEEL_TimerStart(&g_sSampleTimer, BUTTON_SAMPLE_MS * 1000, BUTTON_SAMPLE_MS * 1000);
+}
+
+/*
+ * Take the oldest event
+ * @param <tButtonEvent *> $psEvent filled in
+ * @return <bool> false if the queue is empty
+ */
+bool BUTTON_EventGet(tButtonEvent *psEvent)
+{
+    // the producer only pushes whole events
+    if (RING_Count(&g_sQueue) < sizeof(*psEvent))
+        return false;
+    RING_PopN(&g_sQueue, (uint8_t *)psEvent, sizeof(*psEvent));
+    return true;
+}
+
+/*
+ * For the sleep decision, call with interrupts disabled
+ * @return <bool> true if there are events to take
+ */
+bool BUTTON_Pending(void)
+{
+    return !RING_Empty(&g_sQueue);
+}
+
+/*
+ * @return <uint32_t> events lost because the queue was full
+ */
+uint32_t BUTTON_Dropped(void)
+{
+    return g_ui32Dropped;
+}
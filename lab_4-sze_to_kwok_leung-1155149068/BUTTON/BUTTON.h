@@ -0,0 +1,63 @@
+/*
+ * BUTTON.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Debounced push buttons on one GPIO port, active low with pull-ups.
+ *  While a button is down, a TWHEEL timer samples the pins every
+ *  BUTTON_SAMPLE_MS and each button runs its own debounce: a change of level
+ *  has to hold for BUTTON_DEBOUNCE samples.
+ *  After BUTTON_IDLE_SAMPLES samples with every button up the timer stops and
+ *  a falling edge restarts it, so the port's interrupt handler only has to
+ *  call BUTTON_IntHandler(), which masks the edge and starts the timer.
+ *
+ *  Events go into a RING, whole events at a time, read with BUTTON_EventGet();
+ *  the sample tick is the only producer and neither side disables interrupts:
+ *      PRESS and RELEASE   on every debounced change,
+ *      LONG                once, after the button is held BUTTON_LONG_MS,
+ *      DOUBLE              after PRESS, if the button was released less
+ *                          than BUTTON_DOUBLE_MS before.
+ *  The notify callback runs in the TIMER0 interrupt after events were
+ *  queued, e.g. to post a task. Call BUTTON_Init() after TWHEEL_Init().
+ */
+
+#ifndef BUTTON_BUTTON_H_
+#define BUTTON_BUTTON_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BUTTON_SAMPLE_MS    5
+#define BUTTON_DEBOUNCE     4       // samples, 20 ms
+#define BUTTON_LONG_MS      800
+#define BUTTON_DOUBLE_MS    300     // release to the next press
+#define BUTTON_IDLE_SAMPLES 20      // all up for 100 ms before waiting for an edge
+#define BUTTON_QUEUE        16      // events, power of 2
+
+/*
+ * Event types
+ */
+#define BUTTON_EVENT_PRESS      1
+#define BUTTON_EVENT_RELEASE    2
+#define BUTTON_EVENT_LONG       3
+#define BUTTON_EVENT_DOUBLE     4
+
+typedef struct
+{
+    uint8_t ui8Type;                // BUTTON_EVENT_*
+    uint8_t ui8Pin;                 // GPIO_PIN_* of the button
+    uint16_t ui16Time;              // TWHEEL_Now() / 1000 of the event, low 16 bits
+} tButtonEvent;
+
+typedef void (*tButtonNotify)(void);
+
+/*
+ * Function declaration(s)
+ */
+extern void BUTTON_Init(uint32_t ui32Port, uint8_t ui8Pins, tButtonNotify pfnNotify);
+extern void BUTTON_IntHandler(void);
+extern bool BUTTON_EventGet(tButtonEvent *psEvent);
+extern bool BUTTON_Pending(void);
+extern uint32_t BUTTON_Dropped(void);
+
+#endif /* BUTTON_BUTTON_H_ */
@@ -7,12 +7,18 @@
 #include "inc/tm4c123gh6pm.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include "TWHEEL/TWHEEL.h"
+#include "BUTTON/BUTTON.h"
 
 void GPIO_PORtF_Handler(void);
-void Timer0IntHandler(void);
+void SwitchPressed(void);
+void BlinkTimer(void *pvData);
+void ColorTimer(void *pvData);
 void delayMs(int n);
 void delayUs(int n);
 
+tTWheelTimer blinkTimer;
+tTWheelTimer colorTimer;
 uint32_t ui32Period_0;
 uint32_t ui32Period_1;
 uint8_t color = 2;
@@ -24,59 +30,64 @@ int main(void)
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
     GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
 
-    // Set the first timer
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
-    TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
-    ui32Period_0 = (SysCtlClockGet()) / 16;
-    TimerLoadSet(TIMER0_BASE, TIMER_A, ui32Period_0 - 1);
+    // Both timers run on the timer wheel, one hardware timer
+    TWHEEL_Init();
 
-    IntEnable(INT_TIMER0A);
-    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+    // Set the first timer (us)
+    ui32Period_0 = 1000000 / 16;
+    TWHEEL_TimerInit(&blinkTimer, BlinkTimer, 0);
+    TWHEEL_TimerStart(&blinkTimer, ui32Period_0, ui32Period_0);
 
-    // Set the second timer
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
-    TimerConfigure(TIMER1_BASE, TIMER_CFG_PERIODIC);
-    ui32Period_1 = SysCtlClockGet() * 2;
-    TimerLoadSet(TIMER1_BASE, TIMER_A, ui32Period_1 - 1);
-
-    IntEnable(INT_TIMER1A);
-    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+    // Set the second timer (us)
+    ui32Period_1 = 1000000 * 2;
+    TWHEEL_TimerInit(&colorTimer, ColorTimer, 0);
+    TWHEEL_TimerStart(&colorTimer, ui32Period_1, ui32Period_1);
 
     // Enable the timers
     IntMasterEnable();
-    TimerEnable(TIMER0_BASE, TIMER_A);
-    TimerEnable(TIMER1_BASE, TIMER_A);
-
-    // Configure switch interrupt
-    GPIOPinTypeGPIOInput(GPIO_PORTF_BASE, GPIO_PIN_4); // PF4 input
-    GPIOPadConfigSet(GPIO_PORTF_BASE, GPIO_PIN_4, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
-    GPIOIntEnable(GPIO_PORTF_BASE, GPIO_INT_PIN_4);                 // interrupt enable
-    GPIOIntTypeSet(GPIO_PORTF_BASE, GPIO_PIN_4, GPIO_FALLING_EDGE); // only interrupt at falling edge (pressed)
+
+    // Switch on PF4, debounced from the timer wheel, the edge interrupt only wakes it up
+    BUTTON_Init(GPIO_PORTF_BASE, GPIO_PIN_4, 0);
     GPIOIntRegister(GPIO_PORTF_BASE, GPIO_PORtF_Handler);           // dynamic isr registering
 
     while (1)
     {
+        tButtonEvent event;
+
+        while (BUTTON_EventGet(&event))
+        {
+            if (event.ui8Type == BUTTON_EVENT_PRESS)
+                SwitchPressed();
+        }
+
+        // nothing to do between timer callbacks
+        IntMasterDisable();
+        if (!BUTTON_Pending())
+            SysCtlSleep();
+        IntMasterEnable();
     }
 }
 
-// Handle the switch input
+// Handle the switch edge
 void GPIO_PORtF_Handler(void)
 {
-    GPIOIntClear(GPIO_PORTF_BASE, GPIO_INT_PIN_4);
+    BUTTON_IntHandler();
+}
+
+// Halve the blink rate on every press, 8 Hz after 2 Hz
+void SwitchPressed(void)
+{
     static int hz = 8;
 
     hz /= 2;
     hz = (hz < 2) ? 8 : hz;
-    ui32Period_0 = SysCtlClockGet() / (hz * 2);
-    TimerLoadSet(TIMER0_BASE, TIMER_A, ui32Period_0 - 1);
+    ui32Period_0 = 1000000 / (hz * 2);
+    TWHEEL_TimerStart(&blinkTimer, ui32Period_0, ui32Period_0);
 }
 
 // Handle the blinking
-void Timer0IntHandler(void)
+void BlinkTimer(void *pvData)
 {
-    // Clear the timer interrupt
-    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
-
     // Read the current state of the GPIO pin and
     if (GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3))
     {
@@ -89,10 +100,8 @@ void Timer0IntHandler(void)
 }
 
 // Handle the color change
-void Timer1IntHandler(void)
+void ColorTimer(void *pvData)
 {
-    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
-
     color = color * 2;
     color = (color > 8) ? 2 : color;
 }
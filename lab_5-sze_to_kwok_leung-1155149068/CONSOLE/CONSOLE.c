@@ -0,0 +1,294 @@
+/*
+ * CONSOLE.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <string.h>
+#include "CONSOLE.h"
+#include "RING/RING.h"
+#include "TIME/TIME.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_uart.h"
+
+static uint8_t g_pui8RxBuffer[CONSOLE_RX_SIZE];
+static uint8_t g_pui8TxBuffer[CONSOLE_TX_SIZE];
+static tRing g_sRx;                 // filled by the interrupt, emptied by CONSOLE_LineGet()
+static tRing g_sTx;                 // filled by CONSOLE_Write(), emptied by the interrupt
+
+static char g_pcLine[CONSOLE_LINE_MAX + 1];
+static uint32_t g_ui32LineLen;
+static bool g_bLineDone;            // g_pcLine is the line returned last time
+static bool g_bAfterCr;             // an LF right after a CR ends no line
+
+static uint32_t g_ui32IdleMs;
+static bool g_bEcho;
+static volatile uint32_t g_ui32LastRxMs;
+static volatile bool g_bActivity;
+static tConsoleStats g_sStats;
+
+/*
+ * Move bytes from the TX ring into the FIFO until one of them is full or empty
+ */
+static void CONSOLE_TxFill(void)
+{
+    const uint8_t *pui8Span;
+    uint32_t ui32Len, i;
+
+    while ((ui32Len = RING_ReadSpan(&g_sTx, &pui8Span)) != 0)
+    {
+        for (i = 0; i < ui32Len; i++)
+        {
+            if (!UARTCharPutNonBlocking(UART0_BASE, pui8Span[i]))
+                break;
+        }
+        RING_ReadCommit(&g_sTx, i);
+        g_sStats.ui32TxBytes += i;
+        if (i < ui32Len)
+            break;
+    }
+}
+
+/*
+ * The TX interrupt only comes when the FIFO drains past its level, so after
+ * queueing main context fills the FIFO itself, with the interrupt masked
+ */
+static void CONSOLE_TxKick(void)
+{
+    bool bMasked = IntMasterDisable();
+
+    CONSOLE_TxFill();
+    if (!bMasked)
+        IntMasterEnable();
+}
+
+static void CONSOLE_IntHandler(void)
+{
+    uint32_t ui32Status = UARTIntStatus(UART0_BASE, true);
+    int32_t i32Data;
+
+    UARTIntClear(UART0_BASE, ui32Status);
+
+    if (ui32Status & (UART_INT_RX | UART_INT_RT))
+    {
+        while (UARTCharsAvail(UART0_BASE))
+        {
+            i32Data = UARTCharGetNonBlocking(UART0_BASE);
+            if (i32Data & UART_DR_OE)
+                g_sStats.ui32RxOverruns++;
+            if (!RING_Push(&g_sRx, (uint8_t)i32Data))
+                g_sStats.ui32RxDropped++;
+            g_sStats.ui32RxBytes++;
+        }
+        g_ui32LastRxMs = TIME_Ms();
+        g_bActivity = true;
+    }
+
+    if (ui32Status & UART_INT_TX)
+    {
+        CONSOLE_TxFill();
+        g_bActivity = true;
+    }
+}
+
+/*
+ * Set up UART0 on PA0 / PA1 with its FIFOs and interrupts
+ * @param <uint32_t> $ui32Baud baud rate
+ * @param <uint32_t> $ui32IdleMs a partial line is complete after this long without input, 0 never
+ * @param <bool> $bEcho echo received bytes
+ * @return void
+ */
+void CONSOLE_Init(uint32_t ui32Baud, uint32_t ui32IdleMs, bool bEcho)
+{
+    RING_Init(&g_sRx, g_pui8RxBuffer, CONSOLE_RX_SIZE);
+    RING_Init(&g_sTx, g_pui8TxBuffer, CONSOLE_TX_SIZE);
+    g_ui32LineLen = 0;
+    g_bLineDone = false;
+    g_bAfterCr = false;
+    g_ui32IdleMs = ui32IdleMs;
+    g_bEcho = bEcho;
+    g_sStats = (tConsoleStats){ 0 };
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    GPIOPinConfigure(GPIO_PA0_U0RX);
+    GPIOPinConfigure(GPIO_PA1_U0TX);
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+
+    UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), ui32Baud,
+                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+    UARTFIFOEnable(UART0_BASE);
+    UARTFIFOLevelSet(UART0_BASE, UART_FIFO_TX2_8, UART_FIFO_RX4_8);
+    UARTTxIntModeSet(UART0_BASE, UART_TXINT_MODE_FIFO);
+
+    UARTIntRegister(UART0_BASE, CONSOLE_IntHandler);           // dynamic isr registering
+    UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+}
+
+/*
+ * Take the received bytes and return a line once it is complete
+ * @param <uint32_t *> $pui32Len set to the length of the line
+ * @return <char *> the line, zero terminated and valid until the next call, 0 if none is complete yet
+ */
+char *CONSOLE_LineGet(uint32_t *pui32Len)
+{
+    const uint8_t *pui8Span;
+    uint32_t ui32Len, ui32Echo, i;
+    uint8_t ui8Byte;
+    bool bDone = false;
+
+    if (g_bLineDone)
+    {
+        g_ui32LineLen = 0;
+        g_bLineDone = false;
+    }
+    ui32Echo = g_ui32LineLen;
+
+    while (!bDone && (ui32Len = RING_ReadSpan(&g_sRx, &pui8Span)) != 0)
+    {
+        for (i = 0; i < ui32Len && !bDone; i++)
+        {
+            ui8Byte = pui8Span[i];
+            if (ui8Byte == '\r' || ui8Byte == '\n')
+            {
+                bDone = ui8Byte == '\r' || !g_bAfterCr;
+                g_bAfterCr = ui8Byte == '\r';
+                g_sStats.ui32Lines += bDone;
+                continue;
+            }
+            g_bAfterCr = false;
+            g_pcLine[g_ui32LineLen++] = (char)ui8Byte;
+            if (g_ui32LineLen == CONSOLE_LINE_MAX)
+            {
+                bDone = true;
+                g_sStats.ui32LongLines++;
+            }
+        }
+
+        RING_ReadCommit(&g_sRx, i);
+    }
+
+    // echo the new part of the line, line ends excluded, as one block
+    if (g_bEcho && g_ui32LineLen > ui32Echo)
+    {
+        ui32Len = g_ui32LineLen - ui32Echo;
+        g_sStats.ui32EchoDropped += ui32Len - RING_PushN(&g_sTx, (uint8_t *)&g_pcLine[ui32Echo], ui32Len);
+        CONSOLE_TxKick();
+    }
+
+    // a partial line that stopped arriving
+    if (!bDone && g_ui32LineLen && g_ui32IdleMs && RING_Empty(&g_sRx) &&
+        TIME_Ms() - g_ui32LastRxMs >= g_ui32IdleMs)
+    {
+        bDone = true;
+        g_sStats.ui32IdleLines++;
+    }
+    if (!bDone)
+        return 0;
+
+    g_pcLine[g_ui32LineLen] = '\0';
+    g_bLineDone = true;
+    *pui32Len = g_ui32LineLen;
+    return g_pcLine;
+}
+
+/*
+ * For the sleep decision, call with interrupts disabled
+ * @return <bool> true if CONSOLE_LineGet() has received bytes to look at
+ */
+bool CONSOLE_RxPending(void)
+{
+    return !RING_Empty(&g_sRx);
+}
+
+/*
+ * Queue bytes for sending, sleeps while the TX ring is full. Not for interrupts.
+ * @param <const char *> $pcData bytes to send
+ * @param <uint32_t> $ui32Len number of bytes
+ * @return void
+ */
+void CONSOLE_Write(const char *pcData, uint32_t ui32Len)
+{
+    uint32_t ui32Done;
+
+    while (ui32Len)
+    {
+        ui32Done = RING_PushN(&g_sTx, (const uint8_t *)pcData, ui32Len);
+        pcData += ui32Done;
+        ui32Len -= ui32Done;
+        CONSOLE_TxKick();
+
+        // the TX interrupt makes room again
+        IntMasterDisable();
+        if (ui32Len && !RING_Free(&g_sTx))
+            SysCtlSleep();
+        IntMasterEnable();
+    }
+}
+
+/*
+ * @param <const char *> $pcString zero terminated string to send
+ * @return void
+ */
+void CONSOLE_Puts(const char *pcString)
+{
+    CONSOLE_Write(pcString, strlen(pcString));
+}
+
+/*
+ * Convert 'a' - 'z' to upper case in place, other bytes are left alone.
+ * A word holds four bytes; for each byte b (high bit clear), b + 0x1f sets
+ * the high bit from 'a' on and b + 0x05 from 'z' + 1 on, so the bytes with
+ * the first and without the second get 0x20 (the high bit >> 2) flipped.
+ * @param <char *> $pcText text
+ * @param <uint32_t> $ui32Len number of bytes
+ * @return void
+ */
+void CONSOLE_Upper(char *pcText, uint32_t ui32Len)
+{
+    uint32_t ui32Word, ui32Low, ui32Mask;
+
+    for (; ui32Len && ((uintptr_t)pcText & 3); pcText++, ui32Len--)
+    {
+        if (*pcText >= 'a' && *pcText <= 'z')
+            *pcText -= 'a' - 'A';
+    }
+    for (; ui32Len >= 4; pcText += 4, ui32Len -= 4)
+    {
+        ui32Word = *(uint32_t *)pcText;
+        ui32Low = ui32Word & 0x7f7f7f7f;
+        ui32Mask = (ui32Low + 0x1f1f1f1f) & ~(ui32Low + 0x05050505) & ~ui32Word & 0x80808080;
+        *(uint32_t *)pcText = ui32Word ^ (ui32Mask >> 2);
+    }
+    for (; ui32Len; pcText++, ui32Len--)
+    {
+        if (*pcText >= 'a' && *pcText <= 'z')
+            *pcText -= 'a' - 'A';
+    }
+}
+
+/*
+ * @return <bool> true if bytes were sent or received since the last call
+ */
+bool CONSOLE_Activity(void)
+{
+    bool bActivity = g_bActivity;
+
+    g_bActivity = false;
+    return bActivity;
+}
+
+/*
+ * @param <tConsoleStats *> $psStats filled in
+ * @return void
+ */
+void CONSOLE_StatsGet(tConsoleStats *psStats)
+{
+    *psStats = g_sStats;
+}
@@ -0,0 +1,57 @@
+/*
+ * CONSOLE.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Line oriented console on UART0.
+ *  The UART interrupt only moves bytes: the RX FIFO (interrupt at half full
+ *  and on the receive timeout) is emptied into an RX ring, and the TX FIFO is
+ *  refilled from a TX ring whenever it drains below 1/4. Everything else
+ *  runs in main context: CONSOLE_LineGet() takes the received bytes in spans,
+ *  echoes them and collects them into a line, which is complete on CR or LF,
+ *  when it is CONSOLE_LINE_MAX long, or when no byte has arrived for the
+ *  idle time (a paste without a line end).
+ *
+ *  The rings absorb bursts, so a pasted line is not lost while main is busy
+ *  with the previous one. The echo never waits: when the TX ring has no room
+ *  it is dropped and counted, only CONSOLE_Write() waits (asleep) for room.
+ *
+ *  CONSOLE_Upper() converts a line to upper case four bytes at a time.
+ *  The idle time needs TIME_Init() to have been called.
+ */
+
+#ifndef CONSOLE_CONSOLE_H_
+#define CONSOLE_CONSOLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CONSOLE_RX_SIZE     1024        // power of 2
+#define CONSOLE_TX_SIZE     1024        // power of 2
+#define CONSOLE_LINE_MAX    256
+
+typedef struct
+{
+    uint32_t ui32RxBytes;
+    uint32_t ui32RxDropped;         // the RX ring was full
+    uint32_t ui32RxOverruns;        // the RX FIFO was full, the hardware lost bytes
+    uint32_t ui32Lines;             // lines ended by CR or LF
+    uint32_t ui32IdleLines;         // lines ended by the idle time
+    uint32_t ui32LongLines;         // lines cut at CONSOLE_LINE_MAX
+    uint32_t ui32TxBytes;
+    uint32_t ui32EchoDropped;       // echo bytes without room in the TX ring
+} tConsoleStats;
+
+/*
+ * Function declaration(s)
+ */
+extern void CONSOLE_Init(uint32_t ui32Baud, uint32_t ui32IdleMs, bool bEcho);
+extern char *CONSOLE_LineGet(uint32_t *pui32Len);
+extern bool CONSOLE_RxPending(void);
+extern void CONSOLE_Write(const char *pcData, uint32_t ui32Len);
+extern void CONSOLE_Puts(const char *pcString);
+extern void CONSOLE_Upper(char *pcText, uint32_t ui32Len);
+extern bool CONSOLE_Activity(void);
+extern void CONSOLE_StatsGet(tConsoleStats *psStats);
+
+#endif /* CONSOLE_CONSOLE_H_ */
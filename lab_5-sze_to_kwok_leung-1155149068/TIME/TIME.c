@@ -0,0 +1,168 @@
+/*
+ * TIME.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "TIME.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
+#include "inc/hw_nvic.h"
+#include "inc/hw_types.h"
+
+// milliseconds since TIME_Init()
+static volatile uint64_t g_ui64Ms;
+
+// SysTick reload value and counts per microsecond
+static uint32_t g_ui32Load;
+static uint32_t g_ui32CyclesPerUs;
+
+// every timer that has been started at least once
+static tTimeTimer *g_psTimers;
+
+static void TIME_IntHandler(void)
+{
+    tTimeTimer *psTimer;
+    uint32_t ui32Now;
+
+    g_ui64Ms++;
+    ui32Now = (uint32_t)g_ui64Ms;
+
+    for (psTimer = g_psTimers; psTimer; psTimer = psTimer->psNext)
+    {
+        if (!psTimer->bActive || TIME_After(psTimer->ui32Due, ui32Now))
+            continue;
+
+        if (psTimer->ui32Period)
+            psTimer->ui32Due += psTimer->ui32Period;
+        else
+            psTimer->bActive = false;
+
+        // the callback may restart or stop its own timer
+        psTimer->pfnCallback(psTimer->pvData);
+    }
+}
+
+/*
+ * Start SysTick at TIME_TICK_HZ, call after the system clock is set
+ * @param none
+ * @return void
+ */
+void TIME_Init(void)
+{
+    g_ui32CyclesPerUs = SysCtlClockGet() / 1000000;
+    g_ui32Load = SysCtlClockGet() / TIME_TICK_HZ;
+    g_ui64Ms = 0;
+    g_psTimers = 0;
+
+    SysTickPeriodSet(g_ui32Load);
+    SysTickIntRegister(TIME_IntHandler);            // dynamic isr registering
+    SysTickIntEnable();
+    SysTickEnable();
+}
+
+/*
+ * @return <uint64_t> microseconds since TIME_Init()
+ */
+uint64_t TIME_Us(void)
+{
+    uint64_t ui64Ms;
+    uint32_t ui32Value;
+    bool bPending;
+
+    // retry if the tick interrupt ran in between
+    do
+    {
+        ui64Ms = g_ui64Ms;
+        ui32Value = SysTickValueGet();
+        bPending = (HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_PENDSTSET) != 0;
+    } while (ui64Ms != g_ui64Ms);
+
+    // called with the tick masked: the counter wrapped but was not counted yet
+    if (bPending && ui32Value > g_ui32Load / 2)
+        ui64Ms++;
+
+    // SysTick counts down from g_ui32Load - 1
+    return ui64Ms * 1000 + (g_ui32Load - 1 - ui32Value) / g_ui32CyclesPerUs;
+}
+
+/*
+ * @return <uint32_t> milliseconds since TIME_Init(), wraps after 49 days
+ */
+uint32_t TIME_Ms(void)
+{
+    return (uint32_t)g_ui64Ms;
+}
+
+/*
+ * @param <uint64_t> $ui64Deadline TIME_Us() value
+ * @return <bool> true once the deadline has passed
+ */
+bool TIME_Expired(uint64_t ui64Deadline)
+{
+    return TIME_Us() >= ui64Deadline;
+}
+
+/*
+ * Blocking wait, only for start-up sequences that have nothing else to do
+ * @param <uint32_t> $ui32Us time to wait (us)
+ * @return void
+ */
+void TIME_DelayUs(uint32_t ui32Us)
+{
+    uint64_t ui64Deadline = TIME_Us() + ui32Us;
+
+    while (!TIME_Expired(ui64Deadline))
+    {
+    }
+}
+
+/*
+ * Bind a callback to a timer, the timer stays stopped
+ * @param <tTimeTimer *> $psTimer timer, must stay valid while started
+ * @param <tTimeCallback> $pfnCallback called from the SysTick interrupt
+ * @param <void *> $pvData passed to the callback
+ * @return void
+ */
+void TIME_TimerInit(tTimeTimer *psTimer, tTimeCallback pfnCallback, void *pvData)
+{
+    psTimer->pfnCallback = pfnCallback;
+    psTimer->pvData = pvData;
+    psTimer->ui32Period = 0;
+    psTimer->bActive = false;
+    psTimer->bLinked = false;
+    psTimer->psNext = 0;
+}
+
+/*
+ * (Re)start a timer, a running timer is moved to the new deadline
+ * @param <tTimeTimer *> $psTimer timer
+ * @param <uint32_t> $ui32DelayMs time to the first call (ms)
+ * @param <uint32_t> $ui32PeriodMs time between later calls (ms), 0 for a one shot
+ * @return void
+ */
+void TIME_TimerStart(tTimeTimer *psTimer, uint32_t ui32DelayMs, uint32_t ui32PeriodMs)
+{
+    SysTickIntDisable();
+
+    psTimer->ui32Period = ui32PeriodMs;
+    psTimer->ui32Due = (uint32_t)g_ui64Ms + ui32DelayMs;
+    psTimer->bActive = true;
+    if (!psTimer->bLinked)
+    {
+        psTimer->psNext = g_psTimers;
+        g_psTimers = psTimer;
+        psTimer->bLinked = true;
+    }
+
+    SysTickIntEnable();
+}
+
+/*
+ * @param <tTimeTimer *> $psTimer timer, nothing happens if it is not running
+ * @return void
+ */
+void TIME_TimerStop(tTimeTimer *psTimer)
+{
+    psTimer->bActive = false;
+}
@@ -1,153 +1,66 @@
 #include <stdbool.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include "driverlib/gpio.h"
 #include "driverlib/interrupt.h"
-#include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
-#include "driverlib/uart.h"
-#include "inc/hw_ints.h"
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
+#include "TIME/TIME.h"
+#include "CONSOLE/CONSOLE.h"
 
-#define MAX_QUEUE_SIZE 100
+// A line pasted without a line end is taken after this long,
+// longer than a typing pause
+#define IDLE_MS 2000
 
-struct
-{
-    char data[MAX_QUEUE_SIZE];
-    uint32_t head;
-    uint32_t tail;
-    uint32_t count;
-} typedef Queue;
+// The LED shows UART traffic, on and off for one period each while bytes move
+#define LED_PERIOD_MS 25
 
-void Q_Init(Queue *q)
-{
-    int i;
-    for (i = 0; i < MAX_QUEUE_SIZE; i++)
-        q->data[i] = 0;
-    q->head = 0;
-    q->tail = 0;
-    q->count = 0;
-}
-
-int Q_Empty(Queue *q)
-{
-    return q->count == 0;
-}
-
-int Q_Full(Queue *q)
-{
-    return q->count == MAX_QUEUE_SIZE;
-}
+tTimeTimer ledTimer;
 
-int Q_Enequeue(Queue *q, char data)
+// Sampled from the SysTick interrupt instead of delaying in the UART one
+void LedTick(void *pvData)
 {
-    if (!q || Q_Full(q))
-        return -1;
-    q->data[q->tail] = data;
-    q->tail = (q->tail + 1) % MAX_QUEUE_SIZE;
-    q->count++;
-    return 0;
-}
+    bool on = GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_2) != 0;
 
-char Q_Dequeue(Queue *q)
-{
-    if (!q || Q_Empty(q))
-        return 0;
-    char data = q->data[q->head];
-    q->head = (q->head + 1) % MAX_QUEUE_SIZE;
-    q->count--;
-    return data;
+    GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, !on && CONSOLE_Activity() ? GPIO_PIN_2 : 0);
 }
 
-Queue q;
-
 int main(void)
 {
-    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
-
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    char *line;
+    uint32_t len;
 
-    GPIOPinConfigure(GPIO_PA0_U0RX);
-    GPIOPinConfigure(GPIO_PA1_U0TX);
-    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
-
-    UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 115200,
-                        (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+    SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
 
-    IntMasterEnable();
-    IntEnable(INT_UART0);
-    UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    TIME_Init();
+    CONSOLE_Init(115200, IDLE_MS, true);
 
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
     GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
+    TIME_TimerInit(&ledTimer, LedTick, 0);
+    TIME_TimerStart(&ledTimer, LED_PERIOD_MS, LED_PERIOD_MS);
 
-    Q_Init(&q);
+    IntMasterEnable();
 
-    UARTCharPut(UART0_BASE, 'E');
-    UARTCharPut(UART0_BASE, 'n');
-    UARTCharPut(UART0_BASE, 't');
-    UARTCharPut(UART0_BASE, 'e');
-    UARTCharPut(UART0_BASE, 'r');
-    UARTCharPut(UART0_BASE, ' ');
-    UARTCharPut(UART0_BASE, 'T');
-    UARTCharPut(UART0_BASE, 'e');
-    UARTCharPut(UART0_BASE, 'x');
-    UARTCharPut(UART0_BASE, 't');
-    UARTCharPut(UART0_BASE, ':');
-    UARTCharPut(UART0_BASE, ' ');
+    CONSOLE_Puts("Enter Text: ");
 
     while (1)
     {
-    }
-}
-
-void UARTStringPut(char *str)
-{
-    int i;
-    for (i = 0; str[i] != '\0'; i++)
-    {
-        UARTCharPut(UART0_BASE, str[i]);
-    }
-}
-
-void UARTIntHandler(void)
-{
-    uint32_t ui32Status;
-
-    ui32Status = UARTIntStatus(UART0_BASE, true); // get interrupt status
-
-    UARTIntClear(UART0_BASE, ui32Status); // clear the asserted interrupts
-
-    while (UARTCharsAvail(UART0_BASE)) // loop while there are chars
-    {
-        char c = UARTCharGet(UART0_BASE);
-
-        // If it is an enter key, then print the queue
-        if (c == 10 || c == 13)
+        // Convert each complete line to upper case and print it
+        line = CONSOLE_LineGet(&len);
+        if (line)
         {
-            UARTCharPut(UART0_BASE, '\n');
-            UARTCharPut(UART0_BASE, '\r');
-            while (!Q_Empty(&q))
-            {
-                UARTCharPut(UART0_BASE, Q_Dequeue(&q));
-            }
-            UARTCharPut(UART0_BASE, '\n');
-            UARTCharPut(UART0_BASE, '\r');
+            CONSOLE_Upper(line, len);
+            CONSOLE_Write("\n\r", 2);
+            CONSOLE_Write(line, len);
+            CONSOLE_Write("\n\r", 2);
+            continue;
         }
-        else
-        {
-            UARTCharPut(UART0_BASE, c);                            // echo character
-            GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PIN_2); // blink LED
-            SysCtlDelay(SysCtlClockGet() / (1000 * 3));            // delay ~1 msec
-            GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, 0);          // turn off LED
 
-            // Convert to upper case and enqueue
-            if (c >= 'a' && c <= 'z')
-                c = c - 'a' + 'A';
-
-            Q_Enequeue(&q, c);
-        }
+        // SysTick wakes up for the idle time and the LED
+        IntMasterDisable();
+        if (!CONSOLE_RxPending())
+            SysCtlSleep();
+        IntMasterEnable();
     }
 }
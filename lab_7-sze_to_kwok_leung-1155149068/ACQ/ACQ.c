@@ -0,0 +1,191 @@
+/*
+ * ACQ.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "ACQ.h"
+#include "driverlib/adc.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
+#include "inc/hw_adc.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+
+#define ACQ_SEQ             0
+#define ACQ_DMA_CHANNEL     UDMA_CHANNEL_ADC0
+
+// one control table for all channels, 1024 byte aligned
+#if defined(ewarm)
+#pragma data_alignment=1024
+static tDMAControlTable g_psControlTable[64];
+#elif defined(ccs)
+#pragma DATA_ALIGN(g_psControlTable, 1024)
+static tDMAControlTable g_psControlTable[64];
+#else
+static tDMAControlTable g_psControlTable[64] __attribute__ ((aligned(1024)));
+#endif
+
+static uint16_t g_ppui16Blocks[2][ACQ_BLOCK];
+static const uint32_t ACQ_SELECT[2] = { UDMA_PRI_SELECT, UDMA_ALT_SELECT };
+
+static uint32_t g_ui32Channels;
+static uint32_t g_ui32Arbitration;
+static uint32_t g_ui32NextBlock;    // 0 primary, 1 alternate: the one the DMA finishes next
+static tAcqCallback g_pfnCallback;
+static tAcqStats g_sStats;
+
+static void ACQ_Arm(uint32_t ui32Block)
+{
+    uDMAChannelControlSet(ACQ_DMA_CHANNEL | ACQ_SELECT[ui32Block],
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | g_ui32Arbitration);
+    uDMAChannelTransferSet(ACQ_DMA_CHANNEL | ACQ_SELECT[ui32Block], UDMA_MODE_PINGPONG,
+                           (void *)(ADC0_BASE + ADC_O_SSFIFO0), g_ppui16Blocks[ui32Block], ACQ_BLOCK);
+}
+
+/*
+ * DMA completion: hand over the finished blocks in the order they filled
+ */
+static void ACQ_IntHandler(void)
+{
+    uint32_t ui32Block;
+
+    ADCIntClear(ADC0_BASE, ACQ_SEQ);
+
+    if (ADCSequenceOverflow(ADC0_BASE, ACQ_SEQ))
+    {
+        ADCSequenceOverflowClear(ADC0_BASE, ACQ_SEQ);
+        g_sStats.ui32Overflows++;
+    }
+
+    // both stopped: the channel went idle and the FIFO is filling up
+    if (uDMAChannelModeGet(ACQ_DMA_CHANNEL | UDMA_PRI_SELECT) == UDMA_MODE_STOP &&
+        uDMAChannelModeGet(ACQ_DMA_CHANNEL | UDMA_ALT_SELECT) == UDMA_MODE_STOP)
+        g_sStats.ui32Overruns++;
+
+    while (uDMAChannelModeGet(ACQ_DMA_CHANNEL | ACQ_SELECT[g_ui32NextBlock]) == UDMA_MODE_STOP)
+    {
+        ui32Block = g_ui32NextBlock;
+        g_ui32NextBlock ^= 1;
+
+        // read out before the block is armed again: after an overrun the
+        // channel restarts straight into it
+        g_sStats.ui32Blocks++;
+        if (g_pfnCallback)
+            g_pfnCallback(g_ppui16Blocks[ui32Block], ACQ_BLOCK);
+
+        ACQ_Arm(ui32Block);
+        if (!uDMAChannelIsEnabled(ACQ_DMA_CHANNEL))
+            uDMAChannelEnable(ACQ_DMA_CHANNEL);
+    }
+}
+
+/*
+ * Set up the sequencer, its trigger timer and the DMA, sampling starts with ACQ_Start()
+ * @param <const uint32_t *> $pui32Channels ADC_CTL_CH0 - ADC_CTL_CH11 or ADC_CTL_TS, converted in this order
+ * @param <uint32_t> $ui32Count number of channels: 1, 2, 4 or 8
+ * @param <uint32_t> $ui32RateHz sequences per second, every channel once
+ * @param <uint32_t> $ui32Oversample hardware averaging per step: 1, 2, 4, ... ACQ_MAX_OVERSAMPLE
+ * @param <tAcqCallback> $pfnCallback gets each full block, in the ADC interrupt
+ * @return <bool> false if the configuration is invalid or over the converter limit
+ */
+bool ACQ_Init(const uint32_t *pui32Channels, uint32_t ui32Count, uint32_t ui32RateHz,
+              uint32_t ui32Oversample, tAcqCallback pfnCallback)
+{
+    uint32_t i;
+
+    // a DMA request moves one whole sequence, the arbitration size is a power of 2
+    switch (ui32Count)
+    {
+    case 1: g_ui32Arbitration = UDMA_ARB_1; break;
+    case 2: g_ui32Arbitration = UDMA_ARB_2; break;
+    case 4: g_ui32Arbitration = UDMA_ARB_4; break;
+    case 8: g_ui32Arbitration = UDMA_ARB_8; break;
+    default: return false;
+    }
+    if (!ui32Oversample || ui32Oversample > ACQ_MAX_OVERSAMPLE || (ui32Oversample & (ui32Oversample - 1)))
+        return false;
+    if (!ui32RateHz || (uint64_t)ui32RateHz * ui32Count * ui32Oversample > ACQ_MAX_RATE)
+        return false;
+
+    g_ui32Channels = ui32Count;
+    g_pfnCallback = pfnCallback;
+    g_sStats = (tAcqStats){ 0 };
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+    ADCClockConfigSet(ADC0_BASE, ADC_CLOCK_SRC_PIOSC | ADC_CLOCK_RATE_FULL, 1);
+    ADCHardwareOversampleConfigure(ADC0_BASE, ui32Oversample);
+
+    ADCSequenceDisable(ADC0_BASE, ACQ_SEQ);
+    ADCSequenceConfigure(ADC0_BASE, ACQ_SEQ, ADC_TRIGGER_TIMER, 0);
+    for (i = 0; i < ui32Count; i++)
+        ADCSequenceStepConfigure(ADC0_BASE, ACQ_SEQ, i,
+                                 pui32Channels[i] | (i == ui32Count - 1 ? ADC_CTL_IE | ADC_CTL_END : 0));
+    ADCSequenceDMAEnable(ADC0_BASE, ACQ_SEQ);
+
+    // the sequence done flag only requests the DMA, the interrupt comes when a block is full
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    uDMAEnable();
+    uDMAControlBaseSet(g_psControlTable);
+    uDMAChannelAssign(UDMA_CH14_ADC0_0);
+    uDMAChannelAttributeDisable(ACQ_DMA_CHANNEL, UDMA_ATTR_ALL);
+    uDMAChannelAttributeEnable(ACQ_DMA_CHANNEL, UDMA_ATTR_USEBURST);
+    ADCIntRegister(ADC0_BASE, ACQ_SEQ, ACQ_IntHandler);         // dynamic isr registering
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER2);
+    TimerConfigure(TIMER2_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(TIMER2_BASE, TIMER_A, SysCtlClockGet() / ui32RateHz - 1);
+    TimerControlTrigger(TIMER2_BASE, TIMER_A, true);
+
+    return true;
+}
+
+/*
+ * Start sampling into an empty primary block
+ * @param none
+ * @return void
+ */
+void ACQ_Start(void)
+{
+    g_ui32NextBlock = 0;
+    ACQ_Arm(0);
+    ACQ_Arm(1);
+    uDMAChannelAttributeDisable(ACQ_DMA_CHANNEL, UDMA_ATTR_ALTSELECT);
+    uDMAChannelEnable(ACQ_DMA_CHANNEL);
+
+    ADCIntClear(ADC0_BASE, ACQ_SEQ);
+    ADCSequenceEnable(ADC0_BASE, ACQ_SEQ);
+    TimerEnable(TIMER2_BASE, TIMER_A);
+}
+
+/*
+ * Stop the trigger, a partly filled block is dropped
+ * @param none
+ * @return void
+ */
+void ACQ_Stop(void)
+{
+    TimerDisable(TIMER2_BASE, TIMER_A);
+    ADCSequenceDisable(ADC0_BASE, ACQ_SEQ);
+    uDMAChannelDisable(ACQ_DMA_CHANNEL);
+}
+
+/*
+ * @return <uint32_t> channels interleaved in a block
+ */
+uint32_t ACQ_Channels(void)
+{
+    return g_ui32Channels;
+}
+
+/*
+ * @param <tAcqStats *> $psStats filled in
+ * @return void
+ */
+void ACQ_StatsGet(tAcqStats *psStats)
+{
+    *psStats = g_sStats;
+}
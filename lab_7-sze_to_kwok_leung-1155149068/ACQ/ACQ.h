@@ -0,0 +1,50 @@
+/*
+ * ACQ.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  ADC0 acquisition without the CPU in the sample path.
+ *  TIMER2A triggers sequencer 0 at a fixed rate; each trigger converts every
+ *  configured channel once (up to ACQ_MAX_CHANNELS steps, the temperature
+ *  sensor is ADC_CTL_TS), each step averaged over the hardware oversampling
+ *  factor. The end of the sequence requests the uDMA, which moves the results
+ *  in ping-pong mode into two blocks of ACQ_BLOCK samples: while one block
+ *  fills, the callback gets the other one. Samples in a block are interleaved
+ *  in channel order.
+ *
+ *  The callback runs in the ADC interrupt and has one block time to finish,
+ *  afterwards the DMA writes into its block again. The converter limit is
+ *  ACQ_MAX_RATE conversions per second: rate * channels * oversampling.
+ */
+
+#ifndef ACQ_ACQ_H_
+#define ACQ_ACQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ACQ_BLOCK           256         // samples per block, multiple of 8, at most 1024
+#define ACQ_MAX_CHANNELS    8
+#define ACQ_MAX_RATE        1000000     // conversions per second
+#define ACQ_MAX_OVERSAMPLE  64
+
+typedef void (*tAcqCallback)(const uint16_t *pui16Block, uint32_t ui32Count);
+
+typedef struct
+{
+    uint32_t ui32Blocks;            // blocks handed to the callback
+    uint32_t ui32Overruns;          // both blocks were full, the DMA had stopped
+    uint32_t ui32Overflows;         // the sequencer FIFO overflowed, samples were lost
+} tAcqStats;
+
+/*
+ * Function declaration(s)
+ */
+extern bool ACQ_Init(const uint32_t *pui32Channels, uint32_t ui32Count, uint32_t ui32RateHz,
+                     uint32_t ui32Oversample, tAcqCallback pfnCallback);
+extern void ACQ_Start(void);
+extern void ACQ_Stop(void);
+extern uint32_t ACQ_Channels(void);
+extern void ACQ_StatsGet(tAcqStats *psStats);
+
+#endif /* ACQ_ACQ_H_ */
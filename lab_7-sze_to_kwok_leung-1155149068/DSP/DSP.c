@@ -0,0 +1,350 @@
+/*
+ * DSP.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "DSP.h"
+#include "inc/hw_types.h"
+
+#define DSP_DEMCR           0xE000EDFC
+#define DSP_DEMCR_TRCENA    0x01000000
+#define DSP_DWT_CTRL        0xE0001000
+#define DSP_DWT_CYCCNTENA   0x00000001
+#define DSP_DWT_CYCCNT      0xE0001004
+
+// DSP_Cic() keeps its integrators in registers, one per stage
+#if DSP_CIC_ORDER != 3
+#error "DSP_Cic() is written for 3 stages"
+#endif
+
+static uint32_t DSP_Log2(uint32_t ui32Value)
+{
+    uint32_t ui32Log = 0;
+
+    while (ui32Value > 1)
+    {
+        ui32Value >>= 1;
+        ui32Log++;
+    }
+    return ui32Log;
+}
+
+static bool DSP_PowerOf2(uint32_t ui32Value)
+{
+    return ui32Value && !(ui32Value & (ui32Value - 1));
+}
+
+/*
+ * @param <tDspCic *> $psCic state
+ * @param <uint32_t> $ui32Rate decimation, a power of 2 from 2 to DSP_CIC_MAX_RATE
+ * @return <bool> false if the rate is not supported
+ */
+bool DSP_CicInit(tDspCic *psCic, uint32_t ui32Rate)
+{
+    uint32_t i;
+
+    if (ui32Rate < 2 || ui32Rate > DSP_CIC_MAX_RATE || !DSP_PowerOf2(ui32Rate))
+        return false;
+    for (i = 0; i < DSP_CIC_ORDER; i++)
+        psCic->pui32Integ[i] = psCic->pui32Comb[i] = 0;
+    psCic->ui32Rate = ui32Rate;
+    psCic->ui32Shift = DSP_Log2(ui32Rate) * DSP_CIC_ORDER;
+    psCic->ui32Phase = 0;
+    return true;
+}
+
+/*
+ * Integrate raw ADC codes at the input rate, comb and scale at the output rate
+ * @param <tDspCic *> $psCic state
+ * @param <const uint16_t *> $pui16In 12 bit samples
+ * @param <uint32_t> $ui32Count number of samples
+ * @param <int32_t *> $pi32Out room for ui32Count / rate + 1 values, DSP_FRAC fraction bits
+ * @return <uint32_t> number of values written
+ */
+uint32_t DSP_Cic(tDspCic *psCic, const uint16_t *pui16In, uint32_t ui32Count, int32_t *pi32Out)
+{
+    uint32_t ui32I0 = psCic->pui32Integ[0], ui32I1 = psCic->pui32Integ[1], ui32I2 = psCic->pui32Integ[2];
+    uint32_t ui32Out = 0, ui32Value, ui32Prev, i, j;
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        ui32I0 += pui16In[i];
+        ui32I1 += ui32I0;
+        ui32I2 += ui32I1;
+        if (++psCic->ui32Phase < psCic->ui32Rate)
+            continue;
+        psCic->ui32Phase = 0;
+
+        ui32Value = ui32I2;
+        for (j = 0; j < DSP_CIC_ORDER; j++)
+        {
+            ui32Prev = ui32Value;
+            ui32Value -= psCic->pui32Comb[j];
+            psCic->pui32Comb[j] = ui32Prev;
+        }
+
+        // gain rate^order is a shift, keep DSP_FRAC bits of it
+        if (psCic->ui32Shift > DSP_FRAC)
+            ui32Value = (ui32Value + (1UL << (psCic->ui32Shift - DSP_FRAC - 1))) >> (psCic->ui32Shift - DSP_FRAC);
+        else
+            ui32Value <<= DSP_FRAC - psCic->ui32Shift;
+        pi32Out[ui32Out++] = (int32_t)ui32Value;
+    }
+
+    psCic->pui32Integ[0] = ui32I0;
+    psCic->pui32Integ[1] = ui32I1;
+    psCic->pui32Integ[2] = ui32I2;
+    return ui32Out;
+}
+
+/*
+ * @param <tDspFir *> $psFir state
+ * @param <const int16_t *> $pi16Coef Q15 coefficients, kept by reference
+ * @param <uint32_t> $ui32Taps 1 - DSP_FIR_MAX_TAPS
+ * @param <uint32_t> $ui32Decimation one output per this many inputs, 1 for none
+ * @return <bool> false if the sizes are not supported
+ */
+bool DSP_FirInit(tDspFir *psFir, const int16_t *pi16Coef, uint32_t ui32Taps, uint32_t ui32Decimation)
+{
+    uint32_t i;
+
+    if (!ui32Taps || ui32Taps > DSP_FIR_MAX_TAPS || !ui32Decimation)
+        return false;
+    psFir->pi16Coef = pi16Coef;
+    psFir->ui32Taps = ui32Taps;
+    psFir->ui32Decimation = ui32Decimation;
+    psFir->ui32Phase = 0;
+    psFir->ui32Pos = 0;
+    for (i = 0; i < 2 * ui32Taps; i++)
+        psFir->pi32History[i] = 0;
+    return true;
+}
+
+/*
+ * Filter and decimate, may run in place
+ * @param <tDspFir *> $psFir state
+ * @param <const int32_t *> $pi32In values
+ * @param <uint32_t> $ui32Count number of values
+ * @param <int32_t *> $pi32Out room for ui32Count / decimation + 1 values
+ * @return <uint32_t> number of values written
+ */
+uint32_t DSP_Fir(tDspFir *psFir, const int32_t *pi32In, uint32_t ui32Count, int32_t *pi32Out)
+{
+    const int16_t *pi16Coef = psFir->pi16Coef;
+    const int32_t *pi32History;
+    uint32_t ui32Taps = psFir->ui32Taps;
+    uint32_t ui32Out = 0, i, k;
+    int64_t i64Acc;
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        // newest value first, coefficient k goes with the value k samples old
+        psFir->ui32Pos = psFir->ui32Pos ? psFir->ui32Pos - 1 : ui32Taps - 1;
+        psFir->pi32History[psFir->ui32Pos] = psFir->pi32History[psFir->ui32Pos + ui32Taps] = pi32In[i];
+        if (++psFir->ui32Phase < psFir->ui32Decimation)
+            continue;
+        psFir->ui32Phase = 0;
+
+        pi32History = &psFir->pi32History[psFir->ui32Pos];
+        i64Acc = 1 << 14;
+        for (k = 0; k < ui32Taps; k++)
+            i64Acc += (int64_t)pi16Coef[k] * pi32History[k];
+        pi32Out[ui32Out++] = (int32_t)(i64Acc >> 15);
+    }
+    return ui32Out;
+}
+
+/*
+ * @param <tDspMa *> $psMa state
+ * @param <uint32_t> $ui32Len window, a power of 2 up to DSP_MA_MAX
+ * @return <bool> false if the window is not supported
+ */
+bool DSP_MaInit(tDspMa *psMa, uint32_t ui32Len)
+{
+    if (!DSP_PowerOf2(ui32Len) || ui32Len > DSP_MA_MAX)
+        return false;
+    psMa->ui32Len = ui32Len;
+    psMa->ui32Shift = DSP_Log2(ui32Len);
+    psMa->ui32Pos = 0;
+    psMa->i32Sum = 0;
+    psMa->bPrimed = false;
+    return true;
+}
+
+/*
+ * One output per input, the window starts filled with the first value; may run in place
+ * @param <tDspMa *> $psMa state
+ * @param <const int32_t *> $pi32In values
+ * @param <uint32_t> $ui32Count number of values
+ * @param <int32_t *> $pi32Out room for ui32Count values
+ * @return void
+ */
+void DSP_Ma(tDspMa *psMa, const int32_t *pi32In, uint32_t ui32Count, int32_t *pi32Out)
+{
+    uint32_t i;
+
+    if (ui32Count && !psMa->bPrimed)
+    {
+        for (i = 0; i < psMa->ui32Len; i++)
+            psMa->pi32Window[i] = pi32In[0];
+        psMa->i32Sum = pi32In[0] * (int32_t)psMa->ui32Len;
+        psMa->bPrimed = true;
+    }
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        psMa->i32Sum += pi32In[i] - psMa->pi32Window[psMa->ui32Pos];
+        psMa->pi32Window[psMa->ui32Pos] = pi32In[i];
+        psMa->ui32Pos = (psMa->ui32Pos + 1) & (psMa->ui32Len - 1);
+        pi32Out[i] = (psMa->i32Sum + (int32_t)(psMa->ui32Len >> 1)) >> psMa->ui32Shift;
+    }
+}
+
+/*
+ * @param <tDspEma *> $psEma state
+ * @param <uint32_t> $ui32Shift smoothing, alpha = 1 / 2^shift, 0 - 14
+ * @return void
+ */
+void DSP_EmaInit(tDspEma *psEma, uint32_t ui32Shift)
+{
+    psEma->ui32Shift = ui32Shift > 14 ? 14 : ui32Shift;
+    psEma->i32Acc = 0;
+    psEma->bPrimed = false;
+}
+
+/*
+ * One output per input, starts at the first value; may run in place
+ * @param <tDspEma *> $psEma state
+ * @param <const int32_t *> $pi32In values, |value| < 2^16
+ * @param <uint32_t> $ui32Count number of values
+ * @param <int32_t *> $pi32Out room for ui32Count values
+ * @return void
+ */
+void DSP_Ema(tDspEma *psEma, const int32_t *pi32In, uint32_t ui32Count, int32_t *pi32Out)
+{
+    uint32_t ui32Shift = psEma->ui32Shift;
+    int32_t i32Half = ui32Shift ? 1 << (ui32Shift - 1) : 0;
+    uint32_t i;
+
+    if (ui32Count && !psEma->bPrimed)
+    {
+        psEma->i32Acc = pi32In[0] * (1 << ui32Shift);
+        psEma->bPrimed = true;
+    }
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        psEma->i32Acc += pi32In[i] - ((psEma->i32Acc + i32Half) >> ui32Shift);
+        pi32Out[i] = (psEma->i32Acc + i32Half) >> ui32Shift;
+    }
+}
+
+/*
+ * @param <tDspWindow *> $psWindow state
+ * @param <uint32_t> $ui32Len values per summary, at least 1
+ * @return void
+ */
+void DSP_WindowInit(tDspWindow *psWindow, uint32_t ui32Len)
+{
+    psWindow->ui32Len = ui32Len ? ui32Len : 1;
+    psWindow->sCurrent.ui32Count = 0;
+    psWindow->i64Sum = 0;
+}
+
+/*
+ * Add a value, a full window is summarized and starts over
+ * @param <tDspWindow *> $psWindow state
+ * @param <int32_t> $i32Value value
+ * @param <tDspSummary *> $psSummary filled in when the window is full
+ * @return <bool> true if psSummary was filled in
+ */
+bool DSP_WindowAdd(tDspWindow *psWindow, int32_t i32Value, tDspSummary *psSummary)
+{
+    tDspSummary *psCurrent = &psWindow->sCurrent;
+    int64_t i64Half = psWindow->ui32Len / 2;
+
+    if (!psCurrent->ui32Count || i32Value < psCurrent->i32Min)
+        psCurrent->i32Min = i32Value;
+    if (!psCurrent->ui32Count || i32Value > psCurrent->i32Max)
+        psCurrent->i32Max = i32Value;
+    psWindow->i64Sum += i32Value;
+    if (++psCurrent->ui32Count < psWindow->ui32Len)
+        return false;
+
+    // mean rounded half away from zero
+    psCurrent->i32Mean = (int32_t)((psWindow->i64Sum + (psWindow->i64Sum < 0 ? -i64Half : i64Half)) /
+                                   (int64_t)psWindow->ui32Len);
+    *psSummary = *psCurrent;
+    psCurrent->ui32Count = 0;
+    psWindow->i64Sum = 0;
+    return true;
+}
+
+/*
+ * Cycles of each kernel over DSP_BENCH_BLOCK synthetic samples: CIC by 16,
+ * FIR with DSP_FIR_MAX_TAPS taps and no decimation (the worst case), MA over
+ * 16, EMA, window. Starts the DWT cycle counter if it is not running.
+ * @param <tDspBench *> $psBench filled in
+ * @return void
+ */
+void DSP_Benchmark(tDspBench *psBench)
+{
+    static uint16_t pui16Raw[DSP_BENCH_BLOCK];
+    static int32_t pi32In[DSP_BENCH_BLOCK], pi32Out[DSP_BENCH_BLOCK];
+    static int16_t pi16Coef[DSP_FIR_MAX_TAPS];
+    static tDspCic sCic;
+    static tDspFir sFir;
+    static tDspMa sMa;
+    static tDspEma sEma;
+    static tDspWindow sWindow;
+    tDspSummary sSummary;
+    uint32_t ui32Seed = 12345, ui32Start, i;
+
+    HWREG(DSP_DEMCR) |= DSP_DEMCR_TRCENA;
+    HWREG(DSP_DWT_CTRL) |= DSP_DWT_CYCCNTENA;
+
+    for (i = 0; i < DSP_BENCH_BLOCK; i++)
+    {
+        ui32Seed = ui32Seed * 1103515245 + 12345;
+        pui16Raw[i] = (ui32Seed >> 16) & 0xFFF;
+        pi32In[i] = pui16Raw[i] << DSP_FRAC;
+    }
+    for (i = 0; i < DSP_FIR_MAX_TAPS; i++)
+        pi16Coef[i] = 32768 / DSP_FIR_MAX_TAPS;
+    psBench->ui32Samples = DSP_BENCH_BLOCK;
+
+    DSP_CicInit(&sCic, 16);
+    ui32Start = HWREG(DSP_DWT_CYCCNT);
+    DSP_Cic(&sCic, pui16Raw, DSP_BENCH_BLOCK, pi32Out);
+    psBench->ui32Cic = HWREG(DSP_DWT_CYCCNT) - ui32Start;
+
+    DSP_FirInit(&sFir, pi16Coef, DSP_FIR_MAX_TAPS, 1);
+    ui32Start = HWREG(DSP_DWT_CYCCNT);
+    DSP_Fir(&sFir, pi32In, DSP_BENCH_BLOCK, pi32Out);
+    psBench->ui32Fir = HWREG(DSP_DWT_CYCCNT) - ui32Start;
+
+    DSP_MaInit(&sMa, 16);
+    ui32Start = HWREG(DSP_DWT_CYCCNT);
+    DSP_Ma(&sMa, pi32In, DSP_BENCH_BLOCK, pi32Out);
+    psBench->ui32Ma = HWREG(DSP_DWT_CYCCNT) - ui32Start;
+
+    DSP_EmaInit(&sEma, 4);
+    ui32Start = HWREG(DSP_DWT_CYCCNT);
+    DSP_Ema(&sEma, pi32In, DSP_BENCH_BLOCK, pi32Out);
+    psBench->ui32Ema = HWREG(DSP_DWT_CYCCNT) - ui32Start;
+
+    DSP_WindowInit(&sWindow, DSP_BENCH_BLOCK);
+    ui32Start = HWREG(DSP_DWT_CYCCNT);
+    for (i = 0; i < DSP_BENCH_BLOCK; i++)
+        DSP_WindowAdd(&sWindow, pi32In[i], &sSummary);
+    psBench->ui32Window = HWREG(DSP_DWT_CYCCNT) - ui32Start;
+}
+
+/*
+ * @return <uint32_t> DWT cycle counter, running after DSP_Benchmark()
+ */
+uint32_t DSP_Cycles(void)
+{
+    return HWREG(DSP_DWT_CYCCNT);
+}
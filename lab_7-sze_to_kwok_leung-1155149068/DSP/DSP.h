@@ -0,0 +1,117 @@
+/*
+ * DSP.h
+ *
+ *  Created on: Oct 19, 2026
+ *
+ *  Fixed point stream kernels for ADC sample blocks.
+ *  Every kernel keeps its state in a caller owned struct and takes a block at
+ *  a time, so a stream can be cut into blocks anywhere. Values past the CIC
+ *  are int32 in ADC codes with DSP_FRAC fraction bits: decimating averages
+ *  out noise, and the extra bits keep the resolution it gains.
+ *
+ *  CIC:    DSP_CIC_ORDER integrator / comb decimator by a power of 2, unity
+ *          gain, no multiplies. Integrators wrap modulo 2^32 on purpose.
+ *  FIR:    decimating FIR with Q15 coefficients, an output is only computed
+ *          every decimation inputs.
+ *  MA:     moving average over a power of 2 window, running sum.
+ *  EMA:    exponential average y += (x - y) / 2^shift, the state keeps the
+ *          shifted out bits so it does not lose precision.
+ *  Window: min / max / mean over a number of values.
+ *
+ *  DSP_Benchmark() times each kernel over one block with the DWT cycle
+ *  counter and leaves it running for DSP_Cycles(). Project/HostTools/DspCheck
+ *  checks the kernels against floating point references on the host.
+ */
+
+#ifndef DSP_DSP_H_
+#define DSP_DSP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DSP_FRAC            4
+#define DSP_ONE             (1 << DSP_FRAC)
+#define DSP_CIC_ORDER       3
+#define DSP_CIC_MAX_RATE    64          // 12 bit input * 64^3 stays within 31 bits
+#define DSP_FIR_MAX_TAPS    32
+#define DSP_MA_MAX          64
+#define DSP_BENCH_BLOCK     256
+
+typedef struct
+{
+    uint32_t pui32Integ[DSP_CIC_ORDER];
+    uint32_t pui32Comb[DSP_CIC_ORDER];     // previous integrator output per comb stage
+    uint32_t ui32Rate;
+    uint32_t ui32Shift;                     // log2(rate ^ order)
+    uint32_t ui32Phase;
+} tDspCic;
+
+typedef struct
+{
+    const int16_t *pi16Coef;                // Q15, sum 32768 for unity gain
+    uint32_t ui32Taps;
+    uint32_t ui32Decimation;
+    uint32_t ui32Phase;
+    uint32_t ui32Pos;
+    int32_t pi32History[2 * DSP_FIR_MAX_TAPS];  // twice, so the taps are contiguous
+} tDspFir;
+
+typedef struct
+{
+    int32_t pi32Window[DSP_MA_MAX];
+    uint32_t ui32Len;
+    uint32_t ui32Shift;
+    uint32_t ui32Pos;
+    int32_t i32Sum;
+    bool bPrimed;
+} tDspMa;
+
+typedef struct
+{
+    int32_t i32Acc;                         // y << shift
+    uint32_t ui32Shift;
+    bool bPrimed;
+} tDspEma;
+
+typedef struct
+{
+    int32_t i32Min;
+    int32_t i32Max;
+    int32_t i32Mean;
+    uint32_t ui32Count;
+} tDspSummary;
+
+typedef struct
+{
+    tDspSummary sCurrent;
+    int64_t i64Sum;
+    uint32_t ui32Len;
+} tDspWindow;
+
+typedef struct
+{
+    uint32_t ui32Samples;                   // input samples per run
+    uint32_t ui32Cic;                       // cycles per block and kernel
+    uint32_t ui32Fir;
+    uint32_t ui32Ma;
+    uint32_t ui32Ema;
+    uint32_t ui32Window;
+} tDspBench;
+
+/*
+ * Function declaration(s)
+ */
+extern bool DSP_CicInit(tDspCic *psCic, uint32_t ui32Rate);
+extern uint32_t DSP_Cic(tDspCic *psCic, const uint16_t *pui16In, uint32_t ui32Count, int32_t *pi32Out);
+extern bool DSP_FirInit(tDspFir *psFir, const int16_t *pi16Coef, uint32_t ui32Taps, uint32_t ui32Decimation);
+extern uint32_t DSP_Fir(tDspFir *psFir, const int32_t *pi32In, uint32_t ui32Count, int32_t *pi32Out);
+extern bool DSP_MaInit(tDspMa *psMa, uint32_t ui32Len);
+extern void DSP_Ma(tDspMa *psMa, const int32_t *pi32In, uint32_t ui32Count, int32_t *pi32Out);
+extern void DSP_EmaInit(tDspEma *psEma, uint32_t ui32Shift);
+extern void DSP_Ema(tDspEma *psEma, const int32_t *pi32In, uint32_t ui32Count, int32_t *pi32Out);
+extern void DSP_WindowInit(tDspWindow *psWindow, uint32_t ui32Len);
+extern bool DSP_WindowAdd(tDspWindow *psWindow, int32_t i32Value, tDspSummary *psSummary);
+extern void DSP_Benchmark(tDspBench *psBench);
+extern uint32_t DSP_Cycles(void);
+
+#endif /* DSP_DSP_H_ */
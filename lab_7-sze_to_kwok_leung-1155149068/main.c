@@ -11,11 +11,38 @@
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 #include "inc/hw_ints.h"
-
-uint32_t ui32ADC0Value[10];
-volatile uint32_t ui32TempAvg;
-volatile uint32_t ui32TempValueC;
-volatile uint32_t ui32TempValueF;
+#include "FORMAT/FORMAT.h"
+#include "ACQ/ACQ.h"
+#include "DSP/DSP.h"
+
+// temperature sensor sampling, 16000 * 4 conversions per second
+#define SAMPLE_HZ 16000
+#define OVERSAMPLE 4
+
+// 16 kHz -CIC-> 1 kHz -FIR-> 100 Hz, one line per second
+#define CIC_RATE 16
+#define FIR_DECIMATION 10
+#define EMA_SHIFT 3
+#define REPORT_LEN 100
+
+const uint32_t channels[] = { ADC_CTL_TS };
+
+// 31 tap lowpass at 40 Hz for 1 kHz (Hamming window), Q15
+const int16_t firCoef[] = {
+    -36, -27, -13, 20, 88, 207, 387, 632, 937, 1288, 1662, 2031, 2362, 2625, 2794, 2854,
+    2794, 2625, 2362, 2031, 1662, 1288, 937, 632, 387, 207, 88, 20, -13, -27, -36,
+};
+
+tDspCic cic;
+tDspFir fir;
+tDspEma ema;
+tDspWindow window;
+
+// handed from the ADC interrupt to the main loop once per REPORT_LEN values
+volatile bool reportReady;
+tDspSummary report;
+int32_t reportEma;
+volatile uint32_t blockCycles, maxBlockCycles;
 
 void UARTStringPut(char *str)
 {
@@ -26,14 +53,75 @@ void UARTStringPut(char *str)
     }
 }
 
+// ADC code with DSP_FRAC fraction bits to 0.01 degree C:
+// TEMP = 147.5 - (75 * 3.3 * code) / 4096, scaled before dividing so no digit is lost
+int32_t TempCenti(int32_t code)
+{
+    return 14750 - (int32_t)(((uint32_t)code * 24750 + (4096 * DSP_ONE / 2)) / (4096 * DSP_ONE));
+}
+
+// 0.01 degree C to 0.01 degree F, rounded
+int32_t CentiToF(int32_t centi)
+{
+    return (centi * 9 + (centi < 0 ? -2 : 2)) / 5 + 3200;
+}
+
+// Prints 0.01 units as [-]x.yy
+void UARTCentiPut(int32_t centi)
+{
+    char temp[FORMAT_INT_MAX_LEN];
+    uint32_t magnitude = centi < 0 ? -centi : centi;
+
+    if (centi < 0)
+        UARTStringPut("-");
+    FORMAT_Uint(temp, magnitude / 100);
+    UARTStringPut(temp);
+    UARTStringPut(".");
+    FORMAT_UintFixed(temp, magnitude % 100, 2, '0');
+    UARTStringPut(temp);
+}
+
+void UARTUintPut(uint32_t value)
+{
+    char temp[FORMAT_INT_MAX_LEN];
+
+    FORMAT_Uint(temp, value);
+    UARTStringPut(temp);
+}
+
+// Runs in the ADC interrupt once per block of ACQ_BLOCK samples
+void TempBlock(const uint16_t *block, uint32_t count)
+{
+    static int32_t values[ACQ_BLOCK / CIC_RATE + 1];
+    uint32_t start = DSP_Cycles();
+    uint32_t n, i;
+
+    n = DSP_Cic(&cic, block, count, values);
+    n = DSP_Fir(&fir, values, n, values);
+    for (i = 0; i < n; i++)
+    {
+        int32_t smooth;
+
+        DSP_Ema(&ema, &values[i], 1, &smooth);
+        if (DSP_WindowAdd(&window, values[i], &report))
+        {
+            reportEma = smooth;
+            reportReady = true;
+        }
+    }
+
+    blockCycles = DSP_Cycles() - start;
+    if (blockCycles > maxBlockCycles)
+        maxBlockCycles = blockCycles;
+}
 
 int main(void)
 {
+    tDspBench bench;
 
     SysCtlClockSet(SYSCTL_SYSDIV_5|SYSCTL_USE_PLL|SYSCTL_OSC_MAIN|SYSCTL_XTAL_16MHZ);
 
     SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
 
     SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
@@ -52,57 +140,62 @@ int main(void)
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
     GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
 
-
-    ADCSequenceConfigure(ADC0_BASE, 1, ADC_TRIGGER_PROCESSOR, 0);
-    ADCSequenceStepConfigure(ADC0_BASE, 1, 0, ADC_CTL_TS);
-    ADCSequenceStepConfigure(ADC0_BASE, 1, 1, ADC_CTL_TS);
-    ADCSequenceStepConfigure(ADC0_BASE, 1, 2, ADC_CTL_TS);
-    ADCSequenceStepConfigure(ADC0_BASE,1,3,ADC_CTL_TS|ADC_CTL_IE|ADC_CTL_END);
-    ADCSequenceEnable(ADC0_BASE, 1);
+    // cycles per kernel and block, also starts the cycle counter
+    DSP_Benchmark(&bench);
+    UARTStringPut("DSP cycles per ");
+    UARTUintPut(bench.ui32Samples);
+    UARTStringPut(" samples: cic ");
+    UARTUintPut(bench.ui32Cic);
+    UARTStringPut(", fir ");
+    UARTUintPut(bench.ui32Fir);
+    UARTStringPut(", ma ");
+    UARTUintPut(bench.ui32Ma);
+    UARTStringPut(", ema ");
+    UARTUintPut(bench.ui32Ema);
+    UARTStringPut(", window ");
+    UARTUintPut(bench.ui32Window);
+    UARTStringPut("\n\r");
+
+    DSP_CicInit(&cic, CIC_RATE);
+    DSP_FirInit(&fir, firCoef, sizeof(firCoef) / sizeof(firCoef[0]), FIR_DECIMATION);
+    DSP_EmaInit(&ema, EMA_SHIFT);
+    DSP_WindowInit(&window, REPORT_LEN);
+
+    // the timer triggers the ADC and the DMA collects the samples, the CPU sees whole blocks
+    ACQ_Init(channels, sizeof(channels) / sizeof(channels[0]), SAMPLE_HZ, OVERSAMPLE, TempBlock);
+    ACQ_Start();
 
     while(1)
     {
-       ADCIntClear(ADC0_BASE, 1);
-       ADCProcessorTrigger(ADC0_BASE, 1);
-
-       while(!ADCIntStatus(ADC0_BASE, 1, false))
-       {
-       }
-
-       char temp[4];
-       int top = 0;
-
-       ADCSequenceDataGet(ADC0_BASE, 1, ui32ADC0Value);
-       ui32TempAvg = (ui32ADC0Value[0] + ui32ADC0Value[1] + ui32ADC0Value[2] + ui32ADC0Value[3] + 2)/4;
-       ui32TempValueC = (1475 - ((2475 * ui32TempAvg)) / 4096)/10;
-       ui32TempValueF = ((ui32TempValueC * 9) + 160) / 5;
+       // sleep until a window is summarized, an interrupt in between still wakes the WFI
+       IntMasterDisable();
+       if(!reportReady)
+           SysCtlSleep();
+       IntMasterEnable();
+       if(!reportReady)
+           continue;
+       reportReady = false;
 
        UARTStringPut("Current Temperature: ");
 
        // Display in degree C
-       while (ui32TempValueC > 0)
-       {
-           temp[top++] = (ui32TempValueC % 10) + '0';
-           ui32TempValueC /= 10;
-       }
-       while (--top >= 0)
-       {
-           UARTCharPut(UART0_BASE, temp[top]);
-       }
+       UARTCentiPut(TempCenti(report.i32Mean));
        UARTStringPut("C; ");
 
        // Display in degree F
-       top = 0;
-       while (ui32TempValueF > 0)
-       {
-           temp[top++] = (ui32TempValueF % 10) + '0';
-           ui32TempValueF /= 10;
-       }
-       while (--top >= 0)
-       {
-           UARTCharPut(UART0_BASE, temp[top]);
-       }
+       UARTCentiPut(CentiToF(TempCenti(report.i32Mean)));
        UARTStringPut("F; ");
+
+       // the code falls as the temperature rises, min code is max temperature
+       UARTStringPut("min ");
+       UARTCentiPut(TempCenti(report.i32Max));
+       UARTStringPut("C; max ");
+       UARTCentiPut(TempCenti(report.i32Min));
+       UARTStringPut("C; ema ");
+       UARTCentiPut(TempCenti(reportEma));
+       UARTStringPut("C; ");
+       UARTUintPut(maxBlockCycles);
+       UARTStringPut(" cycles/block");
        UARTStringPut("\n\r");
     }
 }